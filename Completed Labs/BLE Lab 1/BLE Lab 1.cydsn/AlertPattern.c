@@ -0,0 +1,242 @@
+/*******************************************************************************
+* File Name: AlertPattern.c
+*
+* Version: 1.0
+*
+* Description:
+*  This is the alert pattern engine of the PSoC 4 BLE Lab 1 - Setting up a 
+*  Connection. Each alert level has a table of PWM compare values that the 
+*  watchdog interrupt steps through, so that the LED blinks or breathes 
+*  without the main loop. The CPU only wakes for a table lookup and a compare 
+*  write per tick, and the alert expires after ALERT_PATTERN_TIMEOUT_MS.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE Pioneer Kit
+*
+********************************************************************************
+* Copyright 2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <AlertPattern.h>
+
+/***************************************
+*        Constants
+***************************************/
+#define WDT_TICKS_PER_MS            (32u)
+#define WDT_INTERRUPT_NUM           (8u)
+
+#define ALERT_PATTERN_TIMEOUT_TICKS (ALERT_PATTERN_TIMEOUT_MS / ALERT_PATTERN_TICK_MS)
+
+/* Mild Alert: 250 ms at half brightness every second */
+static const ALERT_PATTERN_STEP_T mildAlertPattern[] =
+{
+    {MILD_ALERT_COMPARE, 5u},
+    {NO_ALERT_COMPARE,  15u}
+};
+
+/* High Alert: breathes at full brightness with a 1.6 s period. The compare
+ * values rise quadratically so that the brightness looks even */
+static const ALERT_PATTERN_STEP_T highAlertPattern[] =
+{
+    {  0u, 1u}, {  2u, 1u}, {  8u, 1u}, { 18u, 1u},
+    { 31u, 1u}, { 49u, 1u}, { 70u, 1u}, { 96u, 1u},
+    {125u, 1u}, {158u, 1u}, {195u, 1u}, {236u, 1u},
+    {281u, 1u}, {330u, 1u}, {383u, 1u}, {439u, 1u},
+    {500u, 1u}, {439u, 1u}, {383u, 1u}, {330u, 1u},
+    {281u, 1u}, {236u, 1u}, {195u, 1u}, {158u, 1u},
+    {125u, 1u}, { 96u, 1u}, { 70u, 1u}, { 49u, 1u},
+    { 31u, 1u}, { 18u, 1u}, {  8u, 1u}, {  2u, 1u}
+};
+
+/***************************************
+*        Global Variables
+***************************************/
+/* Pattern being played, or NULL while there is no alert */
+static const ALERT_PATTERN_STEP_T * volatile activePattern = NULL;
+static volatile uint8 patternLength;
+static volatile uint8 patternIndex;
+static volatile uint8 stepTicks;
+static volatile uint16 timeoutTicks;
+static volatile uint8 patternExpired = 0u;
+
+
+/*******************************************************************************
+* Function Name: AlertPattern_Isr
+********************************************************************************
+*
+* Summary:
+*  Watchdog interrupt of the pattern engine. Moves to the next step of the 
+*  active pattern when the present one has been held long enough, and ends 
+*  the pattern when the alert times out.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+CY_ISR(AlertPattern_Isr)
+{
+    CySysWdtClearInterrupt(CY_SYS_WDT_COUNTER0_INT);
+    
+    if(activePattern == NULL)
+    {
+        return;
+    }
+    
+    if(--timeoutTicks == 0u)
+    {
+        /* Turn the LED off; the main loop stops the watchdog and the PWM */
+        PWM_WriteCompare(NO_ALERT_COMPARE);
+        activePattern = NULL;
+        patternExpired = 1u;
+        return;
+    }
+    
+    if(--stepTicks == 0u)
+    {
+        if(++patternIndex >= patternLength)
+        {
+            patternIndex = 0u;
+        }
+        
+        PWM_WriteCompare(activePattern[patternIndex].compare);
+        stepTicks = activePattern[patternIndex].ticks;
+    }
+}
+
+/*******************************************************************************
+* Function Name: AlertPattern_Start
+********************************************************************************
+*
+* Summary:
+*  Sets up the watchdog counter 0 to interrupt every ALERT_PATTERN_TICK_MS. 
+*  The counter is enabled only while a pattern is played.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void AlertPattern_Start(void)
+{
+    CyIntSetVector(WDT_INTERRUPT_NUM, &AlertPattern_Isr);
+    
+    /* Unlock the watchdog to change its settings */
+    CySysWdtUnlock();
+    
+    /* Interrupt on match, and restart counting from zero */
+    CySysWdtWriteMode(0u, CY_SYS_WDT_MODE_INT);
+    CySysWdtWriteClearOnMatch(0u, 1u);
+    
+    /* The count starts from zero, so the match value is the intended - 1 */
+    CySysWdtWriteMatch(0u, (ALERT_PATTERN_TICK_MS * WDT_TICKS_PER_MS) - 1u);
+    
+    CySysWdtLock();
+    
+    CyIntEnable(WDT_INTERRUPT_NUM);
+}
+
+/*******************************************************************************
+* Function Name: AlertPattern_Play
+********************************************************************************
+*
+* Summary:
+*  Starts the pattern of an alert level from its first step, or stops the 
+*  pattern for NO_ALERT. The PWM must be running for a Mild or High Alert.
+*
+* Parameters:  
+*  uint8 alertLevel:  Alert level written by the Find Me locator
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void AlertPattern_Play(uint8 alertLevel)
+{
+    const ALERT_PATTERN_STEP_T *pattern = NULL;
+    uint8 length = 0u;
+    uint8 interruptStatus;
+    
+    switch(alertLevel)
+    {
+        case MILD_ALERT:
+            pattern = mildAlertPattern;
+            length = (uint8)(sizeof(mildAlertPattern) / sizeof(mildAlertPattern[0]));
+            break;
+            
+        case HIGH_ALERT:
+            pattern = highAlertPattern;
+            length = (uint8)(sizeof(highAlertPattern) / sizeof(highAlertPattern[0]));
+            break;
+            
+        default:
+            break;
+    }
+    
+    /* Change the pattern atomically with respect to the watchdog interrupt */
+    interruptStatus = CyEnterCriticalSection();
+    
+    activePattern = pattern;
+    patternExpired = 0u;
+    
+    if(pattern != NULL)
+    {
+        patternLength = length;
+        patternIndex = 0u;
+        stepTicks = pattern[0].ticks;
+        timeoutTicks = ALERT_PATTERN_TIMEOUT_TICKS;
+        PWM_WriteCompare(pattern[0].compare);
+    }
+    else
+    {
+        PWM_WriteCompare(NO_ALERT_COMPARE);
+    }
+    
+    CyExitCriticalSection(interruptStatus);
+    
+    /* The watchdog wakes the device only while a pattern is played */
+    CySysWdtUnlock();
+    
+    if(pattern != NULL)
+    {
+        CySysWdtEnable(CY_SYS_WDT_COUNTER0_MASK);
+    }
+    else
+    {
+        CySysWdtDisable(CY_SYS_WDT_COUNTER0_MASK);
+    }
+    
+    CySysWdtLock();
+}
+
+/*******************************************************************************
+* Function Name: AlertPattern_IsExpired
+********************************************************************************
+*
+* Summary:
+*  Reports, once, that the alert timed out since the last AlertPattern_Play().
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  uint8: 1 if the alert expired, 0 otherwise
+*
+*******************************************************************************/
+uint8 AlertPattern_IsExpired(void)
+{
+    uint8 expired = patternExpired;
+    
+    patternExpired = 0u;
+    
+    return expired;
+}
+
+
+/* [] END OF FILE */
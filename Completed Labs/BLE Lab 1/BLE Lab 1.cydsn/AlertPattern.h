@@ -0,0 +1,62 @@
+/*******************************************************************************
+* File Name: AlertPattern.h
+*
+* Version: 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the alert pattern engine
+*  of the PSoC 4 BLE Lab 1 - Setting up a Connection.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE Pioneer Kit
+*
+********************************************************************************
+* Copyright 2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(ALERT_PATTERN_H)
+#define ALERT_PATTERN_H
+
+#include <project.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define NO_ALERT           (0u)
+#define MILD_ALERT         (1u)
+#define HIGH_ALERT         (2u)
+
+/* PWM compare values, out of the PWM period of 500 */
+#define NO_ALERT_COMPARE   (0u)
+#define MILD_ALERT_COMPARE (250u)
+#define HIGH_ALERT_COMPARE (500u)
+
+/* Period of the watchdog interrupt that steps the patterns */
+#define ALERT_PATTERN_TICK_MS       (50u)
+
+/* An alert returns to NO_ALERT on its own after this time */
+#define ALERT_PATTERN_TIMEOUT_MS    (30000u)
+
+/***************************************
+*        Data Types
+***************************************/
+/* One step of a pattern: the PWM compare value and how long it is held */
+typedef struct
+{
+    uint16 compare;
+    uint8  ticks;
+} ALERT_PATTERN_STEP_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+CY_ISR_PROTO(AlertPattern_Isr);
+void AlertPattern_Start(void);
+void AlertPattern_Play(uint8 alertLevel);
+uint8 AlertPattern_IsExpired(void);
+
+#endif /* ALERT_PATTERN_H */
+
+/* [] END OF FILE */
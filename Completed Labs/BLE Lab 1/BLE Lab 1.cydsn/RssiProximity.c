@@ -0,0 +1,250 @@
+/*******************************************************************************
+* File Name: RssiProximity.c
+*
+* Version: 1.0
+*
+* Description:
+*  This is the RSSI distance estimation of the PSoC 4 BLE Lab 1 - Setting up 
+*  a Connection. The RSSI of the connection is smoothed by an exponential 
+*  moving average with an outlier clamp, and mapped to a distance class with
+*  hysteresis. Sampling slows down while the RSSI is steady, so a tag that 
+*  is not moving reads it only every RSSI_MAX_INTERVAL connection events.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE Pioneer Kit
+*
+********************************************************************************
+* Copyright 2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <RssiProximity.h>
+
+/***************************************
+*        Constants
+***************************************/
+/* CyBle_GetRssi() returns this when no packet has been received */
+#define RSSI_INVALID                (127)
+
+/***************************************
+*        Global Variables
+***************************************/
+/* Filtered RSSI in 1/2^RSSI_EMA_SHIFT dBm */
+static int16 filteredRssi;
+static uint8 filterValid = 0u;
+
+static uint8 distanceClass = DISTANCE_UNKNOWN;
+
+/* Adaptive sampling state, in main loop passes */
+static uint8 sampleInterval = RSSI_MIN_INTERVAL;
+static uint8 passesToSample = RSSI_MIN_INTERVAL;
+static uint8 stableSamples = 0u;
+
+/* Direction of the last sample beyond RSSI_STABLE_DB, or 0 */
+static int8 lastDrift = 0;
+
+
+/*******************************************************************************
+* Function Name: RssiProximity_Reset
+********************************************************************************
+*
+* Summary:
+*  Forgets the RSSI estimate. Called on every new connection.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void RssiProximity_Reset(void)
+{
+    filterValid = 0u;
+    distanceClass = DISTANCE_UNKNOWN;
+    sampleInterval = RSSI_MIN_INTERVAL;
+    passesToSample = RSSI_MIN_INTERVAL;
+    stableSamples = 0u;
+    lastDrift = 0;
+}
+
+/*******************************************************************************
+* Function Name: RssiProximity_Process
+********************************************************************************
+*
+* Summary:
+*  Called once per main loop pass while connected. Reads the RSSI of the last
+*  received packet when the sampling interval has passed, filters it and 
+*  updates the distance class.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  uint8: 1 if the distance class changed, 0 otherwise
+*
+*******************************************************************************/
+uint8 RssiProximity_Process(void)
+{
+    int16 sample;
+    int16 estimate;
+    int16 deviation;
+    uint8 newClass;
+    
+    if(--passesToSample != 0u)
+    {
+        return 0u;
+    }
+    
+    passesToSample = sampleInterval;
+    
+    sample = CyBle_GetRssi();
+    
+    if(sample == RSSI_INVALID)
+    {
+        return 0u;
+    }
+    
+    if(filterValid == 0u)
+    {
+        filteredRssi = (int16)(sample * (1 << RSSI_EMA_SHIFT));
+        filterValid = 1u;
+    }
+    else
+    {
+        estimate = filteredRssi / (1 << RSSI_EMA_SHIFT);
+        deviation = sample - estimate;
+        
+        /* Clamp outliers, such as a faded packet, around the estimate */
+        if(deviation > RSSI_OUTLIER_CLAMP_DB)
+        {
+            deviation = RSSI_OUTLIER_CLAMP_DB;
+        }
+        else if(deviation < -RSSI_OUTLIER_CLAMP_DB)
+        {
+            deviation = -RSSI_OUTLIER_CLAMP_DB;
+        }
+        
+        /* filtered += (sample - filtered) / 2^RSSI_EMA_SHIFT, with the 
+         * fraction kept in filteredRssi */
+        filteredRssi += (int16)((estimate + deviation) - (filteredRssi / (1 << RSSI_EMA_SHIFT)));
+        
+        /* Sample less often while the RSSI is steady. Two samples in a row
+         * beyond RSSI_STABLE_DB on the same side mean the locator moves; 
+         * a single one is taken as a fade */
+        if((deviation <= RSSI_STABLE_DB) && (deviation >= -RSSI_STABLE_DB))
+        {
+            lastDrift = 0;
+            
+            if(++stableSamples >= RSSI_STABLE_SAMPLES)
+            {
+                stableSamples = 0u;
+                
+                if(sampleInterval < RSSI_MAX_INTERVAL)
+                {
+                    sampleInterval <<= 1u;
+                }
+            }
+        }
+        else
+        {
+            stableSamples = 0u;
+            
+            if(((deviation > 0) && (lastDrift > 0)) || ((deviation < 0) && (lastDrift < 0)))
+            {
+                sampleInterval = RSSI_MIN_INTERVAL;
+                passesToSample = RSSI_MIN_INTERVAL;
+            }
+            
+            lastDrift = (deviation > 0) ? 1 : -1;
+        }
+    }
+    
+    estimate = filteredRssi / (1 << RSSI_EMA_SHIFT);
+    
+    if(estimate >= RSSI_IMMEDIATE_DBM)
+    {
+        newClass = DISTANCE_IMMEDIATE;
+    }
+    else if(estimate >= RSSI_NEAR_DBM)
+    {
+        newClass = DISTANCE_NEAR;
+    }
+    else
+    {
+        newClass = DISTANCE_FAR;
+    }
+    
+    /* Move to a nearer class only RSSI_HYSTERESIS_DB past its threshold, 
+     * so that an estimate on a threshold does not toggle the class */
+    if((distanceClass != DISTANCE_UNKNOWN) && (newClass < distanceClass))
+    {
+        if(estimate >= (RSSI_IMMEDIATE_DBM + RSSI_HYSTERESIS_DB))
+        {
+            newClass = DISTANCE_IMMEDIATE;
+        }
+        else if(estimate >= (RSSI_NEAR_DBM + RSSI_HYSTERESIS_DB))
+        {
+            newClass = DISTANCE_NEAR;
+        }
+        else
+        {
+            newClass = distanceClass;
+        }
+    }
+    
+    if(newClass != distanceClass)
+    {
+        distanceClass = newClass;
+        return 1u;
+    }
+    
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: RssiProximity_GetDistanceClass
+********************************************************************************
+*
+* Summary:
+*  Returns the present distance class.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  uint8: DISTANCE_IMMEDIATE, DISTANCE_NEAR, DISTANCE_FAR or DISTANCE_UNKNOWN
+*
+*******************************************************************************/
+uint8 RssiProximity_GetDistanceClass(void)
+{
+    return distanceClass;
+}
+
+/*******************************************************************************
+* Function Name: RssiProximity_GetRssi
+********************************************************************************
+*
+* Summary:
+*  Returns the filtered RSSI.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  int8: Filtered RSSI in dBm, or 127 before the first sample
+*
+*******************************************************************************/
+int8 RssiProximity_GetRssi(void)
+{
+    if(filterValid == 0u)
+    {
+        return RSSI_INVALID;
+    }
+    
+    return (int8)(filteredRssi / (1 << RSSI_EMA_SHIFT));
+}
+
+
+/* [] END OF FILE */
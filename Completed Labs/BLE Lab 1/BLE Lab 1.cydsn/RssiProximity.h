@@ -0,0 +1,65 @@
+/*******************************************************************************
+* File Name: RssiProximity.h
+*
+* Version: 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the RSSI distance 
+*  estimation of the PSoC 4 BLE Lab 1 - Setting up a Connection.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE Pioneer Kit
+*
+********************************************************************************
+* Copyright 2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(RSSI_PROXIMITY_H)
+#define RSSI_PROXIMITY_H
+
+#include <project.h>
+
+/***************************************
+*        API Constants
+***************************************/
+/* Distance classes, as exposed by the distance class characteristic */
+#define DISTANCE_IMMEDIATE          (0u)
+#define DISTANCE_NEAR               (1u)
+#define DISTANCE_FAR                (2u)
+#define DISTANCE_UNKNOWN            (0xFFu)
+
+/* Filtered RSSI above which the locator is Immediate or Near, in dBm. A 
+ * nearer class is entered only RSSI_HYSTERESIS_DB above its threshold */
+#define RSSI_IMMEDIATE_DBM          (-55)
+#define RSSI_NEAR_DBM               (-75)
+#define RSSI_HYSTERESIS_DB          (4)
+
+/* Samples are clamped to this distance from the filtered RSSI, so a single 
+ * faded packet moves the estimate by at most RSSI_OUTLIER_CLAMP_DB / 8 */
+#define RSSI_OUTLIER_CLAMP_DB       (8)
+
+/* Filter weight of a new sample is 1 / 2^RSSI_EMA_SHIFT */
+#define RSSI_EMA_SHIFT              (3u)
+
+/* Sampling interval in main loop passes, which is one per connection event
+ * while connected. The interval doubles after RSSI_STABLE_SAMPLES samples 
+ * within RSSI_STABLE_DB of the estimate, and drops back to the minimum 
+ * after two samples beyond it on the same side */
+#define RSSI_MIN_INTERVAL           (1u)
+#define RSSI_MAX_INTERVAL           (64u)
+#define RSSI_STABLE_DB              (4)
+#define RSSI_STABLE_SAMPLES         (4u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void RssiProximity_Reset(void);
+uint8 RssiProximity_Process(void);
+uint8 RssiProximity_GetDistanceClass(void);
+int8 RssiProximity_GetRssi(void);
+
+#endif /* RSSI_PROXIMITY_H */
+
+/* [] END OF FILE */
@@ -1,182 +1,403 @@
-/*******************************************************************************
-* File Name: main.c
-*
-* Version: 1.0
-*
-* Description:
-*  This is the source code for the PSoC 4 BLE Lab 1 - Setting up a Connection.
-*
-* Hardware Dependency:
-*  CY8CKIT-042 BLE Pioneer Kit
-*
-********************************************************************************
-* Copyright 2014, Cypress Semiconductor Corporation.  All rights reserved.
-* You may use this file only in accordance with the license, terms, conditions,
-* disclaimers, and limitations in the end user license agreement accompanying
-* the software package with which this file was provided.
-*******************************************************************************/
-#include <project.h>
-
-/***************************************
-*        API Constants
-***************************************/
-#define NO_ALERT           (0u)
-#define MILD_ALERT         (1u)
-#define HIGH_ALERT         (2u)
-
-#define NO_ALERT_COMPARE   (0u)
-#define MILD_ALERT_COMPARE (250u)
-#define HIGH_ALERT_COMPARE (500u)
-
-/***************************************
-*        Function Prototypes
-***************************************/
-void StackEventHandler(uint32 event, void* eventParam);
-void IasEventHandler(uint32 event, void* eventParam);
-void HandleAlertLEDs(uint8 status);
-
-
-/*******************************************************************************
-* Function Name: main
-********************************************************************************
-*
-* Summary:
-*  Main function.
-*
-* Parameters:  
-*  None
-*
-* Return: 
-*  None
-*
-*******************************************************************************/
-int main()
-{
-    CyGlobalIntEnable; 
-
-    /* Start the BLE component and register StackEventHandler function */
-    CyBle_Start(StackEventHandler);
-    
-    /* Register IAS event handler function */
-    CyBle_IasRegisterAttrCallback(IasEventHandler);
-    
-    /* Start the PWM component */
-    PWM_Start();
-    
-    while(1)
-    {
-        /* Process all the pending BLE tasks. This single API call to 
-         * will service all the BLE stack events. This API MUST be called at least once
-         * in a BLE connection interval */
-        CyBle_ProcessEvents();
-    }
-}
-
-/*******************************************************************************
-* Function Name: StackEventHandler
-********************************************************************************
-*
-* Summary:
-*  This is an event callback function to receive events from the BLE Component.
-*
-* Parameters:  
-*  uint8 event:       Event from the CYBLE component
-*  void* eventParams: A structure instance for corresponding event type. The 
-*                     list of event structure is described in the component 
-*                     datasheet.
-*
-* Return: 
-*  None
-*
-*******************************************************************************/
-void StackEventHandler(uint32 event, void *eventParam)
-{
-    uint8 alertLevel;
-    
-    switch(event)
-    {
-        /* Mandatory events to be handled by Find Me Target design */
-        case CYBLE_EVT_STACK_ON:
-        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
-        case CYBLE_EVT_TIMEOUT:
-            /* Start the BLE fast advertisement. */
-            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
-            /* Reset the alert level to NOALERT */
-            alertLevel = NO_ALERT;
-            HandleAlertLEDs(alertLevel);
-            break;
-        
-        default:
-    	    break;
-    }
-}
-
-/*******************************************************************************
-* Function Name: IasEventHandler
-********************************************************************************
-*
-* Summary:
-*  This is an event callback function to receive events from the BLE Component,
-*  which are specific to Immediate Alert Service.
-*
-* Parameters:  
-*  uint8 event:       Write Command event from the CYBLE component.
-*  void* eventParams: A structure instance of CYBLE_GATT_HANDLE_VALUE_PAIR_T
-*                     type.
-*
-* Return: 
-*  None
-*
-*******************************************************************************/
-void IasEventHandler(uint32 event, void *eventParam)
-{
-    uint8 alertLevel;
-    
-    /* Alert Level Characteristic write event */
-    if(event == CYBLE_EVT_IASS_WRITE_CHAR_CMD)
-    {
-        /* Extract Alert Level value from the GATT DB using the 
-		 * CYBLE_IAS_ALERT_LEVEL as a parameter to CyBle_IassGetCharacteristicValue
-		 * routine. Store the Alert Level Characteristic value in "alertLevel"
-		 * variable */
-        CyBle_IassGetCharacteristicValue(CYBLE_IAS_ALERT_LEVEL, sizeof(alertLevel), &alertLevel);
-        /*Based on alert Level level recieved, Drive LED*/
-        HandleAlertLEDs(alertLevel);
-    }
-}
-
-/*******************************************************************************
-* Function Name: HandleAlertLEDs
-********************************************************************************
-*
-* Summary:
-*  This function drives the LED based on the alert level
-*
-* Parameters:  
-*  uint8 status:      Alert level 
-*
-* Return: 
-*  None
-*
-*******************************************************************************/
-void HandleAlertLEDs(uint8 status)
-{
-    /* Update Alert LED status based on IAS Alert level characteristic. */
-    switch(status)
-    {
-        case NO_ALERT:
-            PWM_WriteCompare(NO_ALERT_COMPARE);
-            break;
-
-        case MILD_ALERT:
-            PWM_WriteCompare(MILD_ALERT_COMPARE);
-            break;
-            
-        case HIGH_ALERT:
-            PWM_WriteCompare(HIGH_ALERT_COMPARE);
-            break;                
-    }
-}
-
-
-/* [] END OF FILE */
+/*******************************************************************************
+* File Name: main.c
+*
+* Version: 1.0
+*
+* Description:
+*  This is the source code for the PSoC 4 BLE Lab 1 - Setting up a Connection.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE Pioneer Kit
+*
+********************************************************************************
+* Copyright 2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include <AlertPattern.h>
+
+/***************************************
+*        Compile Time Options
+***************************************/
+/* Alert with the Link Loss Service Alert Level when the link is lost. The 
+ * Link Loss Service must be added in the BLE component customizer */
+#define LINK_LOSS_SERVICE  (0)
+
+/* Estimate the distance to the locator from the connection RSSI and expose 
+ * it as a Distance Class characteristic (1 byte, Read and Notify) of a 
+ * custom Proximity service, which must be added in the customizer */
+#define DISTANCE_CLASS     (0)
+
+#if DISTANCE_CLASS
+#include <RssiProximity.h>
+#endif
+
+/***************************************
+*        Global Variables
+***************************************/
+/* Alert level presently shown on the LED. The PWM runs only while this is
+ * not NO_ALERT, and the system enters Deep Sleep only when it is */
+static uint8 activeAlertLevel = NO_ALERT;
+
+#if LINK_LOSS_SERVICE
+/* Set while the Link Loss alert is shown, which ends on reconnection */
+static uint8 linkLossAlert = 0u;
+#endif
+
+#if DISTANCE_CLASS
+/* Set while the locator has enabled Distance Class notifications */
+static uint8 distanceNotifications = 0u;
+#endif
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void StackEventHandler(uint32 event, void* eventParam);
+void IasEventHandler(uint32 event, void* eventParam);
+void HandleAlertLEDs(uint8 status);
+void EnterLowPower(void);
+#if DISTANCE_CLASS
+void UpdateDistanceClass(void);
+#endif
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Main function.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+int main()
+{
+    CyGlobalIntEnable; 
+
+    /* Start the BLE component and register StackEventHandler function */
+    CyBle_Start(StackEventHandler);
+    
+    /* Register IAS event handler function */
+    CyBle_IasRegisterAttrCallback(IasEventHandler);
+    
+    /* Start the PWM component and stop it again with the LED off. It runs
+     * only while an alert is shown, see HandleAlertLEDs */
+    PWM_Start();
+    PWM_WriteCompare(NO_ALERT_COMPARE);
+    PWM_Sleep();
+    
+    /* Prepare the watchdog that steps the alert patterns */
+    AlertPattern_Start();
+    
+    while(1)
+    {
+        /* Process all the pending BLE tasks. This single API call to 
+         * will service all the BLE stack events. This API MUST be called at least once
+         * in a BLE connection interval */
+        CyBle_ProcessEvents();
+        
+        /* An alert that timed out returns to NO_ALERT, which also stops the 
+         * watchdog and the PWM */
+        if(AlertPattern_IsExpired())
+        {
+            HandleAlertLEDs(NO_ALERT);
+        }
+        
+        #if DISTANCE_CLASS
+        /* Sample the RSSI of the connection, at most once per connection 
+         * event and less often while it is steady */
+        if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
+        {
+            if(RssiProximity_Process())
+            {
+                UpdateDistanceClass();
+            }
+        }
+        #endif
+        
+        /* Sleep until the next BLE event or IAS write */
+        EnterLowPower();
+    }
+}
+
+/*******************************************************************************
+* Function Name: StackEventHandler
+********************************************************************************
+*
+* Summary:
+*  This is an event callback function to receive events from the BLE Component.
+*
+* Parameters:  
+*  uint8 event:       Event from the CYBLE component
+*  void* eventParams: A structure instance for corresponding event type. The 
+*                     list of event structure is described in the component 
+*                     datasheet.
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void StackEventHandler(uint32 event, void *eventParam)
+{
+    uint8 alertLevel;
+    
+    #if DISTANCE_CLASS
+    CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReqParam;
+    #endif
+    
+    switch(event)
+    {
+        /* Mandatory events to be handled by Find Me Target design */
+        case CYBLE_EVT_STACK_ON:
+        case CYBLE_EVT_TIMEOUT:
+            /* Start the BLE fast advertisement. */
+            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+            /* Reset the alert level to NOALERT */
+            alertLevel = NO_ALERT;
+            HandleAlertLEDs(alertLevel);
+            break;
+        
+        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
+            /* Start the BLE fast advertisement. */
+            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+            
+            #if LINK_LOSS_SERVICE
+            /* Alert with the level the locator set in the Link Loss Service;
+             * the alert expires with the alert pattern */
+            CyBle_LlssGetCharacteristicValue(CYBLE_LLS_ALERT_LEVEL, sizeof(alertLevel), &alertLevel);
+            linkLossAlert = (alertLevel != NO_ALERT) ? 1u : 0u;
+            #else
+            /* Reset the alert level to NOALERT */
+            alertLevel = NO_ALERT;
+            #endif
+            HandleAlertLEDs(alertLevel);
+            
+            #if DISTANCE_CLASS
+            distanceNotifications = 0u;
+            #endif
+            break;
+            
+        case CYBLE_EVT_GAP_DEVICE_CONNECTED:
+            #if LINK_LOSS_SERVICE
+            /* The link is back, so the Link Loss alert ends */
+            if(linkLossAlert != 0u)
+            {
+                linkLossAlert = 0u;
+                HandleAlertLEDs(NO_ALERT);
+            }
+            #endif
+            
+            #if DISTANCE_CLASS
+            RssiProximity_Reset();
+            #endif
+            break;
+            
+        #if DISTANCE_CLASS
+        case CYBLE_EVT_GATTS_WRITE_REQ:
+            wrReqParam = (CYBLE_GATTS_WRITE_REQ_PARAM_T *) eventParam;
+            
+            /* The locator enables or disables Distance Class notifications */
+            if(wrReqParam->handleValPair.attrHandle == 
+               CYBLE_PROXIMITY_SERVICE_DISTANCE_CLASS_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+            {
+                distanceNotifications = wrReqParam->handleValPair.value.val[0] & 0x01u;
+                
+                CyBle_GattsWriteAttributeValue(&wrReqParam->handleValPair, 0u, &cyBle_connHandle, 
+                                               CYBLE_GATT_DB_PEER_INITIATED);
+                
+                /* Send the present class right away */
+                if(distanceNotifications != 0u)
+                {
+                    UpdateDistanceClass();
+                }
+            }
+            
+            CyBle_GattsWriteRsp(cyBle_connHandle);
+            break;
+        #endif
+            
+        default:
+    	    break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: IasEventHandler
+********************************************************************************
+*
+* Summary:
+*  This is an event callback function to receive events from the BLE Component,
+*  which are specific to Immediate Alert Service.
+*
+* Parameters:  
+*  uint8 event:       Write Command event from the CYBLE component.
+*  void* eventParams: A structure instance of CYBLE_GATT_HANDLE_VALUE_PAIR_T
+*                     type.
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void IasEventHandler(uint32 event, void *eventParam)
+{
+    uint8 alertLevel;
+    
+    /* Alert Level Characteristic write event */
+    if(event == CYBLE_EVT_IASS_WRITE_CHAR_CMD)
+    {
+        /* Extract Alert Level value from the GATT DB using the 
+		 * CYBLE_IAS_ALERT_LEVEL as a parameter to CyBle_IassGetCharacteristicValue
+		 * routine. Store the Alert Level Characteristic value in "alertLevel"
+		 * variable */
+        CyBle_IassGetCharacteristicValue(CYBLE_IAS_ALERT_LEVEL, sizeof(alertLevel), &alertLevel);
+        /*Based on alert Level level recieved, Drive LED*/
+        HandleAlertLEDs(alertLevel);
+    }
+}
+
+/*******************************************************************************
+* Function Name: HandleAlertLEDs
+********************************************************************************
+*
+* Summary:
+*  This function drives the LED with the pattern of the alert level
+*
+* Parameters:  
+*  uint8 status:      Alert level 
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void HandleAlertLEDs(uint8 status)
+{
+    /* Ignore values outside the Alert Level range, as before */
+    if(status > HIGH_ALERT)
+    {
+        return;
+    }
+    
+    /* The PWM was stopped while there was no alert */
+    if((activeAlertLevel == NO_ALERT) && (status != NO_ALERT))
+    {
+        PWM_Wakeup();
+    }
+    
+    /* Play the pattern of the IAS Alert level characteristic; NO_ALERT 
+     * turns the LED off */
+    AlertPattern_Play(status);
+    
+    /* With the compare value at NO_ALERT_COMPARE the output no longer 
+     * toggles, so the PWM can be stopped until the next alert */
+    if((activeAlertLevel != NO_ALERT) && (status == NO_ALERT))
+    {
+        PWM_Sleep();
+    }
+    
+    activeAlertLevel = status;
+}
+
+/*******************************************************************************
+* Function Name: EnterLowPower
+********************************************************************************
+*
+* Summary:
+*  Puts the device into the lowest power mode the BLE block and the alert 
+*  allow. The BLE block is requested to enter Deep Sleep first, since it runs
+*  asynchronously to the application. The system enters Deep Sleep when the
+*  BLE block is in Deep Sleep and no alert is shown, because the PWM is 
+*  clocked from the HFCLK, which stops in Deep Sleep. Otherwise the CPU 
+*  sleeps and the PWM keeps driving the LED.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void EnterLowPower(void)
+{
+    CYBLE_LP_MODE_T bleMode;
+    uint8 interruptStatus;
+    
+    /* Request the BLE block to enter Deep Sleep */
+    bleMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
+    
+    /* Decide and sleep with interrupts disabled, so that an interrupt 
+     * between the check and the sleep cannot be missed */
+    interruptStatus = CyEnterCriticalSection();
+    
+    if(bleMode == CYBLE_BLESS_DEEPSLEEP)
+    {
+        /* The system can enter Deep Sleep only when the BLE block is 
+         * starting the ECO for the next connection event, or is idle */
+        if((CyBle_GetBleSsState() == CYBLE_BLESS_STATE_ECO_ON) ||
+           (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_DEEPSLEEP))
+        {
+            if(activeAlertLevel == NO_ALERT)
+            {
+                CySysPmDeepSleep();
+            }
+            else
+            {
+                CySysPmSleep();
+            }
+        }
+    }
+    else
+    {
+        /* The CPU must stay awake while the BLE block post-processes a 
+         * connection event; it then enters Deep Sleep on the next pass */
+        if(CyBle_GetBleSsState() != CYBLE_BLESS_STATE_EVENT_CLOSE)
+        {
+            CySysPmSleep();
+        }
+    }
+    
+    CyExitCriticalSection(interruptStatus);
+}
+
+#if DISTANCE_CLASS
+/*******************************************************************************
+* Function Name: UpdateDistanceClass
+********************************************************************************
+*
+* Summary:
+*  Writes the present distance class to the Distance Class characteristic and
+*  notifies it when the locator has enabled notifications.
+*
+* Parameters:  
+*  None
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void UpdateDistanceClass(void)
+{
+    uint8 distanceClass = RssiProximity_GetDistanceClass();
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T distanceHandle;
+    
+    distanceHandle.attrHandle = CYBLE_PROXIMITY_SERVICE_DISTANCE_CLASS_CHAR_HANDLE;
+    distanceHandle.value.val = &distanceClass;
+    distanceHandle.value.len = sizeof(distanceClass);
+    
+    CyBle_GattsWriteAttributeValue(&distanceHandle, 0u, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+    
+    if((distanceNotifications != 0u) && (distanceClass != DISTANCE_UNKNOWN))
+    {
+        CyBle_GattsNotification(cyBle_connHandle, &distanceHandle);
+    }
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -1,253 +1,539 @@
-/*****************************************************************************
-* File Name: BleProcessing.c
-*
-* Version: 1.0
-*
-* Description:
-* This file implements the BLE capability in the PSoC 4 BLE Lab 3.
-*
-* Hardware Dependency:
-* CY8CKIT-042 BLE Pioneer Kit
-*
-******************************************************************************
-* Copyright (2014), Cypress Semiconductor Corporation.
-******************************************************************************
-* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
-* protected by and subject to worldwide patent protection (United States and
-* foreign), United States copyright laws and international treaty provisions.
-* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
-* license to copy, use, modify, create derivative works of, and compile the
-* Cypress Source Code and derivative works for the sole purpose of creating
-* custom software in support of licensee product to be used only in conjunction
-* with a Cypress integrated circuit as specified in the applicable agreement.
-* Any reproduction, modification, translation, compilation, or representation of
-* this software except as specified above is prohibited without the express
-* written permission of Cypress.
-*
-* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
-* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
-* Cypress reserves the right to make changes without further notice to the
-* materials described herein. Cypress does not assume any liability arising out
-* of the application or use of any product or circuit described herein. Cypress
-* does not authorize its products for use as critical components in life-support
-* systems where a malfunction or failure may reasonably be expected to result in
-* significant injury to the user. The inclusion of Cypress' product in a life-
-* support systems application implies that the manufacturer assumes all risk of
-* such use and in doing so indemnifies Cypress against all charges. Use may be
-* limited by and subject to the applicable Cypress software license agreement.
-*****************************************************************************/
-
-
-/*****************************************************************************
-* Included headers
-*****************************************************************************/
-#include <project.h>
-#include <stdbool.h>
-#include "main.h"
-#include "HeartRateProcessing.h"
-#include "BleProcessing.h"
-
-
-/*****************************************************************************
-* Macros 
-*****************************************************************************/
-#define HEART_RATE_DATA_LEN					(2)
-#define HRM_FLAG                            (0)
-
-
-/*****************************************************************************
-* Static variables 
-*****************************************************************************/
-static uint8 deviceConnected = false;
-static uint8 hrsNotification = false;
-
-
-/*****************************************************************************
-* Public variables 
-*****************************************************************************/
-bool enterHibernateFlag = false;
-#if CONNECTION_PARAM_UPDATE
-uint32 timestampWhenConnected = 0;
-CONN_PARAM_REQUEST_STATE connParamRequestState = CONN_PARAM_REQUEST_NOT_SENT;
-#endif
-
-/*****************************************************************************
-* Public function definitions
-*****************************************************************************/
-
-/*****************************************************************************
-* Function Name: SendHeartRateOverBLE
-******************************************************************************
-* Summary:
-* Creates and sends the Heart Rate Measurement characteristic notification 
-* packet.
-*
-* Parameters:
-* None
-*
-* Return:
-* None
-*
-* Theory:
-* The function caches the value of the Heart Rate Measurement characteristic 
-* and updates the heart rate value in it. It then calls the BLE HRS service 
-* API to send this data via notification.
-*
-* Side Effects:
-* None
-*
-*****************************************************************************/
-void SendHeartRateOverBLE(void)
-{
-    /* Two byte packet for heart rate notification since the heart rate 
-     * measurement value is 8-bit (this is sufficient since our heart rate
-     * does not cross 255) and we are not using the Energy Expended 
-     * and RR-interval fields.
-     */
-	uint8 heartRatePacket[2];
-	
-	if(hrsNotification)
-	{
-        /* Read the existing characteristic value into a 
-         * two-byte array, by using CyBle_HrssGetCharacteristicValue(). 
-         */
-        CyBle_HrssGetCharacteristicValue(CYBLE_HRS_HRM, HEART_RATE_DATA_LEN, heartRatePacket);
-
-        
-        /* Update the second byte with the actual heart rate value. */
-        heartRatePacket[1] = heartRate;
-		
-        
-        /* Call the BLE component API to send notification */
-		CyBle_HrssSendNotification(cyBle_connHandle, CYBLE_HRS_HRM, HEART_RATE_DATA_LEN, heartRatePacket);
-    }
-}
-
-
-/*****************************************************************************
-* Function Name: HrsEventHandler
-******************************************************************************
-* Summary:
-* Event handler for the Heart Rate Service specific events.
-*
-* Parameters:
-* event: An enumerated value to be checked and accordingly some action to 
-*        be taken. The list of events is defined in the CYBLE_EVT_T enum.
-*
-* eventParam: The parameter associated with the event. The type of parameter
-*             can vary depending on the event. For more details refer the 
-*             BLE component datasheet.
-*
-* Return:
-* None
-*
-* Theory:
-* The function implements a switch statement to handle the notification
-* enable and notification disable events for the Heart Rate Service.
-*
-* Side Effects:
-* None
-*
-*****************************************************************************/
-void HrsEventHandler(uint32 event, void *eventParam)
-{
-    /* Event handler switch statement for the HRS service specific events. */
-     
-    
-    /* Set the hrsNotification variable on the notification 
-     * enabled event, and clear it on the disabled event.
-     */
-    switch(event)
-	{
-		case CYBLE_EVT_HRSS_NOTIFICATION_ENABLED:
-			hrsNotification = true;	
-		    break;
-		
-		case CYBLE_EVT_HRSS_NOTIFICATION_DISABLED:
-			hrsNotification = false;
-	    	break;
-		
-		default:
-    		break;
-	}
-}
-
-
-/*****************************************************************************
-* Function Name: GeneralEventHandler
-******************************************************************************
-* Summary:
-* Event handler for generic BLE events.
-*
-* Parameters:
-* event: An enumerated value to be checked and accordingly some action to 
-*        be taken. The list of events is defined in the CYBLE_EVENT_T enum.
-*
-* eventParam: The parameter associated with the event. The type of parameter
-*             can vary depending on the event. For more details refer the 
-*             BLE component datasheet.
-*
-* Return:
-* None
-*
-* Theory:
-* The function implements a switch case to handle different events for BLE
-* advertisement, connection and disconnection.
-*
-* Side Effects:
-* None
-*
-*****************************************************************************/
-void GeneralEventHandler(uint32 event, void *eventParam)
-{
-    /* Handle various events for a general BLE connection */
-	switch(event)
-	{
-		case CYBLE_EVT_STACK_ON:
-			/* Start the fast advertisement upon BLE initialization. */
-            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
-
-            #if (RGB_LED_IN_PROJECT)
-                /* Turn ON Green LED to indicate advertisement state */
-                Led_Advertising_Green_Write(0);
-            #endif  /* #if (RGB_LED_IN_PROJECT) */
-    		break;
-            
-        case CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP:
-            /* If advertisement finished, then enter Hibernate mode. */
-            if(CYBLE_STATE_DISCONNECTED == CyBle_GetState())
-            {
-                enterHibernateFlag = true;
-            }
-            break;
-            
-        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
-            /* Enter hibernate mode upon disconnect */
-			enterHibernateFlag = true;
-            break;
-			
-		case CYBLE_EVT_GATT_CONNECT_IND:
-			deviceConnected = true;
-            
-            #if (RGB_LED_IN_PROJECT)
-                /* Turn OFF Green LED; Turn ON Blue LED to indicate Connection */
-                Led_Advertising_Green_Write(1);
-                Led_Connected_Blue_Write(0);
-            #endif  /* #if (RGB_LED_IN_PROJECT) */
-			break;
-			
-		case CYBLE_EVT_GATT_DISCONNECT_IND:
-            /* Clear the HRS notification flag and the device connected flag */
-			hrsNotification = false;
-			deviceConnected = false;
-			break;
-		
-		default:
-    		break;
-	}
-}
-
-
-
-/* [] END OF FILE */
+/*****************************************************************************
+* File Name: BleProcessing.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the BLE capability in the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include "main.h"
+#include "HeartRateProcessing.h"
+#include "BleProcessing.h"
+#if ECG_STREAMING
+#include "EcgStreaming.h"
+#endif
+#include "EventTrace.h"
+#if HISTORY_LOG
+#include "HistoryLog.h"
+#endif
+#if BONDING
+#include "BondManager.h"
+#endif
+#if HR_BROADCAST
+#include "HrBroadcast.h"
+#endif
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+#define HEART_RATE_DATA_LEN					(2)
+#define HRM_FLAG                            (0)
+#define HRM_FLAG_RR_INTERVAL_PRESENT        (0x10)
+#define RR_INTERVAL_LEN                     (2)
+#define HRM_MAX_RR_INTERVALS                (8)
+#define CCC_DATA_INDEX                      (0)
+#define CCC_NOTIFICATION_BIT                (0x01)
+
+
+/*****************************************************************************
+* Static variables 
+*****************************************************************************/
+static uint8 deviceConnected = false;
+static uint8 hrsNotification = false;
+static uint16 negotiatedMtu = CYBLE_GATT_DEFAULT_MTU;
+
+
+/*****************************************************************************
+* Public variables 
+*****************************************************************************/
+bool enterHibernateFlag = false;
+#if CONNECTION_PARAM_UPDATE
+uint32 timestampWhenConnected = 0;
+CONN_PARAM_REQUEST_STATE connParamRequestState = CONN_PARAM_REQUEST_NOT_SENT;
+#endif
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: SendHeartRateOverBLE
+******************************************************************************
+* Summary:
+* Creates and sends the Heart Rate Measurement characteristic notification 
+* packet.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* The function caches the value of the Heart Rate Measurement characteristic 
+* and updates the heart rate value in it. The RR-intervals measured since 
+* the last notification are appended, as many as fit in the negotiated ATT
+* MTU; the rest stay queued for the next notification. It then calls the 
+* BLE HRS service API to send this data via notification.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void SendHeartRateOverBLE(void)
+{
+    /* The heart rate measurement value is 8-bit (this is sufficient since 
+     * our heart rate does not cross 255) and we are not using the Energy 
+     * Expended field. The RR-interval fields follow the heart rate value.
+     */
+	uint8 heartRatePacket[HEART_RATE_DATA_LEN + (HRM_MAX_RR_INTERVALS * RR_INTERVAL_LEN)];
+    uint16 rrIntervals[HRM_MAX_RR_INTERVALS];
+    uint16 maxRrIntervals;
+    uint8 rrCount;
+    uint8 packetLen = HEART_RATE_DATA_LEN;
+    uint8 index;
+	
+	if(hrsNotification)
+	{
+        /* Read the existing characteristic value into a 
+         * two-byte array, by using CyBle_HrssGetCharacteristicValue(). 
+         */
+        CyBle_HrssGetCharacteristicValue(CYBLE_HRS_HRM, HEART_RATE_DATA_LEN, heartRatePacket);
+
+        
+        /* Update the second byte with the actual heart rate value. */
+        heartRatePacket[1] = heartRate;
+        
+        
+        /* Append the queued RR-intervals that fit in the notification */
+        maxRrIntervals = (GetNotificationPayloadLen() - HEART_RATE_DATA_LEN) / RR_INTERVAL_LEN;
+        
+        if(maxRrIntervals > HRM_MAX_RR_INTERVALS)
+        {
+            maxRrIntervals = HRM_MAX_RR_INTERVALS;
+        }
+        
+        rrCount = GetRrIntervals(rrIntervals, (uint8)maxRrIntervals);
+        
+        for(index = 0; index < rrCount; index++)
+        {
+            heartRatePacket[packetLen++] = LO8(rrIntervals[index]);
+            heartRatePacket[packetLen++] = HI8(rrIntervals[index]);
+        }
+        
+        if(rrCount != 0)
+        {
+            heartRatePacket[HRM_FLAG] |= HRM_FLAG_RR_INTERVAL_PRESENT;
+        }
+        else
+        {
+            heartRatePacket[HRM_FLAG] &= (uint8)~HRM_FLAG_RR_INTERVAL_PRESENT;
+        }
+		
+        
+        /* Call the BLE component API to send notification */
+		CyBle_HrssSendNotification(cyBle_connHandle, CYBLE_HRS_HRM, packetLen, heartRatePacket);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: GetNegotiatedMtu
+******************************************************************************
+* Summary:
+* Returns the ATT MTU negotiated with the connected central.
+*
+* Parameters:
+* None
+*
+* Return:
+* uint16: Negotiated ATT MTU in bytes
+*
+* Theory:
+* The MTU is the default 23 bytes for every new connection until the 
+* central sends an Exchange MTU request. The effective value is then the 
+* smallest of the central's MTU and ATT_MTU_MAX, which is ATT_MTU_TARGET of
+* main.h clamped to the MTU configured in the BLE component.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+uint16 GetNegotiatedMtu(void)
+{
+    return negotiatedMtu;
+}
+
+
+/*****************************************************************************
+* Function Name: GetNotificationPayloadLen
+******************************************************************************
+* Summary:
+* Returns the largest value that fits in one notification on the current 
+* connection.
+*
+* Parameters:
+* None
+*
+* Return:
+* uint16: Notification payload length in bytes
+*
+* Theory:
+* Senders call this to pack as much data as possible into each packet. The
+* payload is the negotiated ATT MTU less the opcode and attribute handle.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+uint16 GetNotificationPayloadLen(void)
+{
+    return negotiatedMtu - ATT_NOTIFICATION_HEADER_LEN;
+}
+
+
+#if (HISTORY_LOG || BONDING)
+/*****************************************************************************
+* Function Name: IsFlashWriteSafe
+******************************************************************************
+* Summary:
+* Tells whether a flash row can be programmed now without stalling a 
+* connection event.
+*
+* Parameters:
+* None
+*
+* Return:
+* bool: true when disconnected, or connected and the BLE block has just 
+*       closed a connection event
+*
+* Theory:
+* CySysFlashWriteRow() stalls the CPU, and with it the BLE stack, for about
+* 20 ms. Right after a connection event closes, the stack has the longest 
+* time until it is needed again, so a connected device defers flash writes
+* to that moment. The main loop polls the BLE block in that state, so 
+* callers poll this function from the main loop.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+bool IsFlashWriteSafe(void)
+{
+    return (!deviceConnected) || (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_EVENT_CLOSE);
+}
+#endif
+
+
+/*****************************************************************************
+* Function Name: HrsEventHandler
+******************************************************************************
+* Summary:
+* Event handler for the Heart Rate Service specific events.
+*
+* Parameters:
+* event: An enumerated value to be checked and accordingly some action to 
+*        be taken. The list of events is defined in the CYBLE_EVT_T enum.
+*
+* eventParam: The parameter associated with the event. The type of parameter
+*             can vary depending on the event. For more details refer the 
+*             BLE component datasheet.
+*
+* Return:
+* None
+*
+* Theory:
+* The function implements a switch statement to handle the notification
+* enable and notification disable events for the Heart Rate Service.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HrsEventHandler(uint32 event, void *eventParam)
+{
+    /* Event handler switch statement for the HRS service specific events. */
+     
+    
+    /* Set the hrsNotification variable on the notification 
+     * enabled event, and clear it on the disabled event.
+     */
+    switch(event)
+	{
+		case CYBLE_EVT_HRSS_NOTIFICATION_ENABLED:
+			hrsNotification = true;	
+		    break;
+		
+		case CYBLE_EVT_HRSS_NOTIFICATION_DISABLED:
+			hrsNotification = false;
+	    	break;
+		
+		default:
+    		break;
+	}
+}
+
+
+/*****************************************************************************
+* Function Name: GeneralEventHandler
+******************************************************************************
+* Summary:
+* Event handler for generic BLE events.
+*
+* Parameters:
+* event: An enumerated value to be checked and accordingly some action to 
+*        be taken. The list of events is defined in the CYBLE_EVENT_T enum.
+*
+* eventParam: The parameter associated with the event. The type of parameter
+*             can vary depending on the event. For more details refer the 
+*             BLE component datasheet.
+*
+* Return:
+* None
+*
+* Theory:
+* The function implements a switch case to handle different events for BLE
+* advertisement, connection and disconnection.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void GeneralEventHandler(uint32 event, void *eventParam)
+{
+    CYBLE_GATT_XCHG_MTU_PARAM_T *mtuParam;
+    
+    #if (ECG_STREAMING || EVENT_TRACE || HISTORY_LOG)
+    CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReqParam;
+    #endif
+    
+    #if HISTORY_LOG
+    CYBLE_GATTS_ERR_PARAM_T writeErrorParam;
+    #endif
+    
+    /* Record the event in the event trace */
+    EVENT_TRACE_BLE_EVENT(event, eventParam);
+    
+    #if BONDING
+    /* Pairing, bonding and connect latency */
+    BondManager_HandleEvent(event, eventParam);
+    #endif
+    
+    /* Handle various events for a general BLE connection */
+	switch(event)
+	{
+		case CYBLE_EVT_STACK_ON:
+            #if HR_BROADCAST
+            /* Broadcast the heart rate in the advertising data instead of
+             * waiting for a connection */
+            HrBroadcast_Start();
+            #elif BONDING
+            /* Load the bonded centrals into the whitelist, then advertise 
+             * toward the last bonded central before any central. */
+            BondManager_Start();
+            BondManager_StartAdvertising(false);
+            #else
+			/* Start the fast advertisement upon BLE initialization. */
+            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+            #endif
+
+            #if (RGB_LED_IN_PROJECT)
+                /* Turn ON Green LED to indicate advertisement state */
+                Led_Advertising_Green_Write(0);
+            #endif  /* #if (RGB_LED_IN_PROJECT) */
+    		break;
+            
+        case CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP:
+            /* If advertisement finished, then enter Hibernate mode. */
+            if(CYBLE_STATE_DISCONNECTED == CyBle_GetState())
+            {
+                #if BONDING
+                /* Directed advertising is followed by undirected 
+                 * advertising before giving up */
+                if(!BondManager_AdvertisingStopped())
+                {
+                    enterHibernateFlag = true;
+                }
+                #else
+                enterHibernateFlag = true;
+                #endif
+            }
+            break;
+            
+        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
+            #if (HISTORY_LOG || BONDING)
+            /* Advertise again so that the central can reconnect (and sync 
+             * the history log). Hibernate follows the advertisement 
+             * timeout. */
+            #if BONDING
+            BondManager_StartAdvertising(true);
+            #else
+            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+            #endif
+            
+            #if (RGB_LED_IN_PROJECT)
+                /* Turn ON Green LED; Turn OFF Blue LED to indicate advertisement */
+                Led_Advertising_Green_Write(0);
+                Led_Connected_Blue_Write(1);
+            #endif  /* #if (RGB_LED_IN_PROJECT) */
+            #else
+            /* Enter hibernate mode upon disconnect */
+			enterHibernateFlag = true;
+            #endif
+            break;
+			
+		case CYBLE_EVT_GATT_CONNECT_IND:
+			deviceConnected = true;
+            negotiatedMtu = CYBLE_GATT_DEFAULT_MTU;
+            
+            #if (RGB_LED_IN_PROJECT)
+                /* Turn OFF Green LED; Turn ON Blue LED to indicate Connection */
+                Led_Advertising_Green_Write(1);
+                Led_Connected_Blue_Write(0);
+            #endif  /* #if (RGB_LED_IN_PROJECT) */
+			break;
+			
+		case CYBLE_EVT_GATT_DISCONNECT_IND:
+            /* Clear the HRS notification flag and the device connected flag */
+			hrsNotification = false;
+			deviceConnected = false;
+            negotiatedMtu = CYBLE_GATT_DEFAULT_MTU;
+            
+            #if ECG_STREAMING
+            EcgStreaming_SetNotification(false);
+            #endif
+            
+            #if EVENT_TRACE
+            EventTrace_SetNotification(false);
+            #endif
+            
+            #if HISTORY_LOG
+            HistoryLog_SetNotification(false);
+            #endif
+			break;
+        
+        case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
+            /* The stack responds with the MTU set in the BLE component. Keep
+             * the smallest of the central's MTU and ATT_MTU_MAX, the 
+             * application target clamped to the component MTU, as the MTU
+             * for this connection. */
+            mtuParam = (CYBLE_GATT_XCHG_MTU_PARAM_T *)eventParam;
+            negotiatedMtu = mtuParam->mtu;
+            
+            if(negotiatedMtu > ATT_MTU_MAX)
+            {
+                negotiatedMtu = ATT_MTU_MAX;
+            }
+            break;
+        
+        #if (ECG_STREAMING || EVENT_TRACE || HISTORY_LOG)
+        case CYBLE_EVT_GATTS_WRITE_REQ:
+            wrReqParam = (CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam;
+            
+            /* Enable or disable the notifications of the custom 
+             * characteristics when the central writes to their CCCD, and 
+             * store the new descriptor value so that it reads back 
+             * correctly. */
+            #if ECG_STREAMING
+            if(wrReqParam->handleValPair.attrHandle == ECG_SAMPLES_CCC_HANDLE)
+            {
+                EcgStreaming_SetNotification(
+                    (wrReqParam->handleValPair.value.val[CCC_DATA_INDEX] & CCC_NOTIFICATION_BIT) != 0);
+                
+                CyBle_GattsWriteAttributeValue(&wrReqParam->handleValPair, 0, &cyBle_connHandle, 
+                                               CYBLE_GATT_DB_PEER_INITIATED);
+            }
+            #endif
+            
+            #if EVENT_TRACE
+            if(wrReqParam->handleValPair.attrHandle == EVENT_TRACE_CCC_HANDLE)
+            {
+                EventTrace_SetNotification(
+                    (wrReqParam->handleValPair.value.val[CCC_DATA_INDEX] & CCC_NOTIFICATION_BIT) != 0);
+                
+                CyBle_GattsWriteAttributeValue(&wrReqParam->handleValPair, 0, &cyBle_connHandle, 
+                                               CYBLE_GATT_DB_PEER_INITIATED);
+            }
+            #endif
+            
+            #if HISTORY_LOG
+            if(wrReqParam->handleValPair.attrHandle == HISTORY_CCC_HANDLE)
+            {
+                HistoryLog_SetNotification(
+                    (wrReqParam->handleValPair.value.val[CCC_DATA_INDEX] & CCC_NOTIFICATION_BIT) != 0);
+                
+                CyBle_GattsWriteAttributeValue(&wrReqParam->handleValPair, 0, &cyBle_connHandle, 
+                                               CYBLE_GATT_DB_PEER_INITIATED);
+            }
+            
+            /* The central writes the sequence number to resume the sync from.
+             * A value of another length is rejected, so that the central 
+             * does not take its resume point as accepted. */
+            if(wrReqParam->handleValPair.attrHandle == HISTORY_CHAR_HANDLE)
+            {
+                if(wrReqParam->handleValPair.value.len != HISTORY_RESUME_LEN)
+                {
+                    writeErrorParam.attrHandle = wrReqParam->handleValPair.attrHandle;
+                    writeErrorParam.opcode = CYBLE_GATT_WRITE_REQ;
+                    writeErrorParam.errorCode = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+                    CyBle_GattsErrorRsp(cyBle_connHandle, &writeErrorParam);
+                    break;
+                }
+                
+                HistoryLog_SetResumeSequence(
+                    CyBle_Get16ByPtr(wrReqParam->handleValPair.value.val));
+            }
+            #endif
+            
+            /* Send the response to the write request received */
+            CyBle_GattsWriteRsp(cyBle_connHandle);
+            break;
+        #endif
+		
+		default:
+    		break;
+	}
+}
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,462 @@
+/*****************************************************************************
+* File Name: BondManager.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements bonding, the whitelist and directed advertising toward
+* the last bonded central in the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include <string.h>
+#include "main.h"
+#include "WatchdogTimer.h"
+#include "BleProcessing.h"
+#include "BondManager.h"
+
+
+#if BONDING
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Marks the flash row that holds the last bonded central */
+#define LAST_PEER_MAGIC                     (0x4250u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+/* Advertising phase after a disconnect or a wakeup */
+typedef enum
+{
+    ADV_PHASE_IDLE,
+    ADV_PHASE_DIRECTED,
+    ADV_PHASE_UNDIRECTED
+} ADV_PHASE_T;
+
+/* Layout of the flash row that holds the last bonded central */
+typedef struct
+{
+    uint16 magic;
+    CYBLE_GAP_BD_ADDR_T peerAddr;
+} LAST_PEER_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+/* Flash row for the last bonded central. The BLE component stores the keys
+ * themselves; this only tells which bonded central to advertise toward. */
+CY_ALIGN(CY_FLASH_SIZEOF_ROW) static const volatile uint8 lastPeerFlash[CY_FLASH_SIZEOF_ROW] = {0};
+
+static ADV_PHASE_T advPhase = ADV_PHASE_IDLE;
+
+/* Only bonded centrals may connect during undirected advertising */
+static bool whitelistOnly = false;
+
+/* Central to remember once the link is encrypted */
+static CYBLE_GAP_BD_ADDR_T connectedPeerAddr;
+static bool lastPeerUpdatePending = false;
+
+/* Advertising start time for the connect latency */
+static uint32 advStartTime = 0;
+
+static BOND_MANAGER_STATS_T bondStats;
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: GetLastPeer
+******************************************************************************
+* Summary:
+* Reads the last bonded central from flash.
+*
+* Parameters:
+* peerAddr: Returns the address of the central
+*
+* Return:
+* bool: false if no central has bonded yet
+*
+* Theory:
+* None
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+static bool GetLastPeer(CYBLE_GAP_BD_ADDR_T *peerAddr)
+{
+    LAST_PEER_T lastPeer;
+    uint8 index;
+    
+    for(index = 0; index < sizeof(lastPeer); index++)
+    {
+        ((uint8 *)&lastPeer)[index] = lastPeerFlash[index];
+    }
+    
+    *peerAddr = lastPeer.peerAddr;
+    
+    return (lastPeer.magic == LAST_PEER_MAGIC);
+}
+
+
+/*****************************************************************************
+* Function Name: StoreLastPeer
+******************************************************************************
+* Summary:
+* Writes the central of the present connection to flash as the last bonded
+* central.
+*
+* Parameters:
+* None
+*
+* Return:
+* bool: false if programming the row failed
+*
+* Theory:
+* The row is programmed only when the central differs from the stored one,
+* so reconnecting to the same central does not wear the flash.
+*
+* Side Effects:
+* Programming a flash row stalls the CPU for about 20 ms.
+*
+*****************************************************************************/
+static bool StoreLastPeer(void)
+{
+    uint8 rowData[CY_FLASH_SIZEOF_ROW];
+    LAST_PEER_T lastPeer;
+    CYBLE_GAP_BD_ADDR_T storedAddr;
+    uint32 rowNumber;
+    
+    if(GetLastPeer(&storedAddr) && 
+       (storedAddr.type == connectedPeerAddr.type) &&
+       (memcmp(storedAddr.bdAddr, connectedPeerAddr.bdAddr, CYBLE_GAP_BD_ADDR_SIZE) == 0))
+    {
+        return true;
+    }
+    
+    memset(rowData, 0, sizeof(rowData));
+    lastPeer.magic = LAST_PEER_MAGIC;
+    lastPeer.peerAddr = connectedPeerAddr;
+    memcpy(rowData, &lastPeer, sizeof(lastPeer));
+    
+    rowNumber = ((uint32)lastPeerFlash - CY_FLASH_BASE) / CY_FLASH_SIZEOF_ROW;
+    
+    return (CySysFlashWriteRow(rowNumber, rowData) == CY_SYS_FLASH_SUCCESS);
+}
+
+
+/*****************************************************************************
+* Function Name: StartUndirectedAdvertising
+******************************************************************************
+* Summary:
+* Starts the fast undirected advertising set in the BLE component.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* After a disconnect the connect requests are filtered by the whitelist so 
+* that only bonded centrals can reconnect. After a reset or a wakeup any 
+* central can connect and pair.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+static void StartUndirectedAdvertising(void)
+{
+    cyBle_discoveryModeInfo.advParam->advType = CYBLE_GAPP_CONNECTABLE_UNDIRECTED_ADV;
+    cyBle_discoveryModeInfo.advParam->advFilterPolicy = 
+        whitelistOnly ? CYBLE_GAPP_SCAN_ANY_CONN_WHITELIST : CYBLE_GAPP_SCAN_ANY_CONN_ANY;
+    
+    advPhase = ADV_PHASE_UNDIRECTED;
+    CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+}
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: BondManager_Start
+******************************************************************************
+* Summary:
+* Adds the bonded centrals to the whitelist.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Called on CYBLE_EVT_STACK_ON, before advertising starts; the whitelist 
+* cannot be changed while it is in use.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void BondManager_Start(void)
+{
+    CYBLE_GAP_BONDED_DEV_ADDR_LIST_T bondedList;
+    uint8 index;
+    
+    if(CyBle_GapGetBondedDevicesList(&bondedList) == CYBLE_ERROR_OK)
+    {
+        for(index = 0; index < bondedList.count; index++)
+        {
+            /* Fails harmlessly if the central is already in the list */
+            (void)CyBle_GapAddDeviceToWhiteList(&bondedList.bdAddrList[index]);
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: BondManager_StartAdvertising
+******************************************************************************
+* Summary:
+* Starts advertising, toward the last bonded central first.
+*
+* Parameters:
+* afterDisconnect: true when the previous connection was just lost, false 
+*                  after a reset or a wakeup
+*
+* Return:
+* None
+*
+* Theory:
+* High duty cycle directed advertising lets the last bonded central 
+* reconnect within a few milliseconds, without depending on its scan duty
+* cycle. The controller ends it after 1.28 s and BondManager_AdvertisingStopped()
+* then falls back to undirected advertising.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void BondManager_StartAdvertising(bool afterDisconnect)
+{
+    CYBLE_GAP_BD_ADDR_T lastPeerAddr;
+    
+    whitelistOnly = afterDisconnect;
+    advStartTime = WatchdogTimer_GetTimestamp();
+    
+    if(GetLastPeer(&lastPeerAddr))
+    {
+        cyBle_discoveryModeInfo.advParam->advType = CYBLE_GAPP_CONNECTABLE_HIGH_DC_DIRECTED_ADV;
+        cyBle_discoveryModeInfo.advParam->directAddrType = lastPeerAddr.type;
+        memcpy(cyBle_discoveryModeInfo.advParam->directAddr, lastPeerAddr.bdAddr, CYBLE_GAP_BD_ADDR_SIZE);
+        
+        advPhase = ADV_PHASE_DIRECTED;
+        CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+    }
+    else
+    {
+        StartUndirectedAdvertising();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: BondManager_AdvertisingStopped
+******************************************************************************
+* Summary:
+* Moves to the next advertising phase when advertising stops without a 
+* connection.
+*
+* Parameters:
+* None
+*
+* Return:
+* bool: true if undirected advertising was started, false if advertising 
+*       has timed out
+*
+* Theory:
+* None
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+bool BondManager_AdvertisingStopped(void)
+{
+    if(advPhase == ADV_PHASE_DIRECTED)
+    {
+        StartUndirectedAdvertising();
+        return true;
+    }
+    
+    advPhase = ADV_PHASE_IDLE;
+    return false;
+}
+
+
+/*****************************************************************************
+* Function Name: BondManager_HandleEvent
+******************************************************************************
+* Summary:
+* Handles the BLE events for pairing, bonding and the connect latency.
+*
+* Parameters:
+* event:      CYBLE_EVT_* event code
+* eventParam: Parameter passed with the event
+*
+* Return:
+* None
+*
+* Theory:
+* The pairing request of the central is accepted with the security set in 
+* the BLE component. Once the link is encrypted the central is bonded, so 
+* it is added to the whitelist and remembered for directed advertising.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void BondManager_HandleEvent(uint32 event, void *eventParam)
+{
+    switch(event)
+    {
+        case CYBLE_EVT_GAP_AUTH_REQ:
+            CyBle_GappAuthReqReply(cyBle_connHandle.bdHandle, &cyBle_authInfo);
+            break;
+        
+        case CYBLE_EVT_GATT_CONNECT_IND:
+            bondStats.connectLatencyMs = WatchdogTimer_GetTimestamp() - advStartTime;
+            bondStats.directed = (advPhase == ADV_PHASE_DIRECTED);
+            advPhase = ADV_PHASE_IDLE;
+            break;
+        
+        case CYBLE_EVT_GAP_ENCRYPT_CHANGE:
+            if((*(uint8 *)eventParam != 0) &&
+               (CyBle_GapGetPeerBdAddr(cyBle_connHandle.bdHandle, &connectedPeerAddr) == CYBLE_ERROR_OK))
+            {
+                (void)CyBle_GapAddDeviceToWhiteList(&connectedPeerAddr);
+                lastPeerUpdatePending = true;
+            }
+            break;
+        
+        default:
+            break;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: BondManager_Process
+******************************************************************************
+* Summary:
+* Writes the pending bonding data to flash.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* The BLE stack flags new keys and CCCD values in cyBle_pendingFlashWrite;
+* CyBle_StoreBondingData() writes them a row at a time and is called until 
+* nothing is pending. The last bonded central is written from here too, 
+* outside the BLE event callback, and stays pending until the row is 
+* programmed. Polled from the low power loop of main(); each row waits for 
+* the end of a connection event, see IsFlashWriteSafe().
+*
+* Side Effects:
+* Programming a flash row stalls the CPU for about 20 ms.
+*
+*****************************************************************************/
+void BondManager_Process(void)
+{
+    if(!IsFlashWriteSafe())
+    {
+        return;
+    }
+    
+    if(cyBle_pendingFlashWrite != 0)
+    {
+        (void)CyBle_StoreBondingData(0);
+    }
+    else if(lastPeerUpdatePending)
+    {
+        lastPeerUpdatePending = !StoreLastPeer();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: BondManager_GetStats
+******************************************************************************
+* Summary:
+* Returns the connect latency of the last connection.
+*
+* Parameters:
+* stats: Returns the connect latency
+*
+* Return:
+* None
+*
+* Theory:
+* The latency is measured with the watchdog timer, in 10 ms steps.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void BondManager_GetStats(BOND_MANAGER_STATS_T *stats)
+{
+    *stats = bondStats;
+}
+
+#endif  /* #if BONDING */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,296 @@
+/*****************************************************************************
+* File Name: EcgStreaming.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the raw ECG waveform streaming in the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include "main.h"
+#include "BleProcessing.h"
+#include "EcgStreaming.h"
+#if ECG_COMPRESSION
+#include "SampleCodec.h"
+#endif
+
+
+#if ECG_STREAMING
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Number of samples held in the ring buffer. Must be a power of two. At the
+ * 100 Hz sample rate this covers 1.28 seconds of missed connection events.
+ */
+#define ECG_RING_SIZE                       (128u)
+#define ECG_RING_MASK                       (ECG_RING_SIZE - 1u)
+
+/* Packet header: 16-bit sequence number of the first sample in the packet */
+#define ECG_PACKET_HEADER_LEN               (2u)
+#define ECG_SAMPLE_LEN                      (2u)
+#define ECG_PACKET_MAX_LEN                  (ATT_MTU_MAX - ATT_NOTIFICATION_HEADER_LEN)
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static int16 ecgRing[ECG_RING_SIZE];
+static uint16 ecgRingHead = 0;
+static uint16 ecgRingTail = 0;
+
+/* Sequence number of the sample at the tail of the ring buffer. Samples
+ * dropped on overflow still advance it, so the central can detect gaps.
+ */
+static uint16 ecgTailSequence = 0;
+
+static bool ecgNotification = false;
+static uint8 ecgPacket[ECG_PACKET_MAX_LEN];
+
+#if ECG_COMPRESSION
+static int16 ecgBlock[SAMPLE_CODEC_MAX_BLOCK_LEN];
+#endif
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: EcgStreaming_PushSample
+******************************************************************************
+* Summary:
+* Queues one ADC sample for streaming.
+*
+* Parameters:
+* sample: ADC output read by ProcessHeartRateSignal()
+*
+* Return:
+* None
+*
+* Theory:
+* The sample is stored in a ring buffer so that the measurement loop never 
+* waits for the radio. If the buffer is full, the oldest sample is dropped 
+* and the tail sequence number is advanced past it. Nothing is queued while 
+* notifications are disabled.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void EcgStreaming_PushSample(int16 sample)
+{
+    if(!ecgNotification)
+    {
+        return;
+    }
+    
+    ecgRing[ecgRingHead & ECG_RING_MASK] = sample;
+    ecgRingHead++;
+    
+    /* Overwrite the oldest sample when the ring buffer is full */
+    if((uint16)(ecgRingHead - ecgRingTail) > ECG_RING_SIZE)
+    {
+        ecgRingTail++;
+        ecgTailSequence++;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: EcgStreaming_SendPending
+******************************************************************************
+* Summary:
+* Sends the queued samples as ECG Samples characteristic notifications.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Each notification carries the 16-bit sequence number of its first sample
+* followed by the samples. Without compression these are little-endian 
+* 16-bit values, as many as fit in the negotiated ATT MTU. With 
+* ECG_COMPRESSION the samples are one SampleCodec block instead; a block of 
+* SAMPLE_CODEC_MAX_BLOCK_LEN samples is halved until it fits the packet.
+* Only full packets are sent, and only while the BLE stack is free to 
+* accept data, so the function never blocks. Samples stay queued if the
+* stack rejects the notification.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void EcgStreaming_SendPending(void)
+{
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T notificationHandle;
+    uint16 packetMaxLen;
+    uint16 samplesPerPacket;
+    uint16 index;
+    uint16 packetLen;
+    #if !ECG_COMPRESSION
+    int16 sample;
+    #endif
+    
+    if(!ecgNotification)
+    {
+        return;
+    }
+    
+    packetMaxLen = GetNotificationPayloadLen();
+    
+    #if ECG_COMPRESSION
+    samplesPerPacket = SAMPLE_CODEC_MAX_BLOCK_LEN;
+    #else
+    samplesPerPacket = (packetMaxLen - ECG_PACKET_HEADER_LEN) / ECG_SAMPLE_LEN;
+    #endif
+    
+    while(((uint16)(ecgRingHead - ecgRingTail) >= samplesPerPacket) &&
+          (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        ecgPacket[0] = LO8(ecgTailSequence);
+        ecgPacket[1] = HI8(ecgTailSequence);
+        
+        #if ECG_COMPRESSION
+        for(index = 0; index < SAMPLE_CODEC_MAX_BLOCK_LEN; index++)
+        {
+            ecgBlock[index] = ecgRing[(ecgRingTail + index) & ECG_RING_MASK];
+        }
+        
+        /* A single sample always fits, so this terminates */
+        do
+        {
+            packetLen = SampleCodec_EncodeBlock(ecgBlock, (uint8)samplesPerPacket, 
+                                                &ecgPacket[ECG_PACKET_HEADER_LEN], 
+                                                packetMaxLen - ECG_PACKET_HEADER_LEN);
+            if(packetLen == 0u)
+            {
+                samplesPerPacket >>= 1;
+            }
+        } while(packetLen == 0u);
+        
+        packetLen += ECG_PACKET_HEADER_LEN;
+        #else
+        packetLen = ECG_PACKET_HEADER_LEN;
+        
+        for(index = 0; index < samplesPerPacket; index++)
+        {
+            sample = ecgRing[(ecgRingTail + index) & ECG_RING_MASK];
+            ecgPacket[packetLen++] = LO8(sample);
+            ecgPacket[packetLen++] = HI8(sample);
+        }
+        #endif
+        
+        notificationHandle.attrHandle = ECG_SAMPLES_CHAR_HANDLE;
+        notificationHandle.value.val = ecgPacket;
+        notificationHandle.value.len = packetLen;
+        
+        if(CyBle_GattsNotification(cyBle_connHandle, &notificationHandle) != CYBLE_ERROR_OK)
+        {
+            break;
+        }
+        
+        ecgRingTail += samplesPerPacket;
+        ecgTailSequence += samplesPerPacket;
+        
+        #if ECG_COMPRESSION
+        samplesPerPacket = SAMPLE_CODEC_MAX_BLOCK_LEN;
+        #endif
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: EcgStreaming_SetNotification
+******************************************************************************
+* Summary:
+* Enables or disables the ECG sample notifications.
+*
+* Parameters:
+* enable: true when the central has enabled notifications
+*
+* Return:
+* None
+*
+* Theory:
+* The ring buffer is emptied on every change so that a new stream starts 
+* with fresh samples.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void EcgStreaming_SetNotification(bool enable)
+{
+    ecgNotification = enable;
+    ecgRingTail = ecgRingHead;
+}
+
+
+/*****************************************************************************
+* Function Name: EcgStreaming_IsNotificationEnabled
+******************************************************************************
+* Summary:
+* Returns whether the ECG sample notifications are enabled.
+*
+* Parameters:
+* None
+*
+* Return:
+* bool: true if notifications are enabled
+*
+* Theory:
+* None
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+bool EcgStreaming_IsNotificationEnabled(void)
+{
+    return ecgNotification;
+}
+
+#endif  /* #if ECG_STREAMING */
+
+
+/* [] END OF FILE */
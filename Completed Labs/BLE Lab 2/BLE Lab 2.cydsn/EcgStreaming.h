@@ -0,0 +1,74 @@
+/*****************************************************************************
+* File Name: EcgStreaming.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the functions for streaming the raw ECG waveform over a
+* custom GATT service, implemented as part of the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_ECG_STREAMING_H)
+#define _ECG_STREAMING_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Handles generated by the BLE component for the custom ECG Streaming
+ * service. The service has one "ECG Samples" characteristic with the Notify
+ * property and its Client Characteristic Configuration descriptor.
+ */
+#define ECG_SAMPLES_CHAR_HANDLE         (CYBLE_ECG_STREAMING_SERVICE_ECG_SAMPLES_CHAR_HANDLE)
+#define ECG_SAMPLES_CCC_HANDLE          (CYBLE_ECG_STREAMING_SERVICE_ECG_SAMPLES_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+extern void EcgStreaming_PushSample(int16 sample);
+extern void EcgStreaming_SendPending(void);
+extern void EcgStreaming_SetNotification(bool enable);
+extern bool EcgStreaming_IsNotificationEnabled(void);
+
+
+#endif
+
+/* [] END OF FILE */
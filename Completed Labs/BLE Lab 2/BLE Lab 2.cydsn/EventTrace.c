@@ -0,0 +1,283 @@
+/*****************************************************************************
+* File Name: EventTrace.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the BLE event trace in the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include "main.h"
+#include "BleProcessing.h"
+#include "WatchdogTimer.h"
+#include "EventTrace.h"
+
+
+#if EVENT_TRACE
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Number of records kept in RAM. Must be a power of two. */
+#define EVENT_TRACE_SIZE                    (64u)
+#define EVENT_TRACE_MASK                    (EVENT_TRACE_SIZE - 1u)
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static EVENT_TRACE_RECORD_T traceBuffer[EVENT_TRACE_SIZE];
+
+/* Total number of records written; the newest record is at traceHead - 1 */
+static uint32 traceHead = 0;
+
+/* Next record to send and the end of the dump in progress */
+static uint32 dumpIndex = 0;
+static uint32 dumpEnd = 0;
+
+static uint8 tracePacket[ATT_MTU_MAX - ATT_NOTIFICATION_HEADER_LEN];
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: EventTrace_Record
+******************************************************************************
+* Summary:
+* Appends a record to the trace.
+*
+* Parameters:
+* event:   CYBLE_EVT_* event code
+* payload: Event specific value
+*
+* Return:
+* None
+*
+* Theory:
+* The record is written at the head of a RAM ring buffer and overwrites the
+* oldest record when the buffer is full. This is three stores and an 
+* increment, so it can stay enabled in production builds. With 
+* EventTrace_GetPayload() it adds 2 to 5 ns per event on a PC, see 
+* Host/EventTraceBench.c; by instruction count, about 40 cycles or under 
+* 1 us on the 48 MHz Cortex-M0.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void EventTrace_Record(uint32 event, uint16 payload)
+{
+    EVENT_TRACE_RECORD_T *record = &traceBuffer[traceHead & EVENT_TRACE_MASK];
+    
+    record->timestamp = WatchdogTimer_GetTimestamp();
+    record->eventId = (uint16)event;
+    record->payload = payload;
+    traceHead++;
+}
+
+
+/*****************************************************************************
+* Function Name: EventTrace_GetPayload
+******************************************************************************
+* Summary:
+* Extracts the traced payload from the event parameter.
+*
+* Parameters:
+* event:      CYBLE_EVT_* event code
+* eventParam: Parameter passed with the event
+*
+* Return:
+* uint16: Disconnect reason, attribute handle of a write, exchanged MTU or 
+*         stack busy status; zero for other events
+*
+* Theory:
+* None
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+uint16 EventTrace_GetPayload(uint32 event, void *eventParam)
+{
+    uint16 payload = 0;
+    
+    switch(event)
+    {
+        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
+        case CYBLE_EVT_STACK_BUSY_STATUS:
+            payload = *(uint8 *)eventParam;
+            break;
+        
+        case CYBLE_EVT_GATTS_WRITE_REQ:
+        case CYBLE_EVT_GATTS_WRITE_CMD_REQ:
+            payload = ((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam)->handleValPair.attrHandle;
+            break;
+        
+        case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
+            payload = ((CYBLE_GATT_XCHG_MTU_PARAM_T *)eventParam)->mtu;
+            break;
+        
+        default:
+            break;
+    }
+    
+    return payload;
+}
+
+
+/*****************************************************************************
+* Function Name: EventTrace_SetNotification
+******************************************************************************
+* Summary:
+* Starts or stops a trace dump.
+*
+* Parameters:
+* enable: true when the central has enabled notifications on the Event 
+*         Trace characteristic
+*
+* Return:
+* None
+*
+* Theory:
+* Enabling notifications starts a dump of the records in the buffer at that
+* moment, oldest first. Records added during the dump are sent by the next 
+* one.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void EventTrace_SetNotification(bool enable)
+{
+    if(enable)
+    {
+        dumpEnd = traceHead;
+        dumpIndex = (traceHead > EVENT_TRACE_SIZE) ? (traceHead - EVENT_TRACE_SIZE) : 0u;
+    }
+    else
+    {
+        dumpIndex = dumpEnd;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: EventTrace_SendPending
+******************************************************************************
+* Summary:
+* Sends the next part of a trace dump.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Records are packed into notifications of the negotiated payload size and 
+* sent while the BLE stack is free. Records overwritten before they could be
+* sent are skipped; the host sees the gap in the timestamps. The dump ends
+* at the newest record of the moment it started, even if it was overwritten.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void EventTrace_SendPending(void)
+{
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T notificationHandle;
+    EVENT_TRACE_RECORD_T *record;
+    uint16 packetMaxLen;
+    uint16 packetLen;
+    
+    packetMaxLen = GetNotificationPayloadLen();
+    
+    while((dumpIndex != dumpEnd) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        /* Skip the records overwritten since the dump started. Records 
+         * added since then are not part of this dump, so if the overwritten 
+         * ones reach its end, the dump is over. */
+        if((traceHead - dumpIndex) > EVENT_TRACE_SIZE)
+        {
+            if((traceHead - EVENT_TRACE_SIZE) >= dumpEnd)
+            {
+                dumpIndex = dumpEnd;
+                break;
+            }
+            
+            dumpIndex = traceHead - EVENT_TRACE_SIZE;
+        }
+        
+        packetLen = 0;
+        
+        while((dumpIndex + (packetLen / EVENT_TRACE_RECORD_LEN) != dumpEnd) &&
+              ((packetLen + EVENT_TRACE_RECORD_LEN) <= packetMaxLen))
+        {
+            record = &traceBuffer[(dumpIndex + (packetLen / EVENT_TRACE_RECORD_LEN)) & EVENT_TRACE_MASK];
+            
+            tracePacket[packetLen++] = LO8(LO16(record->timestamp));
+            tracePacket[packetLen++] = HI8(LO16(record->timestamp));
+            tracePacket[packetLen++] = LO8(HI16(record->timestamp));
+            tracePacket[packetLen++] = HI8(HI16(record->timestamp));
+            tracePacket[packetLen++] = LO8(record->eventId);
+            tracePacket[packetLen++] = HI8(record->eventId);
+            tracePacket[packetLen++] = LO8(record->payload);
+            tracePacket[packetLen++] = HI8(record->payload);
+        }
+        
+        notificationHandle.attrHandle = EVENT_TRACE_CHAR_HANDLE;
+        notificationHandle.value.val = tracePacket;
+        notificationHandle.value.len = packetLen;
+        
+        if(CyBle_GattsNotification(cyBle_connHandle, &notificationHandle) != CYBLE_ERROR_OK)
+        {
+            break;
+        }
+        
+        dumpIndex += packetLen / EVENT_TRACE_RECORD_LEN;
+    }
+}
+
+#endif  /* #if EVENT_TRACE */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,627 @@
+/*****************************************************************************
+* File Name: HistoryLog.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the heart rate history log in the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include "main.h"
+#include "HeartRateProcessing.h"
+#include "BleProcessing.h"
+#include "WatchdogTimer.h"
+#include "HistoryLog.h"
+
+
+#if HISTORY_LOG
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Time between two records */
+#define HISTORY_LOG_INTERVAL_MS             (5000u)
+#define MS_PER_SECOND                       (1000u)
+
+/* Number of flash rows used by the log. The rows are written in turn, so 
+ * each row is erased once every HISTORY_LOG_ROWS row writes. */
+#define HISTORY_LOG_ROWS                    (32u)
+
+/* Each flash row starts with a header followed by the records */
+#define HISTORY_ROW_HEADER_LEN              (8u)
+#define HISTORY_RECORDS_PER_ROW             ((CY_FLASH_SIZEOF_ROW - HISTORY_ROW_HEADER_LEN) / HISTORY_RECORD_LEN)
+#define HISTORY_ROW_MAGIC                   (0x4C48u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+/* Layout of one flash row */
+typedef struct
+{
+    uint16 magic;           /* HISTORY_ROW_MAGIC once the row is written */
+    uint8 recordCount;      /* Records in this row, less than full on flush */
+    uint8 reserved[HISTORY_ROW_HEADER_LEN - 3u];
+    HISTORY_RECORD_T records[HISTORY_RECORDS_PER_ROW];
+} HISTORY_ROW_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+/* Flash reserved for the log. It is erased when the device is programmed 
+ * and written a row at a time by CySysFlashWriteRow(). */
+CY_ALIGN(CY_FLASH_SIZEOF_ROW) static const volatile HISTORY_ROW_T historyFlash[HISTORY_LOG_ROWS] = {{0}};
+
+/* Records batched in RAM until a complete row can be written */
+static HISTORY_ROW_T rowBuffer;
+
+/* Flash row written by the next flush */
+static uint8 writeRow = 0;
+
+/* Sequence number of the next record and the present session */
+static uint16 nextSequence = 0;
+static uint8 session = 0;
+
+/* Timestamp of the last record */
+static uint32 lastRecordTime = 0;
+
+/* Sync state: next record to send and the resume point from the central */
+static bool historyNotification = false;
+static bool resumeRequested = false;
+static uint16 syncSequence = 0;
+
+/* Sync in progress and its start time for the throughput counters */
+static bool syncInProgress = false;
+static uint32 syncStartTime = 0;
+static uint32 syncRecordCount = 0;
+
+static HISTORY_LOG_STATS_T historyStats;
+
+static uint8 historyPacket[ATT_MTU_MAX - ATT_NOTIFICATION_HEADER_LEN];
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: IsRowValid
+******************************************************************************
+* Summary:
+* Checks whether a flash row of the log holds records.
+*
+* Parameters:
+* row: Row index in historyFlash
+*
+* Return:
+* bool: true if the row has been written by the log
+*
+* Theory:
+* None
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+static bool IsRowValid(uint8 row)
+{
+    return (historyFlash[row].magic == HISTORY_ROW_MAGIC) &&
+           (historyFlash[row].recordCount != 0) &&
+           (historyFlash[row].recordCount <= HISTORY_RECORDS_PER_ROW);
+}
+
+
+/*****************************************************************************
+* Function Name: GetOldestSequence
+******************************************************************************
+* Summary:
+* Returns the sequence number of the oldest record in the log.
+*
+* Parameters:
+* None
+*
+* Return:
+* uint16: Oldest sequence number, or nextSequence if the log is empty
+*
+* Theory:
+* The rows are written in ring order, so the oldest row is the first valid 
+* row starting from the one written next.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+static uint16 GetOldestSequence(void)
+{
+    uint8 row = writeRow;
+    uint8 index;
+    
+    for(index = 0; index < HISTORY_LOG_ROWS; index++)
+    {
+        if(IsRowValid(row))
+        {
+            return historyFlash[row].records[0].sequence;
+        }
+        
+        row = (row + 1u) % HISTORY_LOG_ROWS;
+    }
+    
+    return (rowBuffer.recordCount != 0) ? rowBuffer.records[0].sequence : nextSequence;
+}
+
+
+/*****************************************************************************
+* Function Name: FindRecord
+******************************************************************************
+* Summary:
+* Looks up a record by its sequence number.
+*
+* Parameters:
+* sequence: Sequence number of the record
+* record:   Returns the record if found
+*
+* Return:
+* bool: false if the record is not in the log (not yet logged or 
+*       overwritten)
+*
+* Theory:
+* The records of a row and of the RAM batch have consecutive sequence 
+* numbers, so the offset from the first record of a row tells whether it 
+* holds the record.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+static bool FindRecord(uint16 sequence, HISTORY_RECORD_T *record)
+{
+    uint16 offset;
+    uint8 row;
+    
+    offset = (uint16)(sequence - rowBuffer.records[0].sequence);
+    
+    if(offset < rowBuffer.recordCount)
+    {
+        *record = rowBuffer.records[offset];
+        return true;
+    }
+    
+    for(row = 0; row < HISTORY_LOG_ROWS; row++)
+    {
+        if(IsRowValid(row))
+        {
+            offset = (uint16)(sequence - historyFlash[row].records[0].sequence);
+            
+            if(offset < historyFlash[row].recordCount)
+            {
+                *record = historyFlash[row].records[offset];
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: HistoryLog_Start
+******************************************************************************
+* Summary:
+* Finds the end of the log in flash after a reset or a wakeup.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* The row with the newest last record is the end of the log. Logging 
+* continues with the next sequence number in the next row, as a new 
+* session. Sequence numbers are compared modulo 2^16; the log holds far
+* fewer records than that.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HistoryLog_Start(void)
+{
+    HISTORY_RECORD_T lastRecord;
+    HISTORY_RECORD_T newestRecord = {0};
+    bool found = false;
+    uint8 row;
+    
+    for(row = 0; row < HISTORY_LOG_ROWS; row++)
+    {
+        if(IsRowValid(row))
+        {
+            lastRecord = historyFlash[row].records[historyFlash[row].recordCount - 1u];
+            
+            if((!found) || ((int16)(lastRecord.sequence - newestRecord.sequence) > 0))
+            {
+                newestRecord = lastRecord;
+                writeRow = (row + 1u) % HISTORY_LOG_ROWS;
+                found = true;
+            }
+        }
+    }
+    
+    if(found)
+    {
+        nextSequence = newestRecord.sequence + 1u;
+        session = newestRecord.session + 1u;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_Process
+******************************************************************************
+* Summary:
+* Logs the present heart rate every HISTORY_LOG_INTERVAL_MS.
+*
+* Parameters:
+* timestamp: Present watchdog timer timestamp in ms
+*
+* Return:
+* None
+*
+* Theory:
+* Records are batched in RAM. A batch that fills a row is programmed by 
+* HistoryLog_FlushPending() between two connection events; until then the 
+* next record waits and is logged late. Nothing is logged until the first 
+* heart rate has been measured.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HistoryLog_Process(uint32 timestamp)
+{
+    HISTORY_RECORD_T *record;
+    
+    if(((timestamp - lastRecordTime) < HISTORY_LOG_INTERVAL_MS) || (heartRate == 0) ||
+       (rowBuffer.recordCount == HISTORY_RECORDS_PER_ROW))
+    {
+        return;
+    }
+    
+    lastRecordTime = timestamp;
+    
+    record = &rowBuffer.records[rowBuffer.recordCount];
+    record->sequence = nextSequence++;
+    record->timestamp = (uint16)(timestamp / MS_PER_SECOND);
+    record->rrInterval = lastRrInterval;
+    record->heartRate = heartRate;
+    record->session = session;
+    rowBuffer.recordCount++;
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_Flush
+******************************************************************************
+* Summary:
+* Writes the records batched in RAM to the next flash row.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Called by HistoryLog_FlushPending() and, disconnected, before the device 
+* hibernates. A partial row is written as is; the next session starts a 
+* new row. The rows are used in turn, which spreads the erase cycles 
+* evenly over the log.
+*
+* Side Effects:
+* Programming a flash row stalls the CPU for about 20 ms.
+*
+*****************************************************************************/
+void HistoryLog_Flush(void)
+{
+    uint32 rowNumber;
+    
+    if(rowBuffer.recordCount == 0)
+    {
+        return;
+    }
+    
+    rowBuffer.magic = HISTORY_ROW_MAGIC;
+    rowNumber = ((uint32)&historyFlash[writeRow] - CY_FLASH_BASE) / CY_FLASH_SIZEOF_ROW;
+    
+    if(CySysFlashWriteRow(rowNumber, (const uint8 *)&rowBuffer) == CY_SYS_FLASH_SUCCESS)
+    {
+        historyStats.flashRowWrites++;
+        writeRow = (writeRow + 1u) % HISTORY_LOG_ROWS;
+        rowBuffer.recordCount = 0;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_FlushPending
+******************************************************************************
+* Summary:
+* Writes a full batch to flash once that does not disturb the connection.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Polled from the low power loop of main(), which keeps polling while the
+* BLE block closes a connection event; see IsFlashWriteSafe(). A failed 
+* write is retried at the next safe moment.
+*
+* Side Effects:
+* Programming a flash row stalls the CPU for about 20 ms.
+*
+*****************************************************************************/
+void HistoryLog_FlushPending(void)
+{
+    if((rowBuffer.recordCount == HISTORY_RECORDS_PER_ROW) && IsFlashWriteSafe())
+    {
+        HistoryLog_Flush();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_SetNotification
+******************************************************************************
+* Summary:
+* Starts or stops the sync of the log.
+*
+* Parameters:
+* enable: true when the central has enabled notifications on the History 
+*         characteristic
+*
+* Return:
+* None
+*
+* Theory:
+* The sync starts from the oldest record in the log, unless the central 
+* has written a resume sequence number on this connection.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HistoryLog_SetNotification(bool enable)
+{
+    historyNotification = enable;
+    
+    if(enable)
+    {
+        if(!resumeRequested)
+        {
+            syncSequence = GetOldestSequence();
+        }
+        
+        syncInProgress = true;
+        syncStartTime = WatchdogTimer_GetTimestamp();
+        syncRecordCount = 0;
+    }
+    else
+    {
+        resumeRequested = false;
+        syncInProgress = false;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_SetResumeSequence
+******************************************************************************
+* Summary:
+* Sets the record the sync starts from.
+*
+* Parameters:
+* sequence: Sequence number of the first record the central wants, usually
+*           one past the last record it received
+*
+* Return:
+* None
+*
+* Theory:
+* A sequence number older than the log starts from the oldest record; one 
+* ahead of the log only sends new records. If notifications are already 
+* enabled the sync restarts from this record.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HistoryLog_SetResumeSequence(uint16 sequence)
+{
+    uint16 oldestSequence = GetOldestSequence();
+    
+    if((int16)(sequence - oldestSequence) < 0)
+    {
+        sequence = oldestSequence;
+    }
+    else if((int16)(sequence - nextSequence) > 0)
+    {
+        sequence = nextSequence;
+    }
+    
+    syncSequence = sequence;
+    resumeRequested = true;
+    
+    if(historyNotification)
+    {
+        HistoryLog_SetNotification(true);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_SendPending
+******************************************************************************
+* Summary:
+* Sends the records not yet synced to the central.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Records are packed into notifications of the negotiated payload size and 
+* sent while the BLE stack is free. Once the backlog is sent, new records 
+* are sent as they are logged. Records overwritten before they could be 
+* sent are skipped; the central sees the gap in the sequence numbers.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HistoryLog_SendPending(void)
+{
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T notificationHandle;
+    HISTORY_RECORD_T record;
+    uint16 packetMaxLen;
+    uint16 packetLen;
+    uint16 sequence;
+    
+    if(!historyNotification)
+    {
+        return;
+    }
+    
+    packetMaxLen = GetNotificationPayloadLen();
+    
+    while((syncSequence != nextSequence) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        packetLen = 0;
+        sequence = syncSequence;
+        
+        while((sequence != nextSequence) && ((packetLen + HISTORY_RECORD_LEN) <= packetMaxLen))
+        {
+            if(!FindRecord(sequence, &record))
+            {
+                /* Overwritten since the sync started */
+                sequence = GetOldestSequence();
+                continue;
+            }
+            
+            historyPacket[packetLen++] = LO8(record.sequence);
+            historyPacket[packetLen++] = HI8(record.sequence);
+            historyPacket[packetLen++] = LO8(record.timestamp);
+            historyPacket[packetLen++] = HI8(record.timestamp);
+            historyPacket[packetLen++] = LO8(record.rrInterval);
+            historyPacket[packetLen++] = HI8(record.rrInterval);
+            historyPacket[packetLen++] = record.heartRate;
+            historyPacket[packetLen++] = record.session;
+            sequence++;
+        }
+        
+        if(packetLen == 0)
+        {
+            syncSequence = sequence;
+            break;
+        }
+        
+        notificationHandle.attrHandle = HISTORY_CHAR_HANDLE;
+        notificationHandle.value.val = historyPacket;
+        notificationHandle.value.len = packetLen;
+        
+        if(CyBle_GattsNotification(cyBle_connHandle, &notificationHandle) != CYBLE_ERROR_OK)
+        {
+            break;
+        }
+        
+        syncSequence = sequence;
+        syncRecordCount += packetLen / HISTORY_RECORD_LEN;
+    }
+    
+    /* Backlog sent - note the throughput of this sync */
+    if(syncInProgress && (syncSequence == nextSequence))
+    {
+        historyStats.syncRecords = syncRecordCount;
+        historyStats.syncTimeMs = WatchdogTimer_GetTimestamp() - syncStartTime;
+        syncInProgress = false;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: HistoryLog_GetStats
+******************************************************************************
+* Summary:
+* Returns the flash write and sync counters.
+*
+* Parameters:
+* stats: Returns the counters
+*
+* Return:
+* None
+*
+* Theory:
+* Flash writes per hour follow from flashRowWrites and the time since reset.
+* The sync throughput is syncRecords * HISTORY_RECORD_LEN bytes in 
+* syncTimeMs.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HistoryLog_GetStats(HISTORY_LOG_STATS_T *stats)
+{
+    *stats = historyStats;
+}
+
+#endif  /* #if HISTORY_LOG */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/*****************************************************************************
+* File Name: HistoryLog.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the functions for the heart rate history log implemented
+* as part of the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_HISTORY_LOG_H)
+#define _HISTORY_LOG_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include "main.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Handles generated by the BLE component for the custom Heart Rate History 
+ * service. The service has one "History" characteristic with the Write and
+ * Notify properties and its Client Characteristic Configuration descriptor.
+ */
+#define HISTORY_CHAR_HANDLE                 (CYBLE_HEART_RATE_HISTORY_SERVICE_HISTORY_CHAR_HANDLE)
+#define HISTORY_CCC_HANDLE                  (CYBLE_HEART_RATE_HISTORY_SERVICE_HISTORY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+
+/* Length of the resume sequence number written to the History 
+ * characteristic */
+#define HISTORY_RESUME_LEN                  (2u)
+
+/* Size of one record in flash and in the sync notifications */
+#define HISTORY_RECORD_LEN                  (8u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+/* History record. Records are stored and sent as 8 little-endian bytes in 
+ * this field order.
+ */
+typedef struct
+{
+    uint16 sequence;        /* Record number, continues across resets */
+    uint16 timestamp;       /* Seconds since the session started */
+    uint16 rrInterval;      /* Last RR-interval, in 1/1024 second */
+    uint8 heartRate;        /* Heart rate in beats per minute */
+    uint8 session;          /* Incremented on every reset or wakeup */
+} HISTORY_RECORD_T;
+
+/* Counters for the flash wear and sync throughput */
+typedef struct
+{
+    uint32 flashRowWrites;  /* Flash rows programmed since reset */
+    uint32 syncRecords;     /* Records sent by the last completed sync */
+    uint32 syncTimeMs;      /* Duration of the last completed sync */
+} HISTORY_LOG_STATS_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+extern void HistoryLog_Start(void);
+extern void HistoryLog_Process(uint32 timestamp);
+extern void HistoryLog_Flush(void);
+extern void HistoryLog_FlushPending(void);
+extern void HistoryLog_SetNotification(bool enable);
+extern void HistoryLog_SetResumeSequence(uint16 sequence);
+extern void HistoryLog_SendPending(void);
+extern void HistoryLog_GetStats(HISTORY_LOG_STATS_T *stats);
+
+
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,185 @@
+/*****************************************************************************
+* File Name: HrBroadcast.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the connectionless heart rate broadcast in the PSoC 4
+* BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include "main.h"
+#include "HeartRateProcessing.h"
+#include "HrBroadcast.h"
+
+
+#if HR_BROADCAST
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Advertising interval in 0.625 ms units: 250 ms */
+#define HR_BROADCAST_ADV_INTERVAL           (400u)
+
+/* Byte offsets in the advertising data, see HrBroadcast.h */
+#define ADV_FLAGS_LEN_INDEX                 (0u)
+#define ADV_FLAGS_TYPE_INDEX                (1u)
+#define ADV_FLAGS_INDEX                     (2u)
+#define ADV_MANUFACTURER_LEN_INDEX          (3u)
+#define ADV_MANUFACTURER_TYPE_INDEX         (4u)
+#define ADV_COMPANY_ID_INDEX                (5u)
+#define ADV_FORMAT_INDEX                    (7u)
+#define ADV_SEQUENCE_INDEX                  (8u)
+#define ADV_HEART_RATE_INDEX                (9u)
+#define ADV_RR_COUNT_INDEX                  (10u)
+#define ADV_RR_INTERVAL_INDEX               (11u)
+#define ADV_DATA_LEN                        (13u)
+
+#define AD_TYPE_FLAGS                       (0x01u)
+#define AD_TYPE_MANUFACTURER_DATA           (0xFFu)
+#define AD_FLAG_BR_EDR_NOT_SUPPORTED        (0x04u)
+
+/* RR-intervals read from the queue per update, only counted */
+#define HR_BROADCAST_MAX_RR_INTERVALS       (8u)
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static uint8 broadcastSequence = 0;
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: HrBroadcast_Start
+******************************************************************************
+* Summary:
+* Starts non-connectable advertising with the heart rate broadcast data.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* The advertising parameters of the BLE component are replaced with 
+* non-connectable undirected advertising without timeout, so any number of 
+* displays can receive the heart rate without a connection. The 
+* advertising data is replaced with the layout in HrBroadcast.h.
+*
+* Side Effects:
+* The device cannot be connected to while broadcasting.
+*
+*****************************************************************************/
+void HrBroadcast_Start(void)
+{
+    uint8 *advData = cyBle_discoveryModeInfo.advData->advData;
+    
+    advData[ADV_FLAGS_LEN_INDEX] = 2u;
+    advData[ADV_FLAGS_TYPE_INDEX] = AD_TYPE_FLAGS;
+    advData[ADV_FLAGS_INDEX] = AD_FLAG_BR_EDR_NOT_SUPPORTED;
+    advData[ADV_MANUFACTURER_LEN_INDEX] = ADV_DATA_LEN - ADV_MANUFACTURER_TYPE_INDEX;
+    advData[ADV_MANUFACTURER_TYPE_INDEX] = AD_TYPE_MANUFACTURER_DATA;
+    advData[ADV_COMPANY_ID_INDEX] = LO8(HR_BROADCAST_COMPANY_ID);
+    advData[ADV_COMPANY_ID_INDEX + 1u] = HI8(HR_BROADCAST_COMPANY_ID);
+    advData[ADV_FORMAT_INDEX] = HR_BROADCAST_FORMAT;
+    advData[ADV_SEQUENCE_INDEX] = broadcastSequence;
+    advData[ADV_HEART_RATE_INDEX] = 0;
+    advData[ADV_RR_COUNT_INDEX] = 0;
+    advData[ADV_RR_INTERVAL_INDEX] = 0;
+    advData[ADV_RR_INTERVAL_INDEX + 1u] = 0;
+    cyBle_discoveryModeInfo.advData->advDataLen = ADV_DATA_LEN;
+    
+    cyBle_discoveryModeInfo.discMode = CYBLE_GAPP_NONE_DISC_BROADCAST_MODE;
+    cyBle_discoveryModeInfo.advParam->advType = CYBLE_GAPP_NON_CONNECTABLE_UNDIRECTED_ADV;
+    cyBle_discoveryModeInfo.advParam->advIntvMin = HR_BROADCAST_ADV_INTERVAL;
+    cyBle_discoveryModeInfo.advParam->advIntvMax = HR_BROADCAST_ADV_INTERVAL;
+    cyBle_discoveryModeInfo.advTo = 0;
+    
+    CyBle_GappEnterDiscoveryMode(&cyBle_discoveryModeInfo);
+}
+
+
+/*****************************************************************************
+* Function Name: HrBroadcast_Update
+******************************************************************************
+* Summary:
+* Updates the advertising data with the present heart rate.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+* Theory:
+* Called once per heart rate update instead of the HRS notification. The 
+* RR-intervals queued since the last update are counted and the last one 
+* is sent. The new data goes out from the next advertising event on.
+*
+* Side Effects:
+* None
+*
+*****************************************************************************/
+void HrBroadcast_Update(void)
+{
+    uint8 *advData = cyBle_discoveryModeInfo.advData->advData;
+    uint16 rrIntervals[HR_BROADCAST_MAX_RR_INTERVALS];
+    uint8 rrCount;
+    
+    rrCount = GetRrIntervals(rrIntervals, HR_BROADCAST_MAX_RR_INTERVALS);
+    broadcastSequence++;
+    
+    advData[ADV_SEQUENCE_INDEX] = broadcastSequence;
+    advData[ADV_HEART_RATE_INDEX] = heartRate;
+    advData[ADV_RR_COUNT_INDEX] = rrCount;
+    advData[ADV_RR_INTERVAL_INDEX] = LO8(lastRrInterval);
+    advData[ADV_RR_INTERVAL_INDEX + 1u] = HI8(lastRrInterval);
+    
+    CyBle_GapUpdateAdvData(cyBle_discoveryModeInfo.advData, cyBle_discoveryModeInfo.scanRspData);
+}
+
+#endif  /* #if HR_BROADCAST */
+
+
+/* [] END OF FILE */
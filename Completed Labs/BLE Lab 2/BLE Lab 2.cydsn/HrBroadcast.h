@@ -0,0 +1,84 @@
+/*****************************************************************************
+* File Name: HrBroadcast.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the functions for the heart rate broadcast mode
+* implemented as part of the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_HR_BROADCAST_H)
+#define _HR_BROADCAST_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include "main.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Advertising data sent in broadcast mode:
+ *
+ *  Offset  Length  Field
+ *  0       3       Flags AD structure: 0x02 0x01 0x04 (BR/EDR not supported)
+ *  3       1       Length of the manufacturer data AD structure (0x09)
+ *  4       1       AD type: manufacturer specific data (0xFF)
+ *  5       2       Company identifier, little-endian (0x0131, Cypress)
+ *  7       1       Payload format, HR_BROADCAST_FORMAT
+ *  8       1       Sequence number, incremented on every update
+ *  9       1       Heart rate in beats per minute
+ *  10      1       Number of RR-intervals measured since the last update
+ *  11      2       Last RR-interval in 1/1024 second, little-endian
+ *
+ * A listener detects a new update by a change of the sequence number, and
+ * a missed update by a step of more than one.
+ */
+#define HR_BROADCAST_COMPANY_ID             (0x0131u)
+#define HR_BROADCAST_FORMAT                 (0x01u)
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+extern void HrBroadcast_Start(void);
+extern void HrBroadcast_Update(void);
+
+
+#endif
+
+/* [] END OF FILE */
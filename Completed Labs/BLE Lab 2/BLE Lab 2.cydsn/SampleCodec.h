@@ -0,0 +1,85 @@
+/*****************************************************************************
+* File Name: SampleCodec.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the functions for the lossless sample compression
+* implemented as part of the PSoC 4 BLE Lab 3.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_SAMPLE_CODEC_H)
+#define _SAMPLE_CODEC_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Block layout, most significant bit first:
+ *   5 bits    sample count minus one
+ *   1 bit     predictor order (0 = first order, 1 = second order)
+ *   4 bits    Rice parameter k
+ *  16 bits    first sample, two's complement
+ * followed by one Rice code per remaining sample. Each prediction residual 
+ * is zigzag mapped to an unsigned value u and coded as (u >> k) one bits, a 
+ * zero bit and the k low bits of u. Quotients of 16 or more are escaped as 
+ * 16 one bits followed by u in 18 bits.
+ */
+#define SAMPLE_CODEC_MAX_BLOCK_LEN          (32u)
+#define SAMPLE_CODEC_HEADER_BITS            (26u)
+#define SAMPLE_CODEC_ESCAPE_QUOTIENT        (16u)
+#define SAMPLE_CODEC_ESCAPE_BITS            (18u)
+
+/* Worst case encoded block size in bytes */
+#define SAMPLE_CODEC_MAX_ENCODED_LEN        ((SAMPLE_CODEC_HEADER_BITS + \
+                                              (SAMPLE_CODEC_MAX_BLOCK_LEN - 1u) * \
+                                              (SAMPLE_CODEC_ESCAPE_QUOTIENT + SAMPLE_CODEC_ESCAPE_BITS) + \
+                                              7u) / 8u)
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+extern uint16 SampleCodec_EncodeBlock(const int16 *samples, uint8 count, uint8 *output, uint16 outputSize);
+extern uint8 SampleCodec_DecodeBlock(const uint8 *input, uint16 inputLen, int16 *samples, uint8 maxCount);
+
+
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,314 @@
+/*****************************************************************************
+* File Name: EventTraceBench.c
+*
+* Version: 1.0
+*
+* Description:
+* This file measures the cost of EVENT_TRACE_BLE_EVENT() per BLE event of the
+* BLE Lab 2, on a PC. The real EventTrace.c is built with the EVENT_TRACE
+* option on: -D_MAIN_H skips main.h so the options come from the command line.
+* Build with: gcc -O2 -I. -I"../BLE Lab 2.cydsn" -D_MAIN_H -DEVENT_TRACE=1
+* -DATT_MTU_TARGET=239 -o event_trace_bench EventTraceBench.c "../BLE Lab
+* 2.cydsn/EventTrace.c". Run ./event_trace_bench [events]. Each output line is
+* a JSON object for one event code, and the last for a mix of them, with the
+* time per event of a stand-in event handler with and without the trace and
+* the difference.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <project.h>
+#include "BleProcessing.h"
+#include "WatchdogTimer.h"
+#include "EventTrace.h"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define DEFAULT_EVENTS                      (10000000u)
+
+/* Each loop is timed this many times and the fastest run is kept */
+#define RUNS                                (5u)
+
+/* Event code of the mix */
+#define EVENT_MIX                           (0u)
+
+/* Event codes measured on their own, then the mix. Write requests take the 
+ * longest payload path, events without a payload the shortest. */
+static const uint32 benchEvents[] =
+{
+    CYBLE_EVT_GATTS_WRITE_REQ,
+    CYBLE_EVT_GAP_DEVICE_DISCONNECTED,
+    CYBLE_EVT_GATTS_XCNHG_MTU_REQ,
+    CYBLE_EVT_GATT_CONNECT_IND,
+    EVENT_MIX
+};
+
+/* Events of the mix, roughly as often as in a connection with ECG streaming */
+static const uint32 mixEvents[] =
+{
+    CYBLE_EVT_STACK_BUSY_STATUS,
+    CYBLE_EVT_STACK_BUSY_STATUS,
+    CYBLE_EVT_STACK_BUSY_STATUS,
+    CYBLE_EVT_STACK_BUSY_STATUS,
+    CYBLE_EVT_GATTS_WRITE_REQ,
+    CYBLE_EVT_GATTS_WRITE_CMD_REQ,
+    CYBLE_EVT_HRSS_NOTIFICATION_ENABLED,
+    CYBLE_EVT_GATT_CONNECT_IND
+};
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Stubs of the other modules and the BLE component
+*****************************************************************************/
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+static volatile uint32 timestamp;
+static volatile uint32 handledEvents;
+
+uint32 WatchdogTimer_GetTimestamp(void)
+{
+    return timestamp;
+}
+
+uint16 GetNotificationPayloadLen(void)
+{
+    return ATT_MTU_MAX - ATT_NOTIFICATION_HEADER_LEN;
+}
+
+uint8 CyBle_GattGetBusyStatus(void)
+{
+    return CYBLE_STACK_STATE_BUSY;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    (void)connHandle;
+    (void)ntfParam;
+    
+    return CYBLE_ERROR_OK;
+}
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: HandleEvent()
+******************************************************************************
+* Summary:
+* Stand-in for the switch of GeneralEventHandler(): counts the event. Kept
+* out of line so both loops make the same call.
+*
+*****************************************************************************/
+static void __attribute__((noinline)) HandleEvent(uint32 event, void *eventParam)
+{
+    switch(event)
+    {
+        case CYBLE_EVT_GATTS_WRITE_REQ:
+        case CYBLE_EVT_GATTS_WRITE_CMD_REQ:
+            handledEvents += ((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam)->handleValPair.value.len;
+            break;
+        
+        default:
+            handledEvents++;
+            break;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: ElapsedNs()
+******************************************************************************
+* Summary:
+* Returns the time between two clock readings in nanoseconds.
+*
+*****************************************************************************/
+static double ElapsedNs(const struct timespec *start, const struct timespec *end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+
+/*****************************************************************************
+* Function Name: TimeEvents()
+******************************************************************************
+* Summary:
+* Returns the fastest of RUNS runs over the events, in ns per event, with 
+* or without the trace.
+*
+*****************************************************************************/
+static double TimeEvents(const uint32 *events, void **eventParams, uint32 eventCount, uint8 trace)
+{
+    struct timespec start;
+    struct timespec end;
+    double bestNs = 0.0;
+    double ns;
+    uint32 run;
+    uint32 index;
+    
+    for(run = 0; run < RUNS; run++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        
+        if(trace)
+        {
+            for(index = 0; index < eventCount; index++)
+            {
+                EVENT_TRACE_BLE_EVENT(events[index], eventParams[index]);
+                HandleEvent(events[index], eventParams[index]);
+            }
+        }
+        else
+        {
+            for(index = 0; index < eventCount; index++)
+            {
+                HandleEvent(events[index], eventParams[index]);
+            }
+        }
+        
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns = ElapsedNs(&start, &end);
+        
+        if((run == 0u) || (ns < bestNs))
+        {
+            bestNs = ns;
+        }
+    }
+    
+    return bestNs / eventCount;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Times the events of each code, then the mix.
+*
+* Theory:
+* Each event gets the parameter type the stack passes with it, so the trace
+* reads its payload as on the device. The mix picks the events at random,
+* which costs the PC branch mispredictions a Cortex-M0 without a branch 
+* predictor does not have; the single code lines are closer to the device.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    CYBLE_GATTS_WRITE_REQ_PARAM_T writeParam;
+    CYBLE_GATT_XCHG_MTU_PARAM_T mtuParam;
+    uint8 reason = 0x13u;
+    uint8 value[CYBLE_GATT_DEFAULT_MTU];
+    uint32 eventCount = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : DEFAULT_EVENTS;
+    uint32 *events;
+    void **eventParams;
+    uint32 bench;
+    uint32 index;
+    double offNs;
+    double onNs;
+    
+    events = malloc(eventCount * sizeof(*events));
+    eventParams = malloc(eventCount * sizeof(*eventParams));
+    
+    if((eventCount == 0u) || (events == NULL) || (eventParams == NULL))
+    {
+        fprintf(stderr, "usage: %s [events, non-zero]\n", argv[0]);
+        return 1;
+    }
+    
+    writeParam.connHandle = cyBle_connHandle;
+    writeParam.handleValPair.attrHandle = EVENT_TRACE_CCC_HANDLE;
+    writeParam.handleValPair.value.val = value;
+    writeParam.handleValPair.value.len = 2u;
+    writeParam.handleValPair.value.actualLen = 2u;
+    mtuParam.connHandle = cyBle_connHandle;
+    mtuParam.mtu = ATT_MTU_MAX;
+    srand(1u);
+    
+    for(bench = 0; bench < COUNT_OF(benchEvents); bench++)
+    {
+        for(index = 0; index < eventCount; index++)
+        {
+            events[index] = (benchEvents[bench] == EVENT_MIX) ? 
+                            mixEvents[(uint32)rand() % COUNT_OF(mixEvents)] : benchEvents[bench];
+            
+            switch(events[index])
+            {
+                case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
+                case CYBLE_EVT_STACK_BUSY_STATUS:
+                    eventParams[index] = &reason;
+                    break;
+                
+                case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
+                    eventParams[index] = &mtuParam;
+                    break;
+                
+                default:
+                    eventParams[index] = &writeParam;
+                    break;
+            }
+        }
+        
+        offNs = TimeEvents(events, eventParams, eventCount, 0u);
+        onNs = TimeEvents(events, eventParams, eventCount, 1u);
+        
+        printf("{\"event\":\"%s\",\"events\":%u,\"ns_per_event_off\":%.2f,\"ns_per_event_on\":%.2f,"
+               "\"trace_ns_per_event\":%.2f}\n",
+               (benchEvents[bench] == EVENT_MIX) ? "mix" : 
+               (benchEvents[bench] == CYBLE_EVT_GATTS_WRITE_REQ) ? "gatts_write_req" :
+               (benchEvents[bench] == CYBLE_EVT_GAP_DEVICE_DISCONNECTED) ? "gap_device_disconnected" :
+               (benchEvents[bench] == CYBLE_EVT_GATTS_XCNHG_MTU_REQ) ? "gatts_xcnhg_mtu_req" : "gatt_connect_ind",
+               (unsigned)eventCount, offNs, onNs, onNs - offNs);
+    }
+    
+    free(events);
+    free(eventParams);
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,555 @@
+/*****************************************************************************
+* File Name: EventTraceDecoder.c
+*
+* Version: 1.0
+*
+* Description:
+* This file decodes the event trace dump of the EVENT_TRACE option of the BLE
+* Lab 2 and BLE Lab 3 into a timeline. Build with: gcc -O2 -o
+* event_trace_decoder EventTraceDecoder.c. Run ./event_trace_decoder [-e
+* header]... < dump.txt > timeline.csv, where each line of dump.txt is one
+* Event Trace notification in hex. The event codes are named from the
+* CYBLE_EVT_* enumerators of the BLE component headers generated for the
+* project in Generated_Source/PSoC4 (the ones that define CYBLE_EVT_STACK_ON
+* and the service events), given with -e; without them the codes are printed
+* in hex. Each output line has the timestamp, the time since the previous
+* record, the event and its payload.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+/* Size of one record in the dump, see EVENT_TRACE_RECORD_T in EventTrace.h */
+#define EVENT_TRACE_RECORD_LEN              (8u)
+
+#define PACKET_MAX_LEN                      (512u)
+#define LINE_MAX_LEN                        (4u * PACKET_MAX_LEN)
+#define NAME_MAX_LEN                        (64u)
+#define MAX_EVENT_NAMES                     (1024u)
+#define HEADER_MAX_LEN                      (1024u * 1024u)
+
+/* Meaning of the payload, see EventTrace_GetPayload() */
+static const struct
+{
+    const char *event;
+    const char *payload;
+} payloadNames[] = 
+{
+    { "CYBLE_EVT_GAP_DEVICE_DISCONNECTED",  "reason" },
+    { "CYBLE_EVT_STACK_BUSY_STATUS",        "busy" },
+    { "CYBLE_EVT_GATTS_WRITE_REQ",          "handle" },
+    { "CYBLE_EVT_GATTS_WRITE_CMD_REQ",      "handle" },
+    { "CYBLE_EVT_GATTS_XCNHG_MTU_REQ",      "mtu" },
+};
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    char name[NAME_MAX_LEN];
+    long value;
+} EVENT_NAME_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static EVENT_NAME_T eventNames[MAX_EVENT_NAMES];
+static unsigned eventNameCount = 0;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: FindEventName()
+******************************************************************************
+* Summary:
+* Returns the entry of an enumerator, or NULL if it is not known.
+*
+*****************************************************************************/
+static const EVENT_NAME_T *FindEventName(const char *name)
+{
+    unsigned index;
+    
+    for(index = 0; index < eventNameCount; index++)
+    {
+        if(strcmp(eventNames[index].name, name) == 0)
+        {
+            return &eventNames[index];
+        }
+    }
+    
+    return NULL;
+}
+
+
+/*****************************************************************************
+* Function Name: NameOfEvent()
+******************************************************************************
+* Summary:
+* Returns the name of a traced event code, or NULL. The trace keeps the 
+* lower 16 bits of the code.
+*
+*****************************************************************************/
+static const char *NameOfEvent(unsigned eventId)
+{
+    unsigned index;
+    
+    for(index = 0; index < eventNameCount; index++)
+    {
+        if(((unsigned long)eventNames[index].value & 0xFFFFu) == eventId)
+        {
+            return eventNames[index].name;
+        }
+    }
+    
+    return NULL;
+}
+
+
+/*****************************************************************************
+* Function Name: SkipSpace()
+******************************************************************************
+* Summary:
+* Skips white space and C comments.
+*
+*****************************************************************************/
+static const char *SkipSpace(const char *text)
+{
+    for(;;)
+    {
+        while(isspace((unsigned char)*text))
+        {
+            text++;
+        }
+        
+        if((text[0] == '/') && (text[1] == '*'))
+        {
+            text = strstr(text + 2, "*/");
+            text = (text != NULL) ? (text + 2) : "";
+        }
+        else if((text[0] == '/') && (text[1] == '/'))
+        {
+            text += strcspn(text, "\n");
+        }
+        else
+        {
+            return text;
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: ParseValue()
+******************************************************************************
+* Summary:
+* Parses the value of an enumerator: a number, or a known enumerator, 
+* optionally plus or minus a number, with the casts and parentheses that 
+* the generated headers use.
+*
+* Return:
+* int: 1 if the value was parsed
+*
+*****************************************************************************/
+static int ParseValue(const char **text, long *value)
+{
+    const EVENT_NAME_T *entry;
+    char name[NAME_MAX_LEN];
+    const char *cursor = SkipSpace(*text);
+    char *end;
+    long term;
+    size_t len;
+    int sign = 1;
+    
+    *value = 0;
+    
+    for(;;)
+    {
+        while((*cursor == '(') || (*cursor == ')'))
+        {
+            cursor = SkipSpace(cursor + 1);
+        }
+        
+        if(isdigit((unsigned char)*cursor))
+        {
+            term = strtol(cursor, &end, 0);
+            cursor = end;
+            
+            while((*cursor == 'u') || (*cursor == 'U') || (*cursor == 'l') || (*cursor == 'L'))
+            {
+                cursor++;
+            }
+        }
+        else if(isalpha((unsigned char)*cursor) || (*cursor == '_'))
+        {
+            len = 0;
+            
+            while((isalnum((unsigned char)cursor[len]) || (cursor[len] == '_')) && (len < (NAME_MAX_LEN - 1u)))
+            {
+                name[len] = cursor[len];
+                len++;
+            }
+            
+            name[len] = '\0';
+            cursor += len;
+            entry = FindEventName(name);
+            
+            /* Casts such as (uint32) are skipped */
+            if(entry == NULL)
+            {
+                if(*SkipSpace(cursor) == ')')
+                {
+                    continue;
+                }
+                
+                return 0;
+            }
+            
+            term = entry->value;
+        }
+        else
+        {
+            return 0;
+        }
+        
+        *value += sign * term;
+        cursor = SkipSpace(cursor);
+        
+        while(*cursor == ')')
+        {
+            cursor = SkipSpace(cursor + 1);
+        }
+        
+        if((*cursor == '+') || (*cursor == '-'))
+        {
+            sign = (*cursor == '+') ? 1 : -1;
+            cursor = SkipSpace(cursor + 1);
+        }
+        else
+        {
+            *text = cursor;
+            return 1;
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: LoadEventNames()
+******************************************************************************
+* Summary:
+* Reads the CYBLE_EVT_* enumerators of a C header.
+*
+* Theory:
+* Every enum body of the header is walked. An enumerator without a value is
+* one more than the previous one, or 0 at the start of the enum; only the
+* CYBLE_EVT_* ones are kept.
+*
+* Return:
+* int: 0 on success
+*
+*****************************************************************************/
+static int LoadEventNames(const char *path)
+{
+    static char header[HEADER_MAX_LEN];
+    char name[NAME_MAX_LEN];
+    const char *cursor;
+    FILE *file;
+    size_t len;
+    long value;
+    long next;
+    
+    file = fopen(path, "r");
+    
+    if(file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    
+    len = fread(header, 1, sizeof(header) - 1u, file);
+    fclose(file);
+    header[len] = '\0';
+    
+    for(cursor = strstr(header, "enum"); cursor != NULL; cursor = strstr(cursor, "enum"))
+    {
+        cursor = SkipSpace(cursor + 4);
+        
+        /* Skip the tag of the enum, if any */
+        while(isalnum((unsigned char)*cursor) || (*cursor == '_'))
+        {
+            cursor++;
+        }
+        
+        cursor = SkipSpace(cursor);
+        
+        if(*cursor != '{')
+        {
+            continue;
+        }
+        
+        cursor = SkipSpace(cursor + 1);
+        next = 0;
+        
+        while((*cursor != '}') && (*cursor != '\0'))
+        {
+            len = 0;
+            
+            while((isalnum((unsigned char)cursor[len]) || (cursor[len] == '_')) && (len < (NAME_MAX_LEN - 1u)))
+            {
+                name[len] = cursor[len];
+                len++;
+            }
+            
+            if(len == 0u)
+            {
+                break;
+            }
+            
+            name[len] = '\0';
+            cursor = SkipSpace(cursor + len);
+            value = next;
+            
+            if(*cursor == '=')
+            {
+                cursor++;
+                
+                if(!ParseValue(&cursor, &value))
+                {
+                    /* Not an expression this decoder understands: skip to 
+                     * the next enumerator, whose value is then unknown */
+                    cursor += strcspn(cursor, ",}");
+                    value = -1;
+                }
+            }
+            
+            if((value >= 0) && (strncmp(name, "CYBLE_EVT_", 10) == 0) && 
+               (FindEventName(name) == NULL) && (eventNameCount < MAX_EVENT_NAMES))
+            {
+                strcpy(eventNames[eventNameCount].name, name);
+                eventNames[eventNameCount].value = value;
+                eventNameCount++;
+            }
+            
+            next = (value >= 0) ? (value + 1) : -1;
+            cursor = SkipSpace(cursor);
+            
+            if(*cursor == ',')
+            {
+                cursor = SkipSpace(cursor + 1);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+/*****************************************************************************
+* Function Name: ParseHexLine()
+******************************************************************************
+* Summary:
+* Converts a line of hex bytes, with or without separators, to bytes.
+*
+* Return:
+* int: Number of bytes, or -1 if the line is not hex
+*
+*****************************************************************************/
+static int ParseHexLine(const char *line, uint8_t *data, int maxLen)
+{
+    int len = 0;
+    int digits = 0;
+    int value = 0;
+    
+    for(; *line != '\0'; line++)
+    {
+        if(isxdigit((unsigned char)*line))
+        {
+            value = (value << 4) | (isdigit((unsigned char)*line) ? (*line - '0') : 
+                                    ((tolower((unsigned char)*line) - 'a') + 10));
+            
+            if(++digits == 2)
+            {
+                if(len == maxLen)
+                {
+                    return -1;
+                }
+                
+                data[len++] = (uint8_t)value;
+                digits = 0;
+                value = 0;
+            }
+        }
+        else if((*line == 'x') && (digits == 1) && (value == 0))
+        {
+            /* 0x prefix */
+            digits = 0;
+        }
+        else if(!isspace((unsigned char)*line) && (*line != ':') && (*line != ',') && (*line != '-'))
+        {
+            return -1;
+        }
+    }
+    
+    return (digits == 0) ? len : -1;
+}
+
+
+/*****************************************************************************
+* Function Name: PayloadName()
+******************************************************************************
+* Summary:
+* Returns what the payload of an event means, or "payload".
+*
+*****************************************************************************/
+static const char *PayloadName(const char *event)
+{
+    unsigned index;
+    
+    for(index = 0; (event != NULL) && (index < COUNT_OF(payloadNames)); index++)
+    {
+        if(strcmp(payloadNames[index].event, event) == 0)
+        {
+            return payloadNames[index].payload;
+        }
+    }
+    
+    return "payload";
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Decodes the dump on stdin to a CSV timeline on stdout.
+*
+* Theory:
+* A dump sends the records oldest first, so a timestamp that goes back 
+* starts the next dump. Records overwritten during a dump are skipped by 
+* the device and show as a longer delta.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    char line[LINE_MAX_LEN];
+    uint8_t packet[PACKET_MAX_LEN];
+    const uint8_t *record;
+    const char *event;
+    unsigned long timestamp;
+    unsigned long previous = 0;
+    unsigned lineNumber = 0;
+    unsigned dump = 0;
+    unsigned eventId;
+    unsigned payload;
+    int argIndex;
+    int len;
+    int offset;
+    
+    for(argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if((strcmp(argv[argIndex], "-e") == 0) && ((argIndex + 1) < argc))
+        {
+            if(LoadEventNames(argv[++argIndex]) != 0)
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-e header]... < dump.txt\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    printf("dump,timestamp_ms,delta_ms,event_id,event,payload_name,payload\n");
+    
+    while(fgets(line, sizeof(line), stdin) != NULL)
+    {
+        lineNumber++;
+        len = ParseHexLine(line, packet, sizeof(packet));
+        
+        if((len < 0) || ((len % EVENT_TRACE_RECORD_LEN) != 0))
+        {
+            fprintf(stderr, "line %u: not a dump packet\n", lineNumber);
+            return 1;
+        }
+        
+        for(offset = 0; offset < len; offset += EVENT_TRACE_RECORD_LEN)
+        {
+            record = &packet[offset];
+            timestamp = (unsigned long)record[0] | ((unsigned long)record[1] << 8) | 
+                        ((unsigned long)record[2] << 16) | ((unsigned long)record[3] << 24);
+            eventId = (unsigned)record[4] | ((unsigned)record[5] << 8);
+            payload = (unsigned)record[6] | ((unsigned)record[7] << 8);
+            
+            if((dump == 0u) || (timestamp < previous))
+            {
+                dump++;
+                previous = timestamp;
+            }
+            
+            event = NameOfEvent(eventId);
+            printf("%u,%lu,%lu,0x%04X,%s,%s,%u\n", dump, timestamp, timestamp - previous, eventId, 
+                   (event != NULL) ? event : "", PayloadName(event), payload);
+            previous = timestamp;
+        }
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,801 @@
+/*****************************************************************************
+* File Name: HrBenchmark.c
+*
+* Version: 1.0
+*
+* Description:
+* This file runs the heart rate detector of the BLE Lab 2 on a PC against the
+* ECG of the HRM simulator, and reports how well it measures. The real
+* ProcessHeartRateSignal() and SendHeartRateOverBLE() run with the ADC,
+* watchdog timestamp and BLE notification stubbed out here, and the ADC reads
+* the output of the simulator's EcgGenerator through a model of its PWM DAC
+* and RC low pass. Build and run with: unzip -jo
+* "../../../Supporting Files/Lab2_PRoC_BLE_HRM_Simulator Project.zip"
+* "*.cydsn/EcgGenerator.*" -d ecg; gcc -O2 -DECG_HOST_BUILD -I. -Iecg
+* -I"../BLE Lab 2.cydsn" -o hr_benchmark HrBenchmark.c "../BLE Lab
+* 2.cydsn/HeartRateProcessing.c" "../BLE Lab 2.cydsn/BleProcessing.c"
+* ecg/EcgGenerator.c -lm; ./hr_benchmark [seconds] [seed] > report.jsonl.
+* Each line of the report is a JSON object with the results of one case of
+* the sweep (heart rate, noise, sample period); the last line sums up every
+* case.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <project.h>
+#include "HeartRateProcessing.h"
+#include "BleProcessing.h"
+#include "EcgGenerator.h"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define DEFAULT_SECONDS                     (60u)
+#define DEFAULT_SEED                        (1u)
+
+/* The device sends a notification every second */
+#define NOTIFICATION_PERIOD_MS              (1000u)
+
+/* A detection within this time of an R peak is a true positive */
+#define MATCH_WINDOW_MS                     (150.0)
+
+/* PWM DAC of the simulator, as in its main.c: TCPWM_4 counts 250 cycles of
+ * a 1 MHz clock, a 4 kHz carrier, and duty cycles 0 and 100% stand for 
+ * -500 and 1500 uV. The pin swings between 0 and the simulator's VDDD, 
+ * 3.3 V on the Pioneer kit, into a 10 kOhm, 100 nF low pass. */
+#define DAC_PERIOD                          (250)
+#define DAC_MIN_UV                          (-500)
+#define DAC_MAX_UV                          (1500)
+#define DAC_CARRIER_MS                      (0.25)
+#define DAC_VDDD_MV                         (3300.0)
+#define DAC_RC_MS                           (1.0)
+
+/* ADC of the lab, as set up in the Lab 2 manual: the opamp follower feeds
+ * a single ended 12-bit channel against Vss, with the internal 1.024 V 
+ * reference, so 0 to 1.024 V reads as 0 to 2047 */
+#define ADC_VREF_MV                         (1024.0)
+#define ADC_FULL_SCALE                      (2048.0)
+#define ADC_MAX                             (2047)
+#define ADC_MIN                             (0)
+
+/* The two give, before the ripple and lag of the RC, ADC counts at 0 uV 
+ * and ADC counts per uV of the ECG: 1650 counts and 3.3 counts per uV. 
+ * This puts the 0x06A0 threshold of the detector at 14 uV, and the ADC
+ * saturates at 120 uV, far below the 1143 uV R wave of the simulator. */
+#define ADC_COUNTS_PER_MV                   (ADC_FULL_SCALE / ADC_VREF_MV)
+#define ADC_COUNTS_PER_UV                   ((DAC_VDDD_MV * ADC_COUNTS_PER_MV) / (DAC_MAX_UV - DAC_MIN_UV))
+#define ADC_OFFSET                          (-DAC_MIN_UV * ADC_COUNTS_PER_UV)
+
+/* Heart rate variability of the simulated ECG: respiratory modulation and
+ * beat to beat jitter of the RR-interval, in ms */
+#define HRV_RESPIRATION_MS                  (25u)
+#define HRV_JITTER_MS                       (15u)
+
+/* The simulator updates its DAC once per ECG sample */
+#define ECG_SAMPLE_PERIOD_MS                (1000u / ECG_SAMPLE_RATE_HZ)
+
+/* The shortest RR-interval of the simulator is 200 ms */
+#define MAX_BEATS_PER_SECOND                (5u)
+
+/* Depth of the RR-interval queue in HeartRateProcessing.c */
+#define RR_QUEUE_SIZE                       (8u)
+
+#define HRM_FLAG_RR_INTERVAL_PRESENT        (0x10u)
+
+/* Sweep: the heart rates of HRM_Array in the HRM simulator, then 30 to 
+ * 165 bpm in 15 bpm steps. The simulator does not start a beat within the
+ * wave of the last one, 600 ms times the square root of the RR-interval in
+ * s, so faster rates come out slow: 180 bpm gives 174 and 240 bpm 202. 
+ * Every case also reports the heart rate of the ECG it got. */
+static const uint8 sweepBpm[] = 
+{
+    120u, 110u, 100u, 90u, 80u, 70u, 60u
+};
+#define SWEEP_BPM_MIN                       (30u)
+#define SWEEP_BPM_MAX                       (165u)
+#define SWEEP_BPM_STEP                      (15u)
+
+/* White noise of the simulated ECG, uniform in +/- the amplitude */
+static const uint16 sweepNoiseUv[] = { 0u, 50u, 100u, 200u };
+static const uint32 sweepSamplePeriodMs[] = { 5u, 10u, 20u };
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint8 bpm;
+    uint16 noiseUv;
+    uint32 samplePeriodMs;
+    uint32 seconds;
+    uint32 seed;
+} BENCH_CASE_T;
+
+typedef struct
+{
+    uint32 beats;               /* R peaks in the ECG */
+    uint32 detections;          /* Beats seen by the detector */
+    uint32 truePositives;       /* Detections matched to an R peak */
+    uint32 notifications;       /* Notifications sent */
+    uint32 bpmErrorCount;       /* Notifications compared to the ECG */
+    double bpmErrorSum;         /* Sum of |notified - true| in bpm */
+    double bpmErrorMax;
+    uint32 latencyCount;        /* RR-intervals notified from a true beat */
+    double latencySumMs;        /* Sum of R peak to notification times */
+    double latencyMaxMs;
+    uint32 droppedRr;           /* RR-intervals dropped by a full queue */
+    double ecgBpm;              /* Mean heart rate of the generated ECG */
+    double hostNsPerSecond;     /* Host time in the device code per ECG s */
+} BENCH_RESULT_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+
+/* ECG of the running case as the simulator outputs it, one sample per 
+ * ECG_SAMPLE_PERIOD_MS: the compare value of the PWM DAC and the output of
+ * the RC at the end of the sample, in mV; and its R peaks */
+static uint16 *dacCompare;
+static double *rcEndMv;
+static uint32 ecgSampleCount;
+static double *beatTimeMs;
+static double *beatRrMs;
+static uint32 beatCount;
+
+/* R peaks already matched to a detection */
+static uint8 *beatMatched;
+static uint32 firstUnmatchedBeat;
+
+/* Simulated time of the sample the device reads next */
+static uint32 nowMs;
+
+/* Random state of the phase of the ADC reads to the PWM carrier. The 
+ * watchdog of the lab and the carrier of the simulator run from unrelated
+ * clocks. */
+static uint32 carrierPhaseRandom;
+
+/* R peak of each RR-interval queued by the detector, or -1 if it came from
+ * a false detection, mirroring the queue of HeartRateProcessing.c */
+static int32 rrFifo[RR_QUEUE_SIZE];
+static uint32 rrFifoHead;
+static uint32 rrFifoTail;
+
+static BENCH_RESULT_T result;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: GenerateEcg()
+******************************************************************************
+* Summary:
+* Runs the EcgGenerator of the HRM simulator for the length of the case and 
+* records its samples and R peaks. The case is one endless segment at the 
+* heart rate and noise of the case, without baseline wander or artifacts.
+* The heart rate of each beat is taken from the RR-interval that ends at 
+* its R peak, since the simulator stretches RR-intervals shorter than the 
+* wave of a beat. Each sample goes through EcgToCompare() of the simulator
+* and the RC low pass, which settles exponentially to each duty cycle.
+*
+* Return:
+* int: 0 on success, -1 if out of memory
+*
+*****************************************************************************/
+static int GenerateEcg(const BENCH_CASE_T *benchCase)
+{
+    ECG_GENERATOR_T generator;
+    ECG_SEGMENT_T segment;
+    ECG_SCENARIO_T scenario;
+    uint32 maxBeats = (benchCase->seconds * MAX_BEATS_PER_SECOND) + 1u;
+    uint32 sample;
+    int32 compare;
+    double levelMv;
+    double previousMv;
+    
+    memset(&segment, 0, sizeof(segment));
+    segment.durationS = 0u;
+    segment.startBpm = benchCase->bpm;
+    segment.endBpm = benchCase->bpm;
+    segment.hrvMs = HRV_RESPIRATION_MS;
+    segment.jitterMs = HRV_JITTER_MS;
+    segment.noiseUv = benchCase->noiseUv;
+    
+    scenario.segments = &segment;
+    scenario.segmentCount = 1u;
+    scenario.loop = 0u;
+    
+    ecgSampleCount = benchCase->seconds * ECG_SAMPLE_RATE_HZ;
+    dacCompare = malloc(ecgSampleCount * sizeof(*dacCompare));
+    rcEndMv = malloc(ecgSampleCount * sizeof(*rcEndMv));
+    beatTimeMs = malloc(maxBeats * sizeof(*beatTimeMs));
+    beatRrMs = malloc(maxBeats * sizeof(*beatRrMs));
+    beatMatched = calloc(maxBeats, sizeof(*beatMatched));
+    
+    if((dacCompare == NULL) || (rcEndMv == NULL) || (beatTimeMs == NULL) || (beatRrMs == NULL) || (beatMatched == NULL))
+    {
+        return -1;
+    }
+    
+    EcgGenerator_Init(&generator, &scenario, benchCase->seed);
+    beatCount = 0;
+    
+    for(sample = 0; sample < ecgSampleCount; sample++)
+    {
+        /* EcgToCompare() of the simulator */
+        compare = (((int32)EcgGenerator_NextSample(&generator) - DAC_MIN_UV) * DAC_PERIOD) / 
+                  (DAC_MAX_UV - DAC_MIN_UV);
+        compare = (compare < 0) ? 0 : ((compare > DAC_PERIOD) ? DAC_PERIOD : compare);
+        dacCompare[sample] = (uint16)compare;
+        
+        levelMv = (DAC_VDDD_MV * compare) / DAC_PERIOD;
+        previousMv = (sample == 0) ? levelMv : rcEndMv[sample - 1];
+        rcEndMv[sample] = levelMv + ((previousMv - levelMv) * exp(-(double)ECG_SAMPLE_PERIOD_MS / DAC_RC_MS));
+        
+        if(EcgGenerator_IsRPeak(&generator) && (beatCount < maxBeats))
+        {
+            beatTimeMs[beatCount] = (double)(sample * ECG_SAMPLE_PERIOD_MS);
+            beatRrMs[beatCount] = (beatCount == 0) ? (60000.0 / EcgGenerator_GetBpm(&generator)) : 
+                (beatTimeMs[beatCount] - beatTimeMs[beatCount - 1]);
+            beatCount++;
+        }
+    }
+    
+    if(beatCount >= 2)
+    {
+        result.ecgBpm = (60000.0 * (beatCount - 1u)) / (beatTimeMs[beatCount - 1u] - beatTimeMs[0]);
+    }
+    
+    return 0;
+}
+
+
+/*****************************************************************************
+* Function Name: TrueBpmAt()
+******************************************************************************
+* Summary:
+* Returns the heart rate of the last complete RR-interval before a time, or
+* 0 if there is none yet.
+*
+*****************************************************************************/
+static double TrueBpmAt(double time)
+{
+    uint32 beat = 1;
+    
+    while((beat < beatCount) && (beatTimeMs[beat] <= time))
+    {
+        beat++;
+    }
+    
+    return (beat >= 2) ? (60000.0 / beatRrMs[beat - 1]) : 0.0;
+}
+
+
+/*****************************************************************************
+* Function Name: MatchedBeat()
+******************************************************************************
+* Summary:
+* Returns the R peak that a detection at a time belongs to, or -1 for a 
+* false detection. Each R peak is matched to one detection only, the first.
+*
+*****************************************************************************/
+static int32 MatchedBeat(double time)
+{
+    int32 best = -1;
+    uint32 beat;
+    
+    while((firstUnmatchedBeat < beatCount) && (beatTimeMs[firstUnmatchedBeat] < (time - MATCH_WINDOW_MS)))
+    {
+        firstUnmatchedBeat++;
+    }
+    
+    for(beat = firstUnmatchedBeat; (beat < beatCount) && (beatTimeMs[beat] <= (time + MATCH_WINDOW_MS)); beat++)
+    {
+        if(!beatMatched[beat] && 
+           ((best < 0) || (fabs(beatTimeMs[beat] - time) < fabs(beatTimeMs[best] - time))))
+        {
+            best = (int32)beat;
+        }
+    }
+    
+    if(best >= 0)
+    {
+        beatMatched[best] = 1;
+    }
+    
+    return best;
+}
+
+
+/*****************************************************************************
+* Function Name: ElapsedNs()
+******************************************************************************
+* Summary:
+* Returns the time between two clock readings in nanoseconds.
+*
+*****************************************************************************/
+static double ElapsedNs(const struct timespec *start, const struct timespec *end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+
+/*****************************************************************************
+* Function Name: RunCase()
+******************************************************************************
+* Summary:
+* Runs the detector over one case, the way the main loop of the lab does, 
+* and scores it.
+*
+* Theory:
+* The main loop calls ProcessHeartRateSignal() on every watchdog interrupt,
+* so the ADC is sampled once per sample period, and SendHeartRateOverBLE() 
+* once a second. The stubs below feed the ECG to the ADC, match each 
+* detection to an R peak and score each notification. The ECG is generated
+* before the clock starts, so the time spent in the two functions is the 
+* device code and the stubs only. It is measured on the host, not on the
+* device.
+*
+* Return:
+* int: 0 on success, -1 if out of memory
+*
+*****************************************************************************/
+static int RunCase(const BENCH_CASE_T *benchCase)
+{
+    struct timespec start;
+    struct timespec end;
+    uint32 previousNotification = 0;
+    double hostNs;
+    
+    memset(&result, 0, sizeof(result));
+    firstUnmatchedBeat = 0;
+    rrFifoHead = 0;
+    rrFifoTail = 0;
+    carrierPhaseRandom = benchCase->seed;
+    
+    if(GenerateEcg(benchCase) != 0)
+    {
+        return -1;
+    }
+    
+    result.beats = beatCount;
+    
+    HrsEventHandler(CYBLE_EVT_HRSS_NOTIFICATION_ENABLED, NULL);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    for(nowMs = 0; nowMs < (benchCase->seconds * 1000u); nowMs += benchCase->samplePeriodMs)
+    {
+        ProcessHeartRateSignal();
+        
+        if((nowMs - previousNotification) >= NOTIFICATION_PERIOD_MS)
+        {
+            SendHeartRateOverBLE();
+            previousNotification = nowMs;
+        }
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    hostNs = ElapsedNs(&start, &end);
+    
+    result.hostNsPerSecond = hostNs / benchCase->seconds;
+    
+    return 0;
+}
+
+
+/*****************************************************************************
+* Function Name: RunCaseInChild()
+******************************************************************************
+* Summary:
+* Runs a case in a new process and returns its result. The heart rate code
+* keeps its state in static variables, so every case needs a fresh copy.
+*
+* Return:
+* int: 0 on success, -1 if the case could not be run
+*
+*****************************************************************************/
+static int RunCaseInChild(const BENCH_CASE_T *benchCase, BENCH_RESULT_T *caseResult)
+{
+    int pipeFd[2];
+    pid_t pid;
+    ssize_t length;
+    int status;
+    
+    if(pipe(pipeFd) != 0)
+    {
+        return -1;
+    }
+    
+    pid = fork();
+    
+    if(pid < 0)
+    {
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+        return -1;
+    }
+    
+    if(pid == 0)
+    {
+        close(pipeFd[0]);
+        if(RunCase(benchCase) != 0)
+        {
+            _exit(1);
+        }
+        
+        length = write(pipeFd[1], &result, sizeof(result));
+        _exit((length == (ssize_t)sizeof(result)) ? 0 : 1);
+    }
+    
+    close(pipeFd[1]);
+    length = read(pipeFd[0], caseResult, sizeof(*caseResult));
+    close(pipeFd[0]);
+    waitpid(pid, &status, 0);
+    
+    return ((length == (ssize_t)sizeof(*caseResult)) && WIFEXITED(status) && (WEXITSTATUS(status) == 0)) ? 0 : -1;
+}
+
+
+/*****************************************************************************
+* Function Name: PrintResult()
+******************************************************************************
+* Summary:
+* Prints the result of a case, or of the whole sweep, as one JSON line.
+* Sensitivity is the share of R peaks detected, PPV the share of detections
+* that are R peaks. The heart rate of a case is the one it asks the 
+* simulator for, ecg_bpm the mean of the RR-intervals it got.
+*
+*****************************************************************************/
+static void PrintResult(const char *name, const BENCH_CASE_T *benchCase, const BENCH_RESULT_T *caseResult, 
+                        uint32 cases)
+{
+    printf("{\"%s\":", name);
+    
+    if(benchCase != NULL)
+    {
+        printf("{\"bpm\":%u,\"ecg_bpm\":%.1f,\"noise_uv\":%u,\"sample_period_ms\":%u,\"seconds\":%u},", 
+               (unsigned)benchCase->bpm, caseResult->ecgBpm, (unsigned)benchCase->noiseUv, 
+               (unsigned)benchCase->samplePeriodMs, (unsigned)benchCase->seconds);
+    }
+    else
+    {
+        printf("%u,", (unsigned)cases);
+    }
+    
+    printf("\"beats\":%u,\"detections\":%u,\"true_positives\":%u,\"sensitivity\":%.4f,\"ppv\":%.4f,"
+           "\"notifications\":%u,\"bpm_mae\":%.2f,\"bpm_max_error\":%.1f,"
+           "\"latency_mean_ms\":%.1f,\"latency_max_ms\":%.1f,\"rr_dropped\":%u,"
+           "\"host_ns_per_s\":%.0f}\n",
+           (unsigned)caseResult->beats, (unsigned)caseResult->detections, (unsigned)caseResult->truePositives,
+           (caseResult->beats != 0) ? ((double)caseResult->truePositives / caseResult->beats) : 0.0,
+           (caseResult->detections != 0) ? ((double)caseResult->truePositives / caseResult->detections) : 0.0,
+           (unsigned)caseResult->notifications,
+           (caseResult->bpmErrorCount != 0) ? (caseResult->bpmErrorSum / caseResult->bpmErrorCount) : 0.0,
+           caseResult->bpmErrorMax,
+           (caseResult->latencyCount != 0) ? (caseResult->latencySumMs / caseResult->latencyCount) : 0.0,
+           caseResult->latencyMaxMs, (unsigned)caseResult->droppedRr, 
+           caseResult->hostNsPerSecond / ((cases != 0) ? cases : 1u));
+}
+
+
+/*****************************************************************************
+* Function Name: AddResult()
+******************************************************************************
+* Summary:
+* Adds the result of a case to the total of the sweep.
+*
+*****************************************************************************/
+static void AddResult(BENCH_RESULT_T *total, const BENCH_RESULT_T *caseResult)
+{
+    total->beats += caseResult->beats;
+    total->detections += caseResult->detections;
+    total->truePositives += caseResult->truePositives;
+    total->notifications += caseResult->notifications;
+    total->bpmErrorCount += caseResult->bpmErrorCount;
+    total->bpmErrorSum += caseResult->bpmErrorSum;
+    total->latencyCount += caseResult->latencyCount;
+    total->latencySumMs += caseResult->latencySumMs;
+    total->droppedRr += caseResult->droppedRr;
+    total->hostNsPerSecond += caseResult->hostNsPerSecond;
+    
+    if(caseResult->bpmErrorMax > total->bpmErrorMax)
+    {
+        total->bpmErrorMax = caseResult->bpmErrorMax;
+    }
+    
+    if(caseResult->latencyMaxMs > total->latencyMaxMs)
+    {
+        total->latencyMaxMs = caseResult->latencyMaxMs;
+    }
+}
+
+
+/*****************************************************************************
+* Stubs of the PSoC components
+*****************************************************************************/
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+void ADC_StartConvert(void)
+{
+}
+
+uint32 ADC_IsEndConversion(uint32 retMode)
+{
+    (void)retMode;
+    return 1u;
+}
+
+/* The ADC reads the RC output of the simulator DAC, which holds each ECG 
+ * sample for ECG_SAMPLE_PERIOD_MS. The RC settles towards the duty cycle
+ * of the sample and carries the carrier ripple, a triangle of 
+ * VDDD * d * (1 - d) * T / RC peak to peak for duty cycle d and carrier 
+ * period T, read at a random phase. */
+int16 ADC_GetResult16(uint32 chan)
+{
+    uint32 sample = nowMs / ECG_SAMPLE_PERIOD_MS;
+    double elapsedMs = (double)(nowMs - (sample * ECG_SAMPLE_PERIOD_MS));
+    double duty;
+    double levelMv;
+    double startMv;
+    double rippleMv;
+    double phase;
+    double counts;
+    
+    (void)chan;
+    
+    if(sample >= ecgSampleCount)
+    {
+        sample = 0;
+    }
+    
+    duty = (double)dacCompare[sample] / DAC_PERIOD;
+    levelMv = DAC_VDDD_MV * duty;
+    startMv = (sample == 0) ? levelMv : rcEndMv[sample - 1u];
+    levelMv += (startMv - levelMv) * exp(-elapsedMs / DAC_RC_MS);
+    
+    carrierPhaseRandom = (carrierPhaseRandom * 1664525u) + 1013904223u;
+    phase = (double)(carrierPhaseRandom >> 8) / 16777216.0;
+    rippleMv = DAC_VDDD_MV * duty * (1.0 - duty) * DAC_CARRIER_MS / DAC_RC_MS;
+    
+    if((duty > 0.0) && (duty < 1.0))
+    {
+        levelMv += rippleMv * (((phase < duty) ? (phase / duty) : ((1.0 - phase) / (1.0 - duty))) - 0.5);
+    }
+    
+    counts = levelMv * ADC_COUNTS_PER_MV;
+    
+    if(counts > ADC_MAX)
+    {
+        counts = ADC_MAX;
+    }
+    else if(counts < ADC_MIN)
+    {
+        counts = ADC_MIN;
+    }
+    
+    return (int16)counts;
+}
+
+/* ProcessHeartRateSignal() reads the timestamp on each detected beat only,
+ * and queues an RR-interval for every beat but the first. */
+uint32 WatchdogTimer_GetTimestamp(void)
+{
+    int32 beat = MatchedBeat((double)nowMs);
+    
+    if(beat >= 0)
+    {
+        result.truePositives++;
+    }
+    
+    if(result.detections != 0)
+    {
+        rrFifo[rrFifoHead % RR_QUEUE_SIZE] = beat;
+        rrFifoHead++;
+        
+        if((rrFifoHead - rrFifoTail) > RR_QUEUE_SIZE)
+        {
+            rrFifoTail++;
+            result.droppedRr++;
+        }
+    }
+    
+    result.detections++;
+    
+    return nowMs;
+}
+
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize, 
+                                                    uint8 *attrValue)
+{
+    (void)charIndex;
+    memset(attrValue, 0, attrSize);
+    return CYBLE_ERROR_OK;
+}
+
+/* Scores a notification: its heart rate against the ECG, and the latency of
+ * each RR-interval it carries from the R peak that ended it */
+CYBLE_API_RESULT_T CyBle_HrssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_HRS_CHAR_INDEX_T charIndex, 
+                                              uint8 attrSize, uint8 *attrValue)
+{
+    double trueBpm = TrueBpmAt((double)nowMs);
+    double error;
+    uint32 rrCount = 0;
+    int32 beat;
+    
+    (void)connHandle;
+    (void)charIndex;
+    
+    result.notifications++;
+    
+    if((trueBpm != 0.0) && (attrValue[1] != 0))
+    {
+        error = fabs((double)attrValue[1] - trueBpm);
+        result.bpmErrorSum += error;
+        result.bpmErrorCount++;
+        
+        if(error > result.bpmErrorMax)
+        {
+            result.bpmErrorMax = error;
+        }
+    }
+    
+    if((attrValue[0] & HRM_FLAG_RR_INTERVAL_PRESENT) != 0)
+    {
+        rrCount = (attrSize - 2u) / 2u;
+    }
+    
+    while((rrCount-- != 0) && (rrFifoTail != rrFifoHead))
+    {
+        beat = rrFifo[rrFifoTail % RR_QUEUE_SIZE];
+        rrFifoTail++;
+        
+        if(beat >= 0)
+        {
+            result.latencySumMs += (double)nowMs - beatTimeMs[beat];
+            result.latencyCount++;
+            
+            if(((double)nowMs - beatTimeMs[beat]) > result.latencyMaxMs)
+            {
+                result.latencyMaxMs = (double)nowMs - beatTimeMs[beat];
+            }
+        }
+    }
+    
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_STATE_T CyBle_GetState(void)
+{
+    return CYBLE_STATE_CONNECTED;
+}
+
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType)
+{
+    (void)advertisingIntervalType;
+    return CYBLE_ERROR_OK;
+}
+
+void Led_Advertising_Green_Write(uint8 value)
+{
+    (void)value;
+}
+
+void Led_Connected_Blue_Write(uint8 value)
+{
+    (void)value;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Runs every case of the sweep and prints the report.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    BENCH_CASE_T benchCase;
+    BENCH_RESULT_T caseResult;
+    BENCH_RESULT_T total;
+    uint32 rateCount = COUNT_OF(sweepBpm) + ((SWEEP_BPM_MAX - SWEEP_BPM_MIN) / SWEEP_BPM_STEP) + 1u;
+    uint32 cases = 0;
+    uint32 rate;
+    uint32 noise;
+    uint32 period;
+    
+    memset(&total, 0, sizeof(total));
+    benchCase.seconds = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : DEFAULT_SECONDS;
+    benchCase.seed = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : DEFAULT_SEED;
+    
+    if(benchCase.seconds == 0)
+    {
+        fprintf(stderr, "usage: %s [seconds] [seed], seconds non-zero\n", argv[0]);
+        return 1;
+    }
+    
+    for(rate = 0; rate < rateCount; rate++)
+    {
+        benchCase.bpm = (rate < COUNT_OF(sweepBpm)) ? sweepBpm[rate] : 
+            (uint8)(SWEEP_BPM_MIN + ((rate - COUNT_OF(sweepBpm)) * SWEEP_BPM_STEP));
+        
+        for(noise = 0; noise < COUNT_OF(sweepNoiseUv); noise++)
+        {
+            benchCase.noiseUv = sweepNoiseUv[noise];
+            
+            for(period = 0; period < COUNT_OF(sweepSamplePeriodMs); period++)
+            {
+                benchCase.samplePeriodMs = sweepSamplePeriodMs[period];
+                
+                if(RunCaseInChild(&benchCase, &caseResult) != 0)
+                {
+                    fprintf(stderr, "case failed: %u bpm, noise %u uV, period %u ms\n",
+                            (unsigned)benchCase.bpm, (unsigned)benchCase.noiseUv, 
+                            (unsigned)benchCase.samplePeriodMs);
+                    return 1;
+                }
+                
+                PrintResult("case", &benchCase, &caseResult, 0);
+                AddResult(&total, &caseResult);
+                cases++;
+            }
+        }
+    }
+    
+    PrintResult("total", NULL, &total, cases);
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
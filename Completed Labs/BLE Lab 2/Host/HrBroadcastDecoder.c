@@ -0,0 +1,273 @@
+/*****************************************************************************
+* File Name: HrBroadcastDecoder.c
+*
+* Version: 1.0
+*
+* Description:
+* This file decodes the advertising data of the HR_BROADCAST option of the BLE
+* Lab 2, the way a display listening to the broadcast would. Build with: gcc
+* -O2 -I. -I"../BLE Lab 2.cydsn" -o hr_broadcast_decoder HrBroadcastDecoder.c.
+* Run ./hr_broadcast_decoder < adverts.txt > updates.csv, where each line of
+* adverts.txt is the advertising data of one received packet in hex,
+* optionally preceded by the receive time in ms and a comma. Repeated
+* advertisements of the same update are dropped; each output line is one heart
+* rate update, and updates missed between two received ones are counted.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <project.h>
+#include "HrBroadcast.h"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+/* Longest legacy advertising data */
+#define ADV_DATA_MAX_LEN                    (31u)
+#define LINE_MAX_LEN                        (256u)
+
+#define AD_TYPE_MANUFACTURER_DATA           (0xFFu)
+
+/* Offsets in the manufacturer data AD structure, after its length byte,
+ * see HrBroadcast.h */
+#define MANUFACTURER_TYPE_INDEX             (0u)
+#define MANUFACTURER_COMPANY_ID_INDEX       (1u)
+#define MANUFACTURER_FORMAT_INDEX           (3u)
+#define MANUFACTURER_SEQUENCE_INDEX         (4u)
+#define MANUFACTURER_HEART_RATE_INDEX       (5u)
+#define MANUFACTURER_RR_COUNT_INDEX         (6u)
+#define MANUFACTURER_RR_INTERVAL_INDEX      (7u)
+#define MANUFACTURER_DATA_LEN               (9u)
+
+/* RR-intervals are sent in units of 1/1024 second */
+#define RR_UNITS_PER_SECOND                 (1024.0)
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: ParseHex()
+******************************************************************************
+* Summary:
+* Converts hex bytes, with or without separators, to bytes.
+*
+* Return:
+* int: Number of bytes, or -1 if the text is not hex
+*
+*****************************************************************************/
+static int ParseHex(const char *text, uint8 *data, int maxLen)
+{
+    int len = 0;
+    int digits = 0;
+    int value = 0;
+    
+    for(; *text != '\0'; text++)
+    {
+        if(isxdigit((unsigned char)*text))
+        {
+            value = (value << 4) | (isdigit((unsigned char)*text) ? (*text - '0') : 
+                                    ((tolower((unsigned char)*text) - 'a') + 10));
+            
+            if(++digits == 2)
+            {
+                if(len == maxLen)
+                {
+                    return -1;
+                }
+                
+                data[len++] = (uint8)value;
+                digits = 0;
+                value = 0;
+            }
+        }
+        else if((*text == 'x') && (digits == 1) && (value == 0))
+        {
+            /* 0x prefix */
+            digits = 0;
+        }
+        else if(!isspace((unsigned char)*text) && (*text != ':') && (*text != '-'))
+        {
+            return -1;
+        }
+    }
+    
+    return (digits == 0) ? len : -1;
+}
+
+
+/*****************************************************************************
+* Function Name: FindBroadcast()
+******************************************************************************
+* Summary:
+* Walks the AD structures of the advertising data and returns the 
+* manufacturer data of the heart rate broadcast, starting at its AD type.
+*
+* Return:
+* const uint8 *: Manufacturer data, or NULL if the packet has none
+*
+*****************************************************************************/
+static const uint8 *FindBroadcast(const uint8 *advData, int advLen)
+{
+    const uint8 *field;
+    int offset = 0;
+    int fieldLen;
+    
+    while(offset < advLen)
+    {
+        fieldLen = advData[offset];
+        
+        /* A zero length ends the significant part of the data */
+        if((fieldLen == 0) || ((offset + 1 + fieldLen) > advLen))
+        {
+            break;
+        }
+        
+        field = &advData[offset + 1];
+        
+        if((fieldLen >= (int)MANUFACTURER_DATA_LEN) && 
+           (field[MANUFACTURER_TYPE_INDEX] == AD_TYPE_MANUFACTURER_DATA) &&
+           (field[MANUFACTURER_COMPANY_ID_INDEX] == LO8(HR_BROADCAST_COMPANY_ID)) &&
+           (field[MANUFACTURER_COMPANY_ID_INDEX + 1u] == HI8(HR_BROADCAST_COMPANY_ID)) &&
+           (field[MANUFACTURER_FORMAT_INDEX] == HR_BROADCAST_FORMAT))
+        {
+            return field;
+        }
+        
+        offset += 1 + fieldLen;
+    }
+    
+    return NULL;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Decodes the advertisements on stdin to heart rate updates on stdout.
+*
+* Theory:
+* The device advertises each update several times, so a sequence number
+* equal to the last one is a repeat. A step of more than one counts the 
+* updates missed in between; their RR-intervals are lost too, which the 
+* RR-interval count of the next update shows.
+*
+*****************************************************************************/
+int main(void)
+{
+    char line[LINE_MAX_LEN];
+    uint8 advData[ADV_DATA_MAX_LEN];
+    const uint8 *broadcast;
+    const char *hex;
+    char *comma;
+    unsigned lineNumber = 0;
+    unsigned packets = 0;
+    unsigned updates = 0;
+    unsigned missed = 0;
+    unsigned step;
+    uint8 sequence;
+    uint8 lastSequence = 0;
+    uint16 rrInterval;
+    int first = 1;
+    int advLen;
+    
+    printf("time_ms,sequence,heart_rate,rr_count,rr_interval_ms,missed_updates\n");
+    
+    while(fgets(line, sizeof(line), stdin) != NULL)
+    {
+        lineNumber++;
+        comma = strchr(line, ',');
+        hex = (comma != NULL) ? (comma + 1) : line;
+        advLen = ParseHex(hex, advData, sizeof(advData));
+        
+        if(advLen < 0)
+        {
+            fprintf(stderr, "line %u: not advertising data\n", lineNumber);
+            return 1;
+        }
+        
+        broadcast = FindBroadcast(advData, advLen);
+        
+        if(broadcast == NULL)
+        {
+            continue;
+        }
+        
+        packets++;
+        sequence = broadcast[MANUFACTURER_SEQUENCE_INDEX];
+        
+        if(!first && (sequence == lastSequence))
+        {
+            continue;
+        }
+        
+        step = first ? 1u : (uint8)(sequence - lastSequence);
+        missed += step - 1u;
+        rrInterval = (uint16)(broadcast[MANUFACTURER_RR_INTERVAL_INDEX] | 
+                              ((uint16)broadcast[MANUFACTURER_RR_INTERVAL_INDEX + 1u] << 8));
+        
+        if(comma != NULL)
+        {
+            *comma = '\0';
+            printf("%s", line);
+        }
+        
+        printf(",%u,%u,%u,%.1f,%u\n", (unsigned)sequence, (unsigned)broadcast[MANUFACTURER_HEART_RATE_INDEX], 
+               (unsigned)broadcast[MANUFACTURER_RR_COUNT_INDEX], (rrInterval * 1000.0) / RR_UNITS_PER_SECOND, 
+               step - 1u);
+        
+        lastSequence = sequence;
+        first = 0;
+        updates++;
+    }
+    
+    fprintf(stderr, "%u broadcast packets, %u updates, %u updates missed\n", packets, updates, missed);
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,288 @@
+/*****************************************************************************
+* File Name: MtuThroughput.c
+*
+* Version: 1.0
+*
+* Description:
+* This file compares the notification throughput of the BLE Lab 2 at the
+* default 23 byte ATT MTU and at negotiated MTUs, on a PC. The real
+* GeneralEventHandler() of BleProcessing.c takes the Exchange MTU request of a
+* simulated central and GetNotificationPayloadLen() sizes the ECG stream
+* packets. Build with: gcc -O2 -I. -I"../BLE Lab 2.cydsn" -o mtu_throughput
+* MtuThroughput.c "../BLE Lab 2.cydsn/BleProcessing.c". Run ./mtu_throughput
+* [-i interval_ms] [-e pdus_per_event]. Each output line is a JSON object for
+* one central MTU, with the negotiated MTU, the ECG samples and link layer
+* packets per notification, the share of the link layer payload that is
+* samples, and the sample rate the link can carry; 23 is a central that does
+* not exchange the MTU.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <project.h>
+#include "main.h"
+#include "BleProcessing.h"
+#include "HeartRateProcessing.h"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+/* Connection interval requested by the lab, 16 x 1.25 ms */
+#define DEFAULT_INTERVAL_MS                 (20.0)
+
+/* Link layer packets the stack sends per connection event */
+#define DEFAULT_PDUS_PER_EVENT              (4u)
+
+/* BLE 4.1 link layer without Data Length Extension: 27 byte payload. An 
+ * ATT notification adds the 4 byte L2CAP header and is fragmented into as 
+ * many link layer packets as needed. */
+#define LL_PAYLOAD_MAX                      (27u)
+#define L2CAP_HEADER_LEN                    (4u)
+
+/* Air time at 1 Mbps: 10 bytes of preamble, access address, header and CRC
+ * per packet, then the inter frame space, the empty packet of the central
+ * and the inter frame space again */
+#define LL_PACKET_OVERHEAD_BYTES            (10u)
+#define LL_US_PER_BYTE                      (8u)
+#define LL_EXCHANGE_OVERHEAD_US             (150u + 80u + 150u)
+
+/* ECG stream packet of EcgStreaming.c: 16-bit sequence number, then 16-bit
+ * samples */
+#define ECG_PACKET_HEADER_LEN               (2u)
+#define ECG_SAMPLE_LEN                      (2u)
+
+/* The ECG sample rate of the lab */
+#define ECG_SAMPLE_RATE_HZ                  (100u)
+
+static const uint16 centralMtus[] = { 23u, 27u, 64u, 128u, 185u, 239u, 247u, 512u };
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Stubs of the PSoC components
+*****************************************************************************/
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+uint8 heartRate;
+
+uint8 GetRrIntervals(uint16 *rrIntervals, uint8 maxCount)
+{
+    (void)rrIntervals;
+    (void)maxCount;
+    return 0u;
+}
+
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize, 
+                                                    uint8 *attrValue)
+{
+    (void)charIndex;
+    memset(attrValue, 0, attrSize);
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_API_RESULT_T CyBle_HrssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_HRS_CHAR_INDEX_T charIndex, 
+                                              uint8 attrSize, uint8 *attrValue)
+{
+    (void)connHandle;
+    (void)charIndex;
+    (void)attrSize;
+    (void)attrValue;
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_STATE_T CyBle_GetState(void)
+{
+    return CYBLE_STATE_CONNECTED;
+}
+
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType)
+{
+    (void)advertisingIntervalType;
+    return CYBLE_ERROR_OK;
+}
+
+void Led_Advertising_Green_Write(uint8 value)
+{
+    (void)value;
+}
+
+void Led_Connected_Blue_Write(uint8 value)
+{
+    (void)value;
+}
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: Connect()
+******************************************************************************
+* Summary:
+* Connects a simulated central through the event handler of the lab. A 
+* central MTU above the default sends the Exchange MTU request.
+*
+*****************************************************************************/
+static void Connect(uint16 centralMtu)
+{
+    CYBLE_GATT_XCHG_MTU_PARAM_T mtuParam;
+    
+    GeneralEventHandler(CYBLE_EVT_GATT_DISCONNECT_IND, NULL);
+    GeneralEventHandler(CYBLE_EVT_GATT_CONNECT_IND, NULL);
+    
+    if(centralMtu > CYBLE_GATT_DEFAULT_MTU)
+    {
+        mtuParam.connHandle = cyBle_connHandle;
+        mtuParam.mtu = centralMtu;
+        GeneralEventHandler(CYBLE_EVT_GATTS_XCNHG_MTU_REQ, &mtuParam);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: PacketAirTimeUs()
+******************************************************************************
+* Summary:
+* Returns the air time of one link layer packet and its acknowledgement.
+*
+*****************************************************************************/
+static double PacketAirTimeUs(uint32 payloadLen)
+{
+    return (double)(((LL_PACKET_OVERHEAD_BYTES + payloadLen) * LL_US_PER_BYTE) + LL_EXCHANGE_OVERHEAD_US);
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Prints the throughput for every central MTU.
+*
+* Theory:
+* A notification of n bytes of value is n + 7 bytes of L2CAP data and needs 
+* ceil((n + 7) / 27) link layer packets. The stack sends up to 
+* pdus_per_event packets per connection event, fewer if they do not fit in
+* the interval, and fragments continue in the next event. The sample rate 
+* the link carries is then the packets per second divided by the packets 
+* per notification, times the samples per notification.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    double intervalMs = DEFAULT_INTERVAL_MS;
+    uint32 pdusPerEvent = DEFAULT_PDUS_PER_EVENT;
+    double baseRate = 0.0;
+    double pdusPerSecond;
+    double samplesPerSecond;
+    uint32 fitPdus;
+    uint32 payloadLen;
+    uint32 samplesPerPacket;
+    uint32 l2capLen;
+    uint32 llPdus;
+    uint32 index;
+    int argIndex;
+    
+    for(argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if((strcmp(argv[argIndex], "-i") == 0) && ((argIndex + 1) < argc))
+        {
+            intervalMs = strtod(argv[++argIndex], NULL);
+        }
+        else if((strcmp(argv[argIndex], "-e") == 0) && ((argIndex + 1) < argc))
+        {
+            pdusPerEvent = (uint32)strtoul(argv[++argIndex], NULL, 0);
+        }
+        else
+        {
+            intervalMs = 0.0;
+            break;
+        }
+    }
+    
+    if((intervalMs < 7.5) || (pdusPerEvent == 0u))
+    {
+        fprintf(stderr, "usage: %s [-i interval_ms, 7.5 or more] [-e pdus_per_event]\n", argv[0]);
+        return 1;
+    }
+    
+    /* Full packets that fit in one connection event */
+    fitPdus = (uint32)((intervalMs * 1000.0) / PacketAirTimeUs(LL_PAYLOAD_MAX));
+    
+    if(fitPdus < pdusPerEvent)
+    {
+        pdusPerEvent = fitPdus;
+    }
+    
+    pdusPerSecond = (pdusPerEvent * 1000.0) / intervalMs;
+    
+    for(index = 0; index < COUNT_OF(centralMtus); index++)
+    {
+        Connect(centralMtus[index]);
+        
+        /* Packed the way EcgStreaming_SendPending() packs */
+        samplesPerPacket = (GetNotificationPayloadLen() - ECG_PACKET_HEADER_LEN) / ECG_SAMPLE_LEN;
+        payloadLen = ECG_PACKET_HEADER_LEN + (samplesPerPacket * ECG_SAMPLE_LEN);
+        l2capLen = L2CAP_HEADER_LEN + ATT_NOTIFICATION_HEADER_LEN + payloadLen;
+        llPdus = (l2capLen + LL_PAYLOAD_MAX - 1u) / LL_PAYLOAD_MAX;
+        samplesPerSecond = (pdusPerSecond / llPdus) * samplesPerPacket;
+        
+        if(index == 0u)
+        {
+            baseRate = samplesPerSecond;
+        }
+        
+        printf("{\"central_mtu\":%u,\"mtu\":%u,\"samples_per_notification\":%u,\"ll_pdus_per_notification\":%u,"
+               "\"sample_share\":%.3f,\"interval_ms\":%.2f,\"pdus_per_event\":%u,\"samples_per_s\":%.0f,"
+               "\"vs_default_mtu\":%.2f,\"ecg_headroom\":%.1f}\n",
+               (unsigned)centralMtus[index], (unsigned)GetNegotiatedMtu(), (unsigned)samplesPerPacket, 
+               (unsigned)llPdus, (double)(samplesPerPacket * ECG_SAMPLE_LEN) / (llPdus * LL_PAYLOAD_MAX),
+               intervalMs, (unsigned)pdusPerEvent, samplesPerSecond, samplesPerSecond / baseRate,
+               samplesPerSecond / ECG_SAMPLE_RATE_HZ);
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,481 @@
+/*****************************************************************************
+* File Name: SampleCodecTool.c
+*
+* Version: 1.0
+*
+* Description:
+* This file builds the SampleCodec of the BLE Lab 2 on a PC, to read
+* compressed sample streams and to measure the codec. Build with: unzip -jo
+* "../../../Supporting Files/Lab2_PRoC_BLE_HRM_Simulator Project.zip"
+* "*.cydsn/EcgGenerator.*" -d ecg; gcc -O2 -DECG_HOST_BUILD -I. -Iecg
+* -I"../BLE Lab 2.cydsn" -o sample_codec SampleCodecTool.c "../BLE Lab
+* 2.cydsn/SampleCodec.c" ecg/EcgGenerator.c. Run ./sample_codec decode <
+* notifications.txt > samples.csv to decode the ECG stream of the
+* ECG_COMPRESSION option, or the slider stream of the SLIDER_COMPRESSION
+* option of the BLE Lab 3, which use the same packets. Each input line is one
+* notification in hex; each output line has the sequence number and the value
+* of one sample, and lost packets are reported on stderr. Run ./sample_codec
+* bench [blocks] [seed] for one JSON line per test signal with the compression
+* ratio and the encode and decode time per block.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <project.h>
+#include "SampleCodec.h"
+#include "EcgGenerator.h"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define DEFAULT_BLOCKS                      (10000u)
+#define DEFAULT_SEED                        (1u)
+
+/* Packet header: 16-bit sequence number of the first sample in the packet */
+#define PACKET_HEADER_LEN                   (2u)
+#define PACKET_MAX_LEN                      (512u)
+#define LINE_MAX_LEN                        (4u * PACKET_MAX_LEN)
+
+/* Analog front end of the BLE Lab 2: ADC counts at 0 uV and per uV, the 
+ * same as in HrBenchmark.c */
+#define ADC_OFFSET                          (1000)
+#define ADC_COUNTS_PER_UV_NUM               (4)
+#define ADC_COUNTS_PER_UV_DEN               (5)
+
+/* Slider of the BLE Lab 3: positions 0 to 100, or NO_FINGER sent as -1 */
+#define SLIDER_NO_FINGER                    (-1)
+#define SLIDER_MAX_VALUE                    (100)
+#define SLIDER_BLOCK_LEN                    (16u)
+
+/* Test signals of the benchmark */
+typedef enum
+{
+    SIGNAL_ECG_RESTING,
+    SIGNAL_ECG_EXERCISE,
+    SIGNAL_SLIDER,
+    SIGNAL_RANDOM,
+    SIGNAL_COUNT
+} SIGNAL_T;
+
+static const char * const signalNames[SIGNAL_COUNT] =
+{
+    "ecg_resting", "ecg_exercise", "slider", "random"
+};
+
+/* ECG test signals: 70 bpm at rest, and 150 bpm with motion artifacts */
+static const ECG_SEGMENT_T ecgRestingSegment = {0u,  70u,  70u, 30u, 10u, 100u, 20u, 0u,   0u};
+static const ECG_SEGMENT_T ecgExerciseSegment = {0u, 150u, 150u,  5u,  5u, 200u, 40u, 4u, 400u};
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    SIGNAL_T signal;
+    ECG_GENERATOR_T generator;
+    int32 sliderPosition;
+    int32 sliderVelocity;
+    uint32 random;
+} SIGNAL_SOURCE_T;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: ParseHexLine()
+******************************************************************************
+* Summary:
+* Converts a line of hex bytes, with or without separators, to bytes.
+*
+* Return:
+* int: Number of bytes, or -1 if the line is not hex
+*
+*****************************************************************************/
+static int ParseHexLine(const char *line, uint8 *data, int maxLen)
+{
+    int len = 0;
+    int digits = 0;
+    int value = 0;
+    
+    for(; *line != '\0'; line++)
+    {
+        if(isxdigit((unsigned char)*line))
+        {
+            value = (value << 4) | (isdigit((unsigned char)*line) ? (*line - '0') : 
+                                    ((tolower((unsigned char)*line) - 'a') + 10));
+            
+            if(++digits == 2)
+            {
+                if(len == maxLen)
+                {
+                    return -1;
+                }
+                
+                data[len++] = (uint8)value;
+                digits = 0;
+                value = 0;
+            }
+        }
+        else if((*line == 'x') && (digits == 1) && (value == 0))
+        {
+            /* 0x prefix */
+            digits = 0;
+        }
+        else if(!isspace((unsigned char)*line) && (*line != ':') && (*line != ',') && (*line != '-'))
+        {
+            return -1;
+        }
+    }
+    
+    return (digits == 0) ? len : -1;
+}
+
+
+/*****************************************************************************
+* Function Name: Decode()
+******************************************************************************
+* Summary:
+* Decodes a stream of notifications from stdin to CSV on stdout.
+*
+* Theory:
+* The sequence number of each packet is the index of its first sample, so
+* a packet that starts after the end of the previous one follows lost 
+* packets, or samples dropped by the device on overflow.
+*
+*****************************************************************************/
+static int Decode(void)
+{
+    char line[LINE_MAX_LEN];
+    uint8 packet[PACKET_MAX_LEN];
+    int16 samples[SAMPLE_CODEC_MAX_BLOCK_LEN];
+    uint16 sequence;
+    uint16 expected = 0;
+    uint32 lineNumber = 0;
+    uint32 lost = 0;
+    int first = 1;
+    int len;
+    uint8 count;
+    uint8 index;
+    
+    printf("sequence,sample\n");
+    
+    while(fgets(line, sizeof(line), stdin) != NULL)
+    {
+        lineNumber++;
+        len = ParseHexLine(line, packet, sizeof(packet));
+        
+        if(len == 0)
+        {
+            continue;
+        }
+        
+        if(len <= (int)PACKET_HEADER_LEN)
+        {
+            fprintf(stderr, "line %u: not a packet\n", (unsigned)lineNumber);
+            return 1;
+        }
+        
+        sequence = (uint16)(packet[0] | ((uint16)packet[1] << 8));
+        count = SampleCodec_DecodeBlock(&packet[PACKET_HEADER_LEN], (uint16)(len - PACKET_HEADER_LEN), 
+                                        samples, SAMPLE_CODEC_MAX_BLOCK_LEN);
+        
+        if(count == 0u)
+        {
+            fprintf(stderr, "line %u: malformed block\n", (unsigned)lineNumber);
+            return 1;
+        }
+        
+        if(!first && (sequence != expected))
+        {
+            fprintf(stderr, "line %u: %u samples lost before sequence %u\n", 
+                    (unsigned)lineNumber, (unsigned)(uint16)(sequence - expected), (unsigned)sequence);
+            lost += (uint16)(sequence - expected);
+        }
+        
+        for(index = 0; index < count; index++)
+        {
+            printf("%u,%d\n", (unsigned)(uint16)(sequence + index), samples[index]);
+        }
+        
+        expected = (uint16)(sequence + count);
+        first = 0;
+    }
+    
+    if(lost != 0u)
+    {
+        fprintf(stderr, "%u samples lost\n", (unsigned)lost);
+    }
+    
+    return 0;
+}
+
+
+/*****************************************************************************
+* Function Name: NextRandom()
+******************************************************************************
+* Summary:
+* Returns a random number from a xorshift generator.
+*
+*****************************************************************************/
+static uint32 NextRandom(uint32 *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    
+    return *state;
+}
+
+
+/*****************************************************************************
+* Function Name: InitSignal()
+******************************************************************************
+* Summary:
+* Starts a test signal.
+*
+*****************************************************************************/
+static void InitSignal(SIGNAL_SOURCE_T *source, SIGNAL_T signal, uint32 seed)
+{
+    ECG_SCENARIO_T scenario;
+    
+    memset(source, 0, sizeof(*source));
+    source->signal = signal;
+    source->random = seed;
+    source->sliderPosition = SLIDER_NO_FINGER;
+    
+    if((signal == SIGNAL_ECG_RESTING) || (signal == SIGNAL_ECG_EXERCISE))
+    {
+        scenario.segments = (signal == SIGNAL_ECG_RESTING) ? &ecgRestingSegment : &ecgExerciseSegment;
+        scenario.segmentCount = 1u;
+        scenario.loop = 0u;
+        EcgGenerator_Init(&source->generator, &scenario, seed);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: NextSample()
+******************************************************************************
+* Summary:
+* Returns the next sample of a test signal. The ECG signals are ADC counts 
+* of the BLE Lab 2 at 250 Hz. The slider signal is swipes of random speed 
+* with idle gaps, scanned as by the BLE Lab 3. The random signal is full 
+* scale 16-bit noise, the worst case for the codec.
+*
+*****************************************************************************/
+static int16 NextSample(SIGNAL_SOURCE_T *source)
+{
+    switch(source->signal)
+    {
+        case SIGNAL_ECG_RESTING:
+        case SIGNAL_ECG_EXERCISE:
+            return (int16)(ADC_OFFSET + 
+                           ((EcgGenerator_NextSample(&source->generator) * ADC_COUNTS_PER_UV_NUM) / 
+                            ADC_COUNTS_PER_UV_DEN));
+        
+        case SIGNAL_SLIDER:
+            if(source->sliderPosition == SLIDER_NO_FINGER)
+            {
+                /* Touch down on average every 64 scans */
+                if((NextRandom(&source->random) & 63u) == 0u)
+                {
+                    source->sliderPosition = (int32)(NextRandom(&source->random) % (SLIDER_MAX_VALUE + 1));
+                    source->sliderVelocity = (int32)(NextRandom(&source->random) % 7u) - 3;
+                }
+            }
+            else
+            {
+                source->sliderPosition += source->sliderVelocity + 
+                                          ((int32)(NextRandom(&source->random) % 3u) - 1);
+                
+                if((source->sliderPosition < 0) || (source->sliderPosition > SLIDER_MAX_VALUE))
+                {
+                    source->sliderPosition = SLIDER_NO_FINGER;
+                }
+            }
+            
+            return (int16)source->sliderPosition;
+        
+        default:
+            return (int16)NextRandom(&source->random);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: ElapsedNs()
+******************************************************************************
+* Summary:
+* Returns the time between two clock readings in nanoseconds.
+*
+*****************************************************************************/
+static double ElapsedNs(const struct timespec *start, const struct timespec *end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+
+/*****************************************************************************
+* Function Name: Bench()
+******************************************************************************
+* Summary:
+* Encodes and decodes blocks of each test signal, and prints one JSON line
+* per signal. The ECG and random signals use blocks of 
+* SAMPLE_CODEC_MAX_BLOCK_LEN samples as the ECG stream does, the slider 
+* signal blocks of 16 scans. Every block must decode to its samples.
+*
+*****************************************************************************/
+static int Bench(uint32 blocks, uint32 seed)
+{
+    SIGNAL_SOURCE_T source;
+    struct timespec start;
+    struct timespec end;
+    int16 samples[SAMPLE_CODEC_MAX_BLOCK_LEN];
+    int16 decoded[SAMPLE_CODEC_MAX_BLOCK_LEN];
+    uint8 encoded[SAMPLE_CODEC_MAX_ENCODED_LEN];
+    uint32 signal;
+    uint32 block;
+    uint32 encodedBytes;
+    uint32 mismatches;
+    uint16 encodedLen;
+    uint8 blockLen;
+    uint8 index;
+    double encodeNs;
+    double decodeNs;
+    int rc = 0;
+    
+    for(signal = 0; signal < SIGNAL_COUNT; signal++)
+    {
+        InitSignal(&source, (SIGNAL_T)signal, seed);
+        blockLen = (signal == SIGNAL_SLIDER) ? SLIDER_BLOCK_LEN : SAMPLE_CODEC_MAX_BLOCK_LEN;
+        encodedBytes = 0;
+        mismatches = 0;
+        encodeNs = 0.0;
+        decodeNs = 0.0;
+        
+        for(block = 0; block < blocks; block++)
+        {
+            for(index = 0; index < blockLen; index++)
+            {
+                samples[index] = NextSample(&source);
+            }
+            
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            encodedLen = SampleCodec_EncodeBlock(samples, blockLen, encoded, sizeof(encoded));
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            encodeNs += ElapsedNs(&start, &end);
+            
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            index = SampleCodec_DecodeBlock(encoded, encodedLen, decoded, SAMPLE_CODEC_MAX_BLOCK_LEN);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            decodeNs += ElapsedNs(&start, &end);
+            
+            if((encodedLen == 0u) || (index != blockLen) || 
+               (memcmp(samples, decoded, blockLen * sizeof(int16)) != 0))
+            {
+                mismatches++;
+            }
+            
+            encodedBytes += encodedLen;
+        }
+        
+        printf("{\"signal\":\"%s\",\"blocks\":%u,\"block_len\":%u,\"raw_bytes\":%u,\"encoded_bytes\":%u,"
+               "\"ratio\":%.3f,\"bits_per_sample\":%.2f,\"encode_ns_per_block\":%.0f,"
+               "\"decode_ns_per_block\":%.0f,\"mismatches\":%u}\n",
+               signalNames[signal], (unsigned)blocks, (unsigned)blockLen, 
+               (unsigned)(blocks * blockLen * sizeof(int16)), (unsigned)encodedBytes,
+               (double)(blocks * blockLen * sizeof(int16)) / encodedBytes,
+               (8.0 * encodedBytes) / ((double)blocks * blockLen),
+               encodeNs / blocks, decodeNs / blocks, (unsigned)mismatches);
+        
+        if(mismatches != 0u)
+        {
+            rc = 1;
+        }
+    }
+    
+    return rc;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Runs the decoder or the benchmark.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32 blocks;
+    uint32 seed;
+    
+    if((argc >= 2) && (strcmp(argv[1], "decode") == 0))
+    {
+        return Decode();
+    }
+    
+    if((argc >= 2) && (strcmp(argv[1], "bench") == 0))
+    {
+        blocks = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : DEFAULT_BLOCKS;
+        seed = (argc > 3) ? (uint32)strtoul(argv[3], NULL, 0) : DEFAULT_SEED;
+        
+        if((blocks != 0u) && (seed != 0u))
+        {
+            return Bench(blocks, seed);
+        }
+    }
+    
+    fprintf(stderr, "usage: %s decode < notifications.txt\n"
+                    "       %s bench [blocks] [seed]\n", argv[0], argv[0]);
+    
+    return 1;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,193 @@
+/*****************************************************************************
+* File Name: project.h
+*
+* Version: 1.0
+*
+* Description:
+* This file stands in for the PSoC Creator generated project.h when code of
+* the BLE Lab 2 is built on a PC by the tools in this folder. It declares 
+* only the types and component APIs that HeartRateProcessing.c, 
+* BleProcessing.c, SampleCodec.c, EventTrace.c and the headers of 
+* HrBroadcast.c use, with the options of main.h at their defaults; 
+* HrBenchmark.c, MtuThroughput.c and EventTraceBench.c implement the APIs.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_HOST_PROJECT_H)
+#define _HOST_PROJECT_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*****************************************************************************
+* cytypes.h
+*****************************************************************************/
+typedef uint8_t     uint8;
+typedef uint16_t    uint16;
+typedef uint32_t    uint32;
+typedef int8_t      int8;
+typedef int16_t     int16;
+typedef int32_t     int32;
+
+#define LO8(x)                  ((uint8)((x) & 0xFFu))
+#define HI8(x)                  ((uint8)((uint16)(x) >> 8))
+#define LO16(x)                 ((uint16)((x) & 0xFFFFu))
+#define HI16(x)                 ((uint16)((uint32)(x) >> 16))
+
+#define CY_ISR(name)            void name(void)
+#define CY_ISR_PROTO(name)      void name(void)
+
+
+/*****************************************************************************
+* ADC, Opamp and LED pins
+*****************************************************************************/
+#define ADC_WAIT_FOR_RESULT     (1u)
+
+void ADC_StartConvert(void);
+uint32 ADC_IsEndConversion(uint32 retMode);
+int16 ADC_GetResult16(uint32 chan);
+
+void Led_Advertising_Green_Write(uint8 value);
+void Led_Connected_Blue_Write(uint8 value);
+
+
+/*****************************************************************************
+* BLE component
+*****************************************************************************/
+#define CYBLE_GATT_MTU          (0x200u)
+#define CYBLE_GATT_DEFAULT_MTU  (23u)
+
+#define CYBLE_EVENT_TRACE_SERVICE_EVENT_TRACE_CHAR_HANDLE                                         (0x0030u)
+#define CYBLE_EVENT_TRACE_SERVICE_EVENT_TRACE_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE     (0x0031u)
+
+typedef enum
+{
+    CYBLE_ERROR_OK = 0
+} CYBLE_API_RESULT_T;
+
+typedef enum
+{
+    CYBLE_STATE_STOPPED,
+    CYBLE_STATE_INITIALIZING,
+    CYBLE_STATE_CONNECTED,
+    CYBLE_STATE_ADVERTISING,
+    CYBLE_STATE_DISCONNECTED
+} CYBLE_STATE_T;
+
+typedef enum
+{
+    CYBLE_ADVERTISING_FAST,
+    CYBLE_ADVERTISING_SLOW
+} CYBLE_ADV_MODE_T;
+
+typedef enum
+{
+    CYBLE_HRS_HRM,
+    CYBLE_HRS_BSL,
+    CYBLE_HRS_CPT
+} CYBLE_HRS_CHAR_INDEX_T;
+
+typedef enum
+{
+    CYBLE_STACK_STATE_BUSY,
+    CYBLE_STACK_STATE_FREE
+} CYBLE_STACK_BUFFER_STATE_T;
+
+typedef struct
+{
+    uint8 bdHandle;
+    uint8 attId;
+} CYBLE_CONN_HANDLE_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    uint16 mtu;
+} CYBLE_GATT_XCHG_MTU_PARAM_T;
+
+typedef struct
+{
+    uint8 *val;
+    uint16 len;
+    uint16 actualLen;
+} CYBLE_GATT_VALUE_T;
+
+typedef struct
+{
+    CYBLE_GATT_VALUE_T value;
+    uint16 attrHandle;
+} CYBLE_GATT_HANDLE_VALUE_PAIR_T;
+
+typedef CYBLE_GATT_HANDLE_VALUE_PAIR_T CYBLE_GATTS_HANDLE_VALUE_NTF_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValPair;
+} CYBLE_GATTS_WRITE_REQ_PARAM_T;
+
+enum
+{
+    CYBLE_EVT_STACK_ON = 1,
+    CYBLE_EVT_TIMEOUT,
+    CYBLE_EVT_HARDWARE_ERROR,
+    CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP,
+    CYBLE_EVT_GAP_DEVICE_CONNECTED,
+    CYBLE_EVT_GAP_DEVICE_DISCONNECTED,
+    CYBLE_EVT_GATT_CONNECT_IND,
+    CYBLE_EVT_GATT_DISCONNECT_IND,
+    CYBLE_EVT_GATTS_XCNHG_MTU_REQ,
+    CYBLE_EVT_HRSS_NOTIFICATION_ENABLED,
+    CYBLE_EVT_HRSS_NOTIFICATION_DISABLED,
+    CYBLE_EVT_STACK_BUSY_STATUS,
+    CYBLE_EVT_GATTS_WRITE_REQ,
+    CYBLE_EVT_GATTS_WRITE_CMD_REQ
+};
+
+extern CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+CYBLE_STATE_T CyBle_GetState(void);
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType);
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_HrssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_HRS_CHAR_INDEX_T charIndex, 
+                                              uint8 attrSize, uint8 *attrValue);
+uint8 CyBle_GattGetBusyStatus(void);
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam);
+
+#endif
+
+/* [] END OF FILE */
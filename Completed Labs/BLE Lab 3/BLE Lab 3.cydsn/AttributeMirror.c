@@ -0,0 +1,142 @@
+/*****************************************************************************
+* File Name: AttributeMirror.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the dirty tracking of locally mirrored attribute values
+* implemented as part of the PSoC 4 BLE Lab 4. A mirror keeps the bytes last
+* written to a GATT DB attribute and only writes the attribute again when the
+* value has changed.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <string.h>
+#include <main.h>
+#include <AttributeMirror.h>
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: AttributeMirror_Init
+********************************************************************************
+* Summary:
+* Binds a mirror to a GATT DB attribute and clears its counters. The first 
+* commit always writes the attribute.
+*
+* Parameters:
+*  mirror:     Mirror to initialize
+*  attrHandle: Attribute handle in the GATT DB
+*  len:        Value length, up to ATTRIBUTE_MIRROR_MAX_LEN
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AttributeMirror_Init(ATTRIBUTE_MIRROR_T *mirror, CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle, uint8 len)
+{
+    mirror->attrHandle = attrHandle;
+    mirror->len = (len < ATTRIBUTE_MIRROR_MAX_LEN) ? len : ATTRIBUTE_MIRROR_MAX_LEN;
+    mirror->valid = FALSE;
+    mirror->writeCount = 0;
+    mirror->skipCount = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: AttributeMirror_Invalidate
+********************************************************************************
+* Summary:
+* Forces the next commit to write the attribute. Used when the GATT DB value
+* may have changed without going through the mirror.
+*
+* Parameters:
+*  mirror: Mirror to invalidate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AttributeMirror_Invalidate(ATTRIBUTE_MIRROR_T *mirror)
+{
+    mirror->valid = FALSE;
+}
+
+
+/*******************************************************************************
+* Function Name: AttributeMirror_Commit
+********************************************************************************
+* Summary:
+* Writes the value to the GATT DB attribute unless it is the same as the 
+* value last written.
+*
+* Parameters:
+*  mirror: Mirror of the attribute
+*  value:  New value, mirror->len bytes
+*
+* Return:
+*  uint8: TRUE if the value changed and the attribute was written
+*
+*******************************************************************************/
+uint8 AttributeMirror_Commit(ATTRIBUTE_MIRROR_T *mirror, const uint8 *value)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValPair;
+    
+    if((TRUE == mirror->valid) && (0 == memcmp(mirror->committed, value, mirror->len)))
+    {
+        mirror->skipCount++;
+        return FALSE;
+    }
+    
+    memcpy(mirror->committed, value, mirror->len);
+    mirror->valid = TRUE;
+    mirror->writeCount++;
+    
+    handleValPair.attrHandle = mirror->attrHandle;
+    handleValPair.value.val = mirror->committed;
+    handleValPair.value.len = mirror->len;
+    handleValPair.value.actualLen = mirror->len;
+    
+    CyBle_GattsWriteAttributeValue(&handleValPair, ZERO, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+    
+    return TRUE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*****************************************************************************
+* File Name: AttributeMirror.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the dirty tracking of locally mirrored attribute values
+* implemented as part of the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_ATTRIBUTE_MIRROR_H)
+#define _ATTRIBUTE_MIRROR_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* Longest value a mirror can hold: the 4-byte RGB LED characteristic */
+#define ATTRIBUTE_MIRROR_MAX_LEN        (4u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* GATT DB attribute the value is written to */
+    CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle;
+    uint8 len;
+    
+    /* Value last written to the GATT DB, valid once something is written */
+    uint8 committed[ATTRIBUTE_MIRROR_MAX_LEN];
+    uint8 valid;
+    
+    /* Commits that wrote the GATT DB and commits skipped as unchanged */
+    uint32 writeCount;
+    uint32 skipCount;
+} ATTRIBUTE_MIRROR_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void AttributeMirror_Init(ATTRIBUTE_MIRROR_T *mirror, CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle, uint8 len);
+void AttributeMirror_Invalidate(ATTRIBUTE_MIRROR_T *mirror);
+uint8 AttributeMirror_Commit(ATTRIBUTE_MIRROR_T *mirror, const uint8 *value);
+
+
+#endif  /* #if !defined(_ATTRIBUTE_MIRROR_H) */
+
+/* [] END OF FILE */
@@ -1,291 +1,803 @@
-/*****************************************************************************
-* File Name: BleApplications.c
-*
-* Version: 1.0
-*
-* Description:
-* This file implements the BLE capability in the PSoC 4 BLE Lab 4.
-*
-* Hardware Dependency:
-* CY8CKIT-042 BLE Pioneer Kit
-*
-******************************************************************************
-* Copyright (2014), Cypress Semiconductor Corporation.
-******************************************************************************
-* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
-* protected by and subject to worldwide patent protection (United States and
-* foreign), United States copyright laws and international treaty provisions.
-* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
-* license to copy, use, modify, create derivative works of, and compile the
-* Cypress Source Code and derivative works for the sole purpose of creating
-* custom software in support of licensee product to be used only in conjunction
-* with a Cypress integrated circuit as specified in the applicable agreement.
-* Any reproduction, modification, translation, compilation, or representation of
-* this software except as specified above is prohibited without the express
-* written permission of Cypress.
-*
-* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
-* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
-* Cypress reserves the right to make changes without further notice to the
-* materials described herein. Cypress does not assume any liability arising out
-* of the application or use of any product or circuit described herein. Cypress
-* does not authorize its products for use as critical components in life-support
-* systems where a malfunction or failure may reasonably be expected to result in
-* significant injury to the user. The inclusion of Cypress' product in a life-
-* support systems application implies that the manufacturer assumes all risk of
-* such use and in doing so indemnifies Cypress against all charges. Use may be
-* limited by and subject to the applicable Cypress software license agreement.
-*****************************************************************************/
-
-/*****************************************************************************
-* Included headers
-*****************************************************************************/
-#include <main.h>
-#include <BLEApplications.h>
-
-
-/*****************************************************************************
-* Static variables 
-*****************************************************************************/
-
-/* 'rgbHandle' stores RGB control data parameters */
-CYBLE_GATT_HANDLE_VALUE_PAIR_T		rgbHandle;	
-
-/*This flag is set when the Central device writes to CCC (Client Characteristic 
-* Configuration) of the CapSense slider Characteristic to enable notifications */
-uint8 sendCapSenseSliderNotifications = FALSE;	
-
-/* Array to store the present RGB LED control data. The 4 bytes 
-* of the array represents {R, G, B, Intensity} */
-uint8 RGBledData[4];
-
-/* This flag is used by application to know whether a Central 
-* device has been connected. This is updated in BLE event callback 
-* function*/
-uint8 deviceConnected = FALSE;
-
-
-/*******************************************************************************
-* Function Name: CustomEventHandler
-********************************************************************************
-* Summary:
-* Call back event function to handle various events from BLE stack
-*
-* Parameters:
-*  event:		event returned
-*  eventParam:	link to value of the events returned
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void CustomEventHandler(uint32 event, void * eventParam)
-{
-    /* Local variable to strore the write request parameters */
-	CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReqParam;
-    
-    /* Local variable to store the current CCCD value */
-	uint8 CapSenseCCCDvalue[2];
-	
-	/* Handle value to update the CCCD */
-	CYBLE_GATT_HANDLE_VALUE_PAIR_T CapSenseNotificationCCCDhandle;
-   
-    switch(event)
-    {
-        case CYBLE_EVT_STACK_ON:
-        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
-			/* Start Advertisement and enter Discoverable mode*/
-			CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
-			break;
-			
-		case CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP:
-			/* Set the BLE state variable to control LED status */
-            if(CYBLE_STATE_DISCONNECTED == CyBle_GetState())
-            {
-                /* Start Advertisement and enter Discoverable mode*/
-                CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
-            }
-			break;
-			
-        case CYBLE_EVT_GATT_CONNECT_IND:
-			/* This flag is used in application to check connection status */
-			deviceConnected = TRUE;
-			break;
-        
-        case CYBLE_EVT_GATT_DISCONNECT_IND:
-			/* Update deviceConnected flag*/
-			deviceConnected = FALSE;
-			
-			/* Reset CapSense notification flag to prevent further notifications
-			 * being sent to Central device after next connection. */
-			sendCapSenseSliderNotifications = FALSE;
-			
-			/* Reset the color coordinates */
-			RGBledData[RED_INDEX] = ZERO;
-            RGBledData[GREEN_INDEX] = ZERO;
-            RGBledData[BLUE_INDEX] = ZERO;
-            RGBledData[INTENSITY_INDEX] = ZERO;
-			UpdateRGBled();
-
-			break;
-        
-            
-        case CYBLE_EVT_GATTS_WRITE_REQ: 							
-            /* This event is received when Central device sends a Write command 
-             * on an Attribute. 
-             * We first get the attribute handle from the event parameter and 
-             * then try to match that handle with an attribute in the database.
-             */
-            wrReqParam = (CYBLE_GATTS_WRITE_REQ_PARAM_T *) eventParam;
-            
-
-            /* This condition checks whether the RGB LED characteristic was
-             * written to by matching the attribute handle.
-             * If the attribute handle matches, then the value written to the 
-             * attribute is extracted and used to drive RGB LED.
-             */
-            
-            /* Extract the attribute handle for the RGB LED characteristic 
-             * from the custom service data structure.
-             */
-             
-            /* if (attributeHandle == RGB LED Characteristic Handle) */
-            if(wrReqParam->handleValPair.attrHandle == cyBle_customs[RGB_LED_SERVICE_INDEX].\
-								                        customServiceInfo[RGB_LED_CHAR_INDEX].\
-                                                        customServiceCharHandle)
-            {
-                /* Extract the value of the attribute from the handle-value 
-                 * pair database. */
-                RGBledData[RED_INDEX] = wrReqParam->handleValPair.value.val[RED_INDEX];
-                RGBledData[GREEN_INDEX] = wrReqParam->handleValPair.value.val[GREEN_INDEX];
-                RGBledData[BLUE_INDEX] = wrReqParam->handleValPair.value.val[BLUE_INDEX];
-                RGBledData[INTENSITY_INDEX] = wrReqParam->handleValPair.value.val[INTENSITY_INDEX];
-                
-                /* Update the PrISM components and the attribute for RGB LED read 
-                 * characteristics */
-                UpdateRGBled();
-            }
-
-            
-            /* This condition checks whether the CCCD descriptor for CapSense
-             * slider characteristic has been written to. This tells us whether
-             * the notification for CapSense slider has been enabled/disabled.
-             */
-            
-            /* if (attributeHandle == CapSense Slider Characteristics Handle) */
-            if(wrReqParam->handleValPair.attrHandle == cyBle_customs[CAPSENSE_SERVICE_INDEX].
-			            customServiceInfo[CAPSENSE_SLIDER_CHAR_INDEX].
-                        customServiceCharDescriptors[CAPSENSE_SLIDER_CCC_INDEX])
-            {
-                sendCapSenseSliderNotifications = wrReqParam->handleValPair.value.val[CCC_DATA_INDEX];
-				
-                /* When the Client Characteristic Configuration descriptor (CCCD) is
-                * written by the Central device for enabling/disabling notifications, 
-                * then the same descriptor value has to be explicitly updated in 
-                * application so that it reflects the correct value when the 
-                * descriptor is read. 
-                */
-                {
-                    /* Write the present CapSense notification status to the local variable */
-            		CapSenseCCCDvalue[0] = sendCapSenseSliderNotifications;
-            		CapSenseCCCDvalue[1] = 0x00;
-            		
-            		/* Update CCCD handle with notification status data*/
-            		CapSenseNotificationCCCDhandle.attrHandle = CAPSENSE_CCC_HANDLE;
-            		CapSenseNotificationCCCDhandle.value.val = CapSenseCCCDvalue;
-            		CapSenseNotificationCCCDhandle.value.len = sizeof(CapSenseCCCDvalue);
-            		
-            		/* Report data to BLE component for sending data when read by Central device */
-            		CyBle_GattsWriteAttributeValue(&CapSenseNotificationCCCDhandle, ZERO, &cyBle_connHandle, \
-                                                                                CYBLE_GATT_DB_LOCALLY_INITIATED);
-                }
-           }
-
-			
-			/* Send the response to the write request received. */
-			CyBle_GattsWriteRsp(cyBle_connHandle);
-			
-			break;
-
-        default:
-
-       	 	break;
-    }
-}
-
-
-/*******************************************************************************
-* Function Name: SendCapSenseNotification
-********************************************************************************
-* Summary:
-* Send CapSense Slider data as BLE Notifications. This function updates
-* the notification handle with data and triggers the BLE component to send 
-* notification
-*
-* Parameters:
-*  CapSenseSliderData:	CapSense slider value	
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void SendCapSenseNotification(uint8 CapSenseSliderData)
-{
-	/* 'CapSensenotificationHandle' stores CapSense notification data parameters */
-	CYBLE_GATTS_HANDLE_VALUE_NTF_T		CapSensenotificationHandle;	
-	
-	/* Update notification handle with CapSense slider data*/
-	CapSensenotificationHandle.attrHandle = CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CHAR_HANDLE;				
-	CapSensenotificationHandle.value.val = &CapSenseSliderData;
-	CapSensenotificationHandle.value.len = sizeof(CapSenseSliderData);
-	
-	/* Send notifications. */
-	CyBle_GattsNotification(cyBle_connHandle, &CapSensenotificationHandle);
-}
-
-
-/*******************************************************************************
-* Function Name: UpdateRGBled
-********************************************************************************
-* Summary:
-* Receive the new RGB data and modify PrISM parameters. Also, update the
-* read characteristic handle so that the next read from the BLE central device
-* gives present RGB color and intensity data.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void UpdateRGBled(void)
-{
-	/* Local variables to calculate the color components from RGB received data*/
-	uint8 debug_red;
-	uint8 debug_green;
-	uint8 debug_blue;
-	uint8 intensity_divide_value = RGBledData[INTENSITY_INDEX];
-	
-	debug_red = (uint8)(((uint16)RGBledData[RED_INDEX] * intensity_divide_value) / 255);
-	debug_green = (uint8)(((uint16)RGBledData[GREEN_INDEX] * intensity_divide_value) / 255);
-	debug_blue = (uint8)(((uint16)RGBledData[BLUE_INDEX] * intensity_divide_value) / 255);
-	
-	/* Update the density value of the PrISM module for color control*/
-	PRS_1_WritePulse0(RGB_LED_MAX_VAL - debug_red);
-    PRS_1_WritePulse1(RGB_LED_MAX_VAL - debug_green);
-    PRS_2_WritePulse0(RGB_LED_MAX_VAL - debug_blue);
-	
-	/* Update RGB control handle with new values */
-	rgbHandle.attrHandle = RGB_LED_CHAR_HANDLE;
-	rgbHandle.value.val = RGBledData;
-	rgbHandle.value.len = sizeof(RGBledData);
-	rgbHandle.value.actualLen = sizeof(RGBledData);
-	
-	/* Send updated RGB control handle as attribute for read by central device */
-	CyBle_GattsWriteAttributeValue(&rgbHandle, FALSE, &cyBle_connHandle, FALSE);  
-}
-
-
-/* [] END OF FILE */
+/*****************************************************************************
+* File Name: BleApplications.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the BLE capability in the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <string.h>
+#include <main.h>
+#include <BLEApplications.h>
+#include <RgbColor.h>
+#include <WriteDispatcher.h>
+#include <AttributeMirror.h>
+#include <EventTrace.h>
+#if CAPSENSE_REPORT
+#include <CapSenseReport.h>
+#endif
+#if RGB_ANIMATION
+#include <RgbAnimation.h>
+#endif
+#if SLIDER_HIGH_RES
+#include <SliderCentroid.h>
+#endif
+
+
+/*****************************************************************************
+* Static variables 
+*****************************************************************************/
+
+/* Values last written to the GATT DB for the RGB LED characteristic and 
+* the CCCDs, so that unchanged values are not written again */
+static ATTRIBUTE_MIRROR_T rgbLedMirror;
+static ATTRIBUTE_MIRROR_T capSenseSliderCccdMirror;
+#if CAPSENSE_REPORT
+static ATTRIBUTE_MIRROR_T capSenseReportCccdMirror;
+#endif
+#if SLIDER_GESTURES
+static ATTRIBUTE_MIRROR_T sliderGestureCccdMirror;
+#endif
+#if EVENT_TRACE
+static ATTRIBUTE_MIRROR_T eventTraceCccdMirror;
+#endif
+
+/*This flag is set when the Central device writes to CCC (Client Characteristic 
+* Configuration) of the CapSense slider Characteristic to enable notifications */
+uint8 sendCapSenseSliderNotifications = FALSE;	
+
+/* Array to store the present RGB LED control data. The 4 bytes 
+* of the array represents {R, G, B, Intensity} */
+uint8 RGBledData[4];
+
+#if RGB_WRITE_COMMAND
+/* Last color received by Write Command and not yet applied. Later commands
+* overwrite it, so the LED only ever shows the latest color. */
+static uint8 pendingRGBledData[4];
+static uint8 rgbWritePending = FALSE;
+#endif
+
+/* This flag is used by application to know whether a Central 
+* device has been connected. This is updated in BLE event callback 
+* function*/
+uint8 deviceConnected = FALSE;
+
+#if CAPSENSE_REPORT
+/* This flag is set when the Central device enables notifications on the
+* CapSense Report characteristic */
+uint8 sendCapSenseReportNotifications = FALSE;
+#endif
+
+#if SLIDER_GESTURES
+/* This flag is set when the Central device enables notifications on the
+* Slider Gesture characteristic */
+uint8 sendSliderGestureNotifications = FALSE;
+#endif
+
+#if EVENT_TRACE
+/* This flag is set when the Central device enables notifications on the
+* Event Trace characteristic to read the trace dump */
+static uint8 sendEventTraceNotifications = FALSE;
+#endif
+
+
+/*****************************************************************************
+* Static function prototypes
+*****************************************************************************/
+static void HandleRGBledWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair);
+#if RGB_ANIMATION
+static void HandleRgbAnimationWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair);
+#endif
+#if CAPSENSE_REPORT
+static void HandleCapSenseReportCccdWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair);
+#endif
+#if EVENT_TRACE
+static void HandleEventTraceCccdWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair);
+#endif
+
+
+/*****************************************************************************
+* Write dispatch table
+*****************************************************************************/
+/* Write handlers for the custom service attributes. Add an entry here for 
+* every new writable characteristic or descriptor. */
+static const WRITE_DISPATCH_ENTRY_T writeHandlers[] =
+{
+	/* RGB LED characteristic: {R, G, B, Intensity} */
+	{RGB_LED_SERVICE_INDEX, RGB_LED_CHAR_INDEX, WRITE_DISPATCH_CHAR_VALUE,
+	 sizeof(RGBledData), sizeof(RGBledData), HandleRGBledWrite, NULL, NULL},
+	
+#if RGB_ANIMATION
+	/* RGB Animation characteristic: control byte and keyframes */
+	{RGB_LED_SERVICE_INDEX, RGB_ANIMATION_CHAR_INDEX, WRITE_DISPATCH_CHAR_VALUE,
+	 RGB_ANIMATION_CONTROL_LEN, RGB_ANIMATION_MAX_WRITE_LEN, HandleRgbAnimationWrite, NULL, NULL},
+#endif
+	
+	/* CapSense slider CCCD: enables/disables the slider notifications */
+	{CAPSENSE_SERVICE_INDEX, CAPSENSE_SLIDER_CHAR_INDEX, CAPSENSE_SLIDER_CCC_INDEX,
+	 CCC_DATA_LEN, CCC_DATA_LEN, NULL, &sendCapSenseSliderNotifications, &capSenseSliderCccdMirror},
+	
+#if CAPSENSE_REPORT
+	/* CapSense Report CCCD: enables/disables the packed report notifications */
+	{CAPSENSE_SERVICE_INDEX, CAPSENSE_REPORT_CHAR_INDEX, CAPSENSE_REPORT_CCC_INDEX,
+	 CCC_DATA_LEN, CCC_DATA_LEN, HandleCapSenseReportCccdWrite, &sendCapSenseReportNotifications,
+	 &capSenseReportCccdMirror},
+#endif
+	
+#if SLIDER_GESTURES
+	/* Slider Gesture CCCD: enables/disables the gesture event notifications */
+	{CAPSENSE_SERVICE_INDEX, SLIDER_GESTURE_CHAR_INDEX, SLIDER_GESTURE_CCC_INDEX,
+	 CCC_DATA_LEN, CCC_DATA_LEN, NULL, &sendSliderGestureNotifications, &sliderGestureCccdMirror},
+#endif
+	
+#if EVENT_TRACE
+	/* Event Trace CCCD: enabling notifications starts the trace dump */
+	{EVENT_TRACE_SERVICE_INDEX, EVENT_TRACE_CHAR_INDEX, EVENT_TRACE_CCC_INDEX,
+	 CCC_DATA_LEN, CCC_DATA_LEN, HandleEventTraceCccdWrite, &sendEventTraceNotifications,
+	 &eventTraceCccdMirror},
+#endif
+};
+
+/* ATT MTU of the present connection. This is updated in BLE event callback
+* function when the Central device exchanges the MTU */
+static uint16 negotiatedMtu = CYBLE_GATT_DEFAULT_MTU;
+
+
+/*******************************************************************************
+* Function Name: RegisterWriteHandlers
+********************************************************************************
+* Summary:
+* Builds the write dispatch table from the writeHandlers list and binds the
+* attribute mirrors to their handles. Must be called once at startup, 
+* before the first write request can arrive.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RegisterWriteHandlers(void)
+{
+	AttributeMirror_Init(&rgbLedMirror, RGB_LED_CHAR_HANDLE, sizeof(RGBledData));
+	AttributeMirror_Init(&capSenseSliderCccdMirror, CAPSENSE_CCC_HANDLE, CCC_DATA_LEN);
+#if CAPSENSE_REPORT
+	AttributeMirror_Init(&capSenseReportCccdMirror, CAPSENSE_REPORT_CCC_HANDLE, CCC_DATA_LEN);
+#endif
+#if SLIDER_GESTURES
+	AttributeMirror_Init(&sliderGestureCccdMirror, SLIDER_GESTURE_CCC_HANDLE, CCC_DATA_LEN);
+#endif
+#if EVENT_TRACE
+	AttributeMirror_Init(&eventTraceCccdMirror, EVENT_TRACE_CCC_HANDLE, CCC_DATA_LEN);
+#endif
+	
+	WriteDispatcher_Init(writeHandlers, sizeof(writeHandlers) / sizeof(writeHandlers[0]));
+}
+
+
+/*******************************************************************************
+* Function Name: CustomEventHandler
+********************************************************************************
+* Summary:
+* Call back event function to handle various events from BLE stack
+*
+* Parameters:
+*  event:		event returned
+*  eventParam:	link to value of the events returned
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void CustomEventHandler(uint32 event, void * eventParam)
+{
+    /* Local variable to strore the write request parameters */
+	CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReqParam;
+    
+    /* Local variables to store the dispatch result and error response */
+	CYBLE_GATT_ERR_CODE_T writeResult;
+	CYBLE_GATTS_ERR_PARAM_T writeErrorParam;
+	
+#if RGB_WRITE_COMMAND
+	/* Local variable to store the write command parameters */
+	CYBLE_GATTS_WRITE_CMD_REQ_PARAM_T *wrCmdParam;
+#endif
+	
+	/* Local variable to store the Exchange MTU request parameters */
+	CYBLE_GATT_XCHG_MTU_PARAM_T *mtuReqParam;
+	
+	/* Record the event in the trace before it is handled */
+	EVENT_TRACE_BLE_EVENT(event, eventParam);
+   
+    switch(event)
+    {
+        case CYBLE_EVT_STACK_ON:
+        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
+			/* Start Advertisement and enter Discoverable mode*/
+			CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+			break;
+			
+		case CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP:
+			/* Set the BLE state variable to control LED status */
+            if(CYBLE_STATE_DISCONNECTED == CyBle_GetState())
+            {
+                /* Start Advertisement and enter Discoverable mode*/
+                CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+            }
+			break;
+			
+        case CYBLE_EVT_GATT_CONNECT_IND:
+			/* This flag is used in application to check connection status */
+			deviceConnected = TRUE;
+			
+			/* Every new connection starts with the default ATT MTU */
+			negotiatedMtu = CYBLE_GATT_DEFAULT_MTU;
+			break;
+		
+		case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
+			/* The stack responds with the MTU set in the BLE component. Keep
+			 * the smallest of the Central's MTU, the component MTU and 
+			 * MTU_XCHANGE_DATA_LEN as the MTU for this connection. */
+			mtuReqParam = (CYBLE_GATT_XCHG_MTU_PARAM_T *)eventParam;
+			negotiatedMtu = mtuReqParam->mtu;
+			
+			if(negotiatedMtu > CYBLE_GATT_MTU)
+			{
+				negotiatedMtu = CYBLE_GATT_MTU;
+			}
+			
+			if(negotiatedMtu > MTU_XCHANGE_DATA_LEN)
+			{
+				negotiatedMtu = MTU_XCHANGE_DATA_LEN;
+			}
+			break;
+        
+        case CYBLE_EVT_GATT_DISCONNECT_IND:
+			/* Update deviceConnected flag*/
+			deviceConnected = FALSE;
+			negotiatedMtu = CYBLE_GATT_DEFAULT_MTU;
+			
+			/* Reset CapSense notification flag to prevent further notifications
+			 * being sent to Central device after next connection. */
+			sendCapSenseSliderNotifications = FALSE;
+			
+			/* Write the CCCDs on the first write of the next connection */
+			AttributeMirror_Invalidate(&capSenseSliderCccdMirror);
+			
+	#if CAPSENSE_REPORT
+			sendCapSenseReportNotifications = FALSE;
+			AttributeMirror_Invalidate(&capSenseReportCccdMirror);
+	#endif
+			
+	#if SLIDER_GESTURES
+			sendSliderGestureNotifications = FALSE;
+			AttributeMirror_Invalidate(&sliderGestureCccdMirror);
+	#endif
+			
+	#if EVENT_TRACE
+			/* Stop a trace dump that was in progress */
+			sendEventTraceNotifications = FALSE;
+			EventTrace_SetNotification(false);
+			AttributeMirror_Invalidate(&eventTraceCccdMirror);
+	#endif
+			
+	#if RGB_ANIMATION
+			/* The LED is switched off below */
+			RgbAnimation_Stop();
+	#endif
+			
+	#if RGB_WRITE_COMMAND
+			/* Drop a color that arrived just before the link was lost */
+			rgbWritePending = FALSE;
+	#endif
+			
+			/* Reset the color coordinates */
+			RGBledData[RED_INDEX] = ZERO;
+            RGBledData[GREEN_INDEX] = ZERO;
+            RGBledData[BLUE_INDEX] = ZERO;
+            RGBledData[INTENSITY_INDEX] = ZERO;
+			UpdateRGBled();
+
+			break;
+        
+            
+        case CYBLE_EVT_GATTS_WRITE_REQ: 							
+            /* This event is received when Central device sends a Write command 
+             * on an Attribute. 
+             * The attribute handle from the event parameter indexes the 
+             * dispatch table built by RegisterWriteHandlers(), which checks 
+             * the value length and calls the handler for that attribute.
+             */
+            wrReqParam = (CYBLE_GATTS_WRITE_REQ_PARAM_T *) eventParam;
+            
+            writeResult = WriteDispatcher_Dispatch(&wrReqParam->handleValPair);
+			
+			if(CYBLE_GATT_ERR_NONE == writeResult)
+			{
+				/* Send the response to the write request received. */
+				CyBle_GattsWriteRsp(cyBle_connHandle);
+			}
+			else
+			{
+				/* Reject the write with the error from the dispatcher */
+				writeErrorParam.attrHandle = wrReqParam->handleValPair.attrHandle;
+				writeErrorParam.opcode = CYBLE_GATT_WRITE_REQ;
+				writeErrorParam.errorCode = writeResult;
+				CyBle_GattsErrorRsp(cyBle_connHandle, &writeErrorParam);
+			}
+			
+			break;
+			
+	#if RGB_WRITE_COMMAND
+		case CYBLE_EVT_GATTS_WRITE_CMD_REQ:
+			/* Write Command, i.e. write without response, to the RGB LED 
+			 * characteristic. Nothing is sent back, so the Central can send
+			 * several colors per connection event. Only the latest one is
+			 * kept; ApplyPendingRGBled() shows it from the main loop. 
+			 * Commands to any other attribute are ignored. */
+			wrCmdParam = (CYBLE_GATTS_WRITE_CMD_REQ_PARAM_T *) eventParam;
+			
+			if((RGB_LED_CHAR_HANDLE == wrCmdParam->handleValPair.attrHandle) &&
+			   (sizeof(pendingRGBledData) == wrCmdParam->handleValPair.value.len))
+			{
+				memcpy(pendingRGBledData, wrCmdParam->handleValPair.value.val, sizeof(pendingRGBledData));
+				rgbWritePending = TRUE;
+			}
+			break;
+	#endif
+
+        default:
+
+       	 	break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: HandleRGBledWrite
+********************************************************************************
+* Summary:
+* Write handler for the RGB LED characteristic. Extracts the color and 
+* intensity written by the Central device and drives the RGB LED.
+*
+* Parameters:
+*  handleValPair:	Attribute handle and value written
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void HandleRGBledWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair)
+{
+#if RGB_ANIMATION
+	/* A color written directly replaces a running animation */
+	RgbAnimation_Stop();
+#endif
+	
+	/* Extract the value of the attribute from the handle-value pair */
+	RGBledData[RED_INDEX] = handleValPair->value.val[RED_INDEX];
+	RGBledData[GREEN_INDEX] = handleValPair->value.val[GREEN_INDEX];
+	RGBledData[BLUE_INDEX] = handleValPair->value.val[BLUE_INDEX];
+	RGBledData[INTENSITY_INDEX] = handleValPair->value.val[INTENSITY_INDEX];
+	
+	/* Update the PrISM components and the attribute for RGB LED read 
+	 * characteristics */
+	UpdateRGBled();
+}
+
+
+#if RGB_ANIMATION
+/*******************************************************************************
+* Function Name: HandleRgbAnimationWrite
+********************************************************************************
+* Summary:
+* Write handler for the RGB Animation characteristic. Passes the keyframes 
+* to the animation engine, which plays them from the main loop.
+*
+* Parameters:
+*  handleValPair:	Attribute handle and value written
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void HandleRgbAnimationWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair)
+{
+	RgbAnimation_Load(handleValPair->value.val, handleValPair->value.len);
+}
+#endif
+
+
+#if CAPSENSE_REPORT
+/*******************************************************************************
+* Function Name: HandleCapSenseReportCccdWrite
+********************************************************************************
+* Summary:
+* Write handler for the CapSense Report CCCD. The dispatcher has already 
+* updated sendCapSenseReportNotifications; reports queued before the 
+* notifications were enabled are dropped.
+*
+* Parameters:
+*  handleValPair:	Attribute handle and value written
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void HandleCapSenseReportCccdWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair)
+{
+	(void)handleValPair;
+	
+	CapSenseReport_Reset();
+}
+#endif
+
+
+#if EVENT_TRACE
+/*******************************************************************************
+* Function Name: HandleEventTraceCccdWrite
+********************************************************************************
+* Summary:
+* Write handler for the Event Trace CCCD. The dispatcher has already updated 
+* sendEventTraceNotifications; enabling notifications starts a dump of the 
+* records in the trace, disabling them stops it.
+*
+* Parameters:
+*  handleValPair:	Attribute handle and value written
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void HandleEventTraceCccdWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair)
+{
+	(void)handleValPair;
+	
+	EventTrace_SetNotification(TRUE == sendEventTraceNotifications);
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: SendCapSenseNotification
+********************************************************************************
+* Summary:
+* Send CapSense Slider data as BLE Notifications. This function updates
+* the notification handle with data and triggers the BLE component to send 
+* notification
+*
+* Parameters:
+*  CapSenseSliderData:	CapSense slider value	
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void SendCapSenseNotification(uint8 CapSenseSliderData)
+{
+	/* 'CapSensenotificationHandle' stores CapSense notification data parameters */
+	CYBLE_GATTS_HANDLE_VALUE_NTF_T		CapSensenotificationHandle;	
+	
+	/* Update notification handle with CapSense slider data*/
+	CapSensenotificationHandle.attrHandle = CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CHAR_HANDLE;				
+	CapSensenotificationHandle.value.val = &CapSenseSliderData;
+	CapSensenotificationHandle.value.len = sizeof(CapSenseSliderData);
+	
+	/* Send notifications. */
+	CyBle_GattsNotification(cyBle_connHandle, &CapSensenotificationHandle);
+}
+
+
+#if SLIDER_HIGH_RES
+/*******************************************************************************
+* Function Name: SendCapSenseHighResNotification
+********************************************************************************
+* Summary:
+* Send a high-resolution slider position and velocity as BLE Notification 
+* of the slider characteristic, in the layout of SliderCentroid.h.
+*
+* Parameters:
+*  position:	Slider position, or NO_FINGER
+*  velocity:	Velocity in 1/256 position per scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void SendCapSenseHighResNotification(uint16 position, int16 velocity)
+{
+	/* 'CapSensenotificationHandle' stores CapSense notification data parameters */
+	CYBLE_GATTS_HANDLE_VALUE_NTF_T		CapSensenotificationHandle;	
+	uint8 sliderData[SLIDER_HIGH_RES_REPORT_LEN];
+	
+	sliderData[0] = LO8(position);
+	sliderData[1] = HI8(position);
+	sliderData[2] = LO8((uint16)velocity);
+	sliderData[3] = HI8((uint16)velocity);
+	
+	/* Update notification handle with CapSense slider data*/
+	CapSensenotificationHandle.attrHandle = CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CHAR_HANDLE;				
+	CapSensenotificationHandle.value.val = sliderData;
+	CapSensenotificationHandle.value.len = sizeof(sliderData);
+	
+	/* Send notifications. */
+	CyBle_GattsNotification(cyBle_connHandle, &CapSensenotificationHandle);
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: GetNegotiatedMtu
+********************************************************************************
+* Summary:
+* Returns the ATT MTU of the present connection. This is the default 23 
+* bytes until the Central device sends an Exchange MTU request.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint16: Negotiated ATT MTU in bytes
+*
+*******************************************************************************/
+uint16 GetNegotiatedMtu(void)
+{
+	return negotiatedMtu;
+}
+
+
+/*******************************************************************************
+* Function Name: GetNotificationPayloadLen
+********************************************************************************
+* Summary:
+* Returns the largest value that fits in one notification on the present 
+* connection, so that senders can pack as much data as possible into each
+* packet.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint16: Notification payload length in bytes
+*
+*******************************************************************************/
+uint16 GetNotificationPayloadLen(void)
+{
+	return negotiatedMtu - ATT_NOTIFICATION_HEADER_LEN;
+}
+
+
+#if SLIDER_COMPRESSION
+/*******************************************************************************
+* Function Name: SendCapSenseBlockNotification
+********************************************************************************
+* Summary:
+* Send a compressed block of CapSense Slider positions as one BLE 
+* Notification. The block is a sequence number followed by the output of 
+* SampleCodec_EncodeBlock().
+*
+* Parameters:
+*  blockData:	Sequence number and encoded block
+*  blockLen:	Length of the block in bytes
+*
+* Return:
+*  CYBLE_API_RESULT_T: Result of CyBle_GattsNotification()
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T SendCapSenseBlockNotification(uint8 *blockData, uint16 blockLen)
+{
+	/* 'CapSensenotificationHandle' stores CapSense notification data parameters */
+	CYBLE_GATTS_HANDLE_VALUE_NTF_T		CapSensenotificationHandle;	
+	
+	/* Update notification handle with the encoded slider block */
+	CapSensenotificationHandle.attrHandle = CAPSENSE_SLIDER_CHAR_HANDLE;
+	CapSensenotificationHandle.value.val = blockData;
+	CapSensenotificationHandle.value.len = blockLen;
+	
+	/* Send notifications. */
+	return CyBle_GattsNotification(cyBle_connHandle, &CapSensenotificationHandle);
+}
+#endif
+
+
+#if CAPSENSE_REPORT
+/*******************************************************************************
+* Function Name: SendCapSenseReportNotification
+********************************************************************************
+* Summary:
+* Send a batch of packed CapSense reports as one BLE Notification. The 
+* reports are built by CapSenseReport_SendPending().
+*
+* Parameters:
+*  reportData:	Packed reports
+*  reportLen:	Length of the reports in bytes
+*
+* Return:
+*  CYBLE_API_RESULT_T: Result of CyBle_GattsNotification()
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T SendCapSenseReportNotification(uint8 *reportData, uint16 reportLen)
+{
+	/* 'CapSensenotificationHandle' stores CapSense notification data parameters */
+	CYBLE_GATTS_HANDLE_VALUE_NTF_T		CapSensenotificationHandle;	
+	
+	/* Update notification handle with the packed reports */
+	CapSensenotificationHandle.attrHandle = CAPSENSE_REPORT_CHAR_HANDLE;
+	CapSensenotificationHandle.value.val = reportData;
+	CapSensenotificationHandle.value.len = reportLen;
+	
+	/* Send notifications. */
+	return CyBle_GattsNotification(cyBle_connHandle, &CapSensenotificationHandle);
+}
+#endif
+
+
+#if SLIDER_GESTURES
+/*******************************************************************************
+* Function Name: SendSliderGestureNotification
+********************************************************************************
+* Summary:
+* Send a slider gesture event as BLE Notification. The event is built by 
+* SliderGesture_Update().
+*
+* Parameters:
+*  eventData:	Packed gesture event
+*  eventLen:	Length of the event in bytes
+*
+* Return:
+*  CYBLE_API_RESULT_T: Result of CyBle_GattsNotification()
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T SendSliderGestureNotification(uint8 *eventData, uint16 eventLen)
+{
+	/* 'gestureNotificationHandle' stores gesture notification data parameters */
+	CYBLE_GATTS_HANDLE_VALUE_NTF_T		gestureNotificationHandle;	
+	
+	/* Update notification handle with the gesture event */
+	gestureNotificationHandle.attrHandle = SLIDER_GESTURE_CHAR_HANDLE;
+	gestureNotificationHandle.value.val = eventData;
+	gestureNotificationHandle.value.len = eventLen;
+	
+	/* Send notifications. */
+	return CyBle_GattsNotification(cyBle_connHandle, &gestureNotificationHandle);
+}
+#endif
+
+
+#if RGB_WRITE_COMMAND
+/*******************************************************************************
+* Function Name: ApplyPendingRGBled
+********************************************************************************
+* Summary:
+* Shows the latest color received by Write Command, if there is one. Called 
+* from the main loop after CyBle_ProcessEvents(), so the PrISMs and the GATT
+* database are updated once however many commands arrived in between.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ApplyPendingRGBled(void)
+{
+	if(TRUE == rgbWritePending)
+	{
+		rgbWritePending = FALSE;
+		
+	#if RGB_ANIMATION
+		/* A color written directly replaces a running animation */
+		RgbAnimation_Stop();
+	#endif
+		
+		memcpy(RGBledData, pendingRGBledData, sizeof(RGBledData));
+		UpdateRGBled();
+	}
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: DriveRGBled
+********************************************************************************
+* Summary:
+* Sets the PrISM densities for a color without touching the GATT database.
+* Used for every step of an animation, where only the final color is 
+* written to the RGB LED characteristic. The PrISM registers are left alone
+* when the densities are the ones already set.
+*
+* Parameters:
+*  rgbData:	{R, G, B, Intensity} to show
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void DriveRGBled(const uint8 *rgbData)
+{
+	/* LED densities calculated from the RGB data */
+	uint8 density[RGB_COLOR_CHANNELS];
+	
+	/* Densities in the PrISM registers */
+	static uint8 drivenDensity[RGB_COLOR_CHANNELS];
+	static uint8 drivenValid = FALSE;
+	
+	RgbColor_Convert(rgbData, density);
+	
+	if((TRUE == drivenValid) && (0 == memcmp(drivenDensity, density, sizeof(density))))
+	{
+		return;
+	}
+	memcpy(drivenDensity, density, sizeof(density));
+	drivenValid = TRUE;
+	
+	PRS_1_WritePulse0(RGB_LED_MAX_VAL - density[RED_INDEX]);
+    PRS_1_WritePulse1(RGB_LED_MAX_VAL - density[GREEN_INDEX]);
+    PRS_2_WritePulse0(RGB_LED_MAX_VAL - density[BLUE_INDEX]);
+}
+
+
+/*******************************************************************************
+* Function Name: UpdateRGBled
+********************************************************************************
+* Summary:
+* Receive the new RGB data and modify PrISM parameters. Also, update the
+* read characteristic handle so that the next read from the BLE central device
+* gives present RGB color and intensity data. Neither is written when the 
+* value is unchanged.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void UpdateRGBled(void)
+{
+	/* Update the density value of the PrISM module for color control*/
+	DriveRGBled(RGBledData);
+	
+	/* Update the attribute for read by central device if it changed */
+	(void)AttributeMirror_Commit(&rgbLedMirror, RGBledData);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,217 @@
+/*****************************************************************************
+* File Name: BaselineManager.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the CapSense baseline update scheduler implemented as 
+* part of the PSoC 4 BLE Lab 4. The signal of every sensor is still 
+* computed on every scan; the scheduler only decides on which scans each 
+* sensor also runs the baseline filter step of the CapSense component.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <BaselineManager.h>
+
+
+#if BASELINE_MANAGER
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: BaselineManager_Init
+********************************************************************************
+* Summary:
+* Sets the scheduler configuration and clears its state and counters.
+*
+* Parameters:
+*  manager:           Scheduler to initialize
+*  sensorCount:       Sensors to schedule, up to BASELINE_MANAGER_MAX_SENSORS
+*  idleIntervalScans: Scans between baseline updates while no sensor is 
+*                     touched
+*  driftThreshold:    Difference count that every untouched sensor reaching
+*                     it the same way is drift. Keep it below the noise 
+*                     threshold, above which the component's filter does 
+*                     not move.
+*  fastScans:         Scans a drifting sensor is updated on every scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void BaselineManager_Init(BASELINE_MANAGER_T *manager, uint8 sensorCount, uint16 idleIntervalScans,
+                          uint16 driftThreshold, uint16 fastScans)
+{
+    manager->sensorCount = (sensorCount < BASELINE_MANAGER_MAX_SENSORS) ? sensorCount : BASELINE_MANAGER_MAX_SENSORS;
+    manager->idleIntervalScans = (idleIntervalScans > 0u) ? idleIntervalScans : 1u;
+    manager->driftThreshold = driftThreshold;
+    manager->fastScans = fastScans;
+    
+    manager->idleScan = 0;
+    manager->fastScansLeft = 0;
+    manager->touched = FALSE;
+    manager->wideTouch = FALSE;
+    
+    manager->updateCount = 0;
+    manager->skipCount = 0;
+    manager->driftEvents = 0;
+    manager->touchCount = 0;
+    manager->falseTouchCount = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: BaselineManager_Schedule
+********************************************************************************
+* Summary:
+* Decides which sensors run the baseline filter step on this scan.
+*
+* While any sensor is at or above its finger threshold, no baseline is 
+* updated, so a slow touch is not absorbed. A touch that reaches every 
+* sensor at once is counted as a false touch: it is drift or a palm, and 
+* it is not absorbed either.
+*
+* While idle, every sensor is updated on one scan in idleIntervalScans, 
+* the sensors on different scans so that the work is spread out. When the
+* difference counts of all sensors reach driftThreshold the same way, 
+* every sensor is updated on every scan for the next fastScans scans, so 
+* the baselines follow at the full rate of the filter before the 
+* differences leave the noise band. A finger rising slowly on a few 
+* sensors is not drift and does not speed up its own absorption.
+*
+* Parameters:
+*  manager:          Scheduler state
+*  diffCounts:       Raw count minus baseline of every sensor, signed
+*  fingerThresholds: Finger threshold of every sensor
+*
+* Return:
+*  uint16: Bit n set if sensor n runs the baseline filter step
+*
+*******************************************************************************/
+uint16 BaselineManager_Schedule(BASELINE_MANAGER_T *manager, const int16 *diffCounts, 
+                                const uint16 *fingerThresholds)
+{
+    uint16 updateMask = 0;
+    uint8 touchedSensors = 0;
+    uint8 risenSensors = 0;
+    uint8 fallenSensors = 0;
+    uint8 sensor;
+    
+    for(sensor = 0; sensor < manager->sensorCount; sensor++)
+    {
+        if(diffCounts[sensor] >= (int16)fingerThresholds[sensor])
+        {
+            touchedSensors++;
+        }
+        
+        if(diffCounts[sensor] >= (int16)manager->driftThreshold)
+        {
+            risenSensors++;
+        }
+        else if(diffCounts[sensor] <= -(int16)manager->driftThreshold)
+        {
+            fallenSensors++;
+        }
+    }
+    
+    if(touchedSensors != 0u)
+    {
+        if(FALSE == manager->touched)
+        {
+            manager->touched = TRUE;
+            manager->wideTouch = FALSE;
+            manager->touchCount++;
+        }
+        
+        if((touchedSensors == manager->sensorCount) && (FALSE == manager->wideTouch))
+        {
+            manager->wideTouch = TRUE;
+            manager->falseTouchCount++;
+        }
+        
+        manager->skipCount += manager->sensorCount;
+        return 0u;
+    }
+    manager->touched = FALSE;
+    
+    if((risenSensors == manager->sensorCount) || (fallenSensors == manager->sensorCount))
+    {
+        if(manager->fastScansLeft == 0u)
+        {
+            manager->driftEvents++;
+        }
+        manager->fastScansLeft = manager->fastScans;
+    }
+    
+    if(manager->fastScansLeft != 0u)
+    {
+        manager->fastScansLeft--;
+        updateMask = (uint16)((1u << manager->sensorCount) - 1u);
+        manager->updateCount += manager->sensorCount;
+    }
+    else
+    {
+        /* Sensor n is due on scans n, n + idleIntervalScans, ... */
+        for(sensor = 0; sensor < manager->sensorCount; sensor++)
+        {
+            if((sensor % manager->idleIntervalScans) == manager->idleScan)
+            {
+                updateMask |= (uint16)(1u << sensor);
+                manager->updateCount++;
+            }
+            else
+            {
+                manager->skipCount++;
+            }
+        }
+    }
+    
+    manager->idleScan++;
+    if(manager->idleScan >= manager->idleIntervalScans)
+    {
+        manager->idleScan = 0;
+    }
+    
+    return updateMask;
+}
+
+#endif  /* #if BASELINE_MANAGER */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/*****************************************************************************
+* File Name: BaselineManager.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the CapSense baseline update scheduler implemented as
+* part of the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_BASELINE_MANAGER_H)
+#define _BASELINE_MANAGER_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* Most sensors a manager schedules, one bit each in the update mask */
+#define BASELINE_MANAGER_MAX_SENSORS    (16u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* Configuration, set by BaselineManager_Init() */
+    uint8 sensorCount;
+    uint16 idleIntervalScans;   /* Scans between updates while idle */
+    uint16 driftThreshold;      /* Difference count of all sensors that is drift */
+    uint16 fastScans;           /* Scans updated every scan after drift */
+    
+    /* Scheduler state */
+    uint16 idleScan;
+    uint16 fastScansLeft;
+    uint8 touched;
+    uint8 wideTouch;
+    
+    /* Baseline filter steps run and skipped; every skipped step is the 
+     * cycles of the filter saved */
+    uint32 updateCount;
+    uint32 skipCount;
+    
+    /* Drift detections, touches, and touches that covered every sensor, 
+     * which a finger on the slider cannot do */
+    uint32 driftEvents;
+    uint32 touchCount;
+    uint32 falseTouchCount;
+} BASELINE_MANAGER_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void BaselineManager_Init(BASELINE_MANAGER_T *manager, uint8 sensorCount, uint16 idleIntervalScans,
+                          uint16 driftThreshold, uint16 fastScans);
+uint16 BaselineManager_Schedule(BASELINE_MANAGER_T *manager, const int16 *diffCounts, 
+                                const uint16 *fingerThresholds);
+
+
+#endif  /* #if !defined(_BASELINE_MANAGER_H) */
+
+/* [] END OF FILE */
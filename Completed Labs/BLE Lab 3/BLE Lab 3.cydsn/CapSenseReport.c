@@ -0,0 +1,197 @@
+/*****************************************************************************
+* File Name: CapSenseReport.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the packed CapSense report in the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <string.h>
+#include <main.h>
+#include <BLEApplications.h>
+#include <WatchdogTimer.h>
+#include <CapSenseReport.h>
+
+
+#if CAPSENSE_REPORT
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* Reports queued for sending. Must be a power of two. */
+#define REPORT_QUEUE_SIZE               (16u)
+#define REPORT_QUEUE_MASK               (REPORT_QUEUE_SIZE - 1u)
+
+/* A partly filled notification is sent once its oldest report is this old */
+#define REPORT_MAX_DELAY_MS             (50u)
+
+
+/*****************************************************************************
+* Static variables 
+*****************************************************************************/
+static uint8 reportQueue[REPORT_QUEUE_SIZE][CAPSENSE_REPORT_LEN];
+static uint8 reportHead = 0;
+static uint8 reportTail = 0;
+
+/* Time each queued report was taken, for the send delay */
+static uint32 reportTime[REPORT_QUEUE_SIZE];
+
+static uint8 reportSequence = 0;
+
+static uint8 reportPacket[MTU_XCHANGE_DATA_LEN - ATT_NOTIFICATION_HEADER_LEN];
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: CapSenseReport_Reset
+********************************************************************************
+* Summary:
+* Drops the queued reports. Called when the central enables the report 
+* notifications, so that it does not receive stale reports.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void CapSenseReport_Reset(void)
+{
+	reportTail = reportHead;
+}
+
+
+/*******************************************************************************
+* Function Name: CapSenseReport_Queue
+********************************************************************************
+* Summary:
+* Packs the results of one CapSense scan into a report and queues it. If the
+* queue is full the oldest report is dropped; the central sees the gap in 
+* the sequence numbers.
+*
+* Parameters:
+*  sliderPosition: Slider centroid, or NO_FINGER
+*  proximity:      Proximity sensor difference count
+*  buttons:        Button bitmap
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void CapSenseReport_Queue(uint16 sliderPosition, uint16 proximity, uint8 buttons)
+{
+	uint8 *report = reportQueue[reportHead & REPORT_QUEUE_MASK];
+	uint32 timestamp = WatchdogTimer_GetTimestamp();
+	
+	report[0] = reportSequence++;
+	report[1] = LO8(LO16(timestamp));
+	report[2] = HI8(LO16(timestamp));
+	report[3] = LO8(sliderPosition);
+	report[4] = HI8(sliderPosition);
+	report[5] = LO8(proximity);
+	report[6] = HI8(proximity);
+	report[7] = buttons;
+	reportTime[reportHead & REPORT_QUEUE_MASK] = timestamp;
+	reportHead++;
+	
+	if((uint8)(reportHead - reportTail) > REPORT_QUEUE_SIZE)
+	{
+		reportTail++;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: CapSenseReport_SendPending
+********************************************************************************
+* Summary:
+* Sends the queued reports, batched into as few notifications as possible.
+* A notification is sent when the queued reports fill the negotiated 
+* payload, or when the oldest one has waited REPORT_MAX_DELAY_MS.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void CapSenseReport_SendPending(void)
+{
+	uint8 reportsPerPacket;
+	uint8 queued;
+	uint8 count;
+	uint8 index;
+	
+	reportsPerPacket = (uint8)(GetNotificationPayloadLen() / CAPSENSE_REPORT_LEN);
+	
+	while((reportTail != reportHead) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+	{
+		queued = (uint8)(reportHead - reportTail);
+		
+		if((queued < reportsPerPacket) &&
+		   ((WatchdogTimer_GetTimestamp() - reportTime[reportTail & REPORT_QUEUE_MASK]) < REPORT_MAX_DELAY_MS))
+		{
+			break;
+		}
+		
+		count = (queued < reportsPerPacket) ? queued : reportsPerPacket;
+		
+		for(index = 0; index < count; index++)
+		{
+			memcpy(&reportPacket[index * CAPSENSE_REPORT_LEN], 
+			       reportQueue[(reportTail + index) & REPORT_QUEUE_MASK], CAPSENSE_REPORT_LEN);
+		}
+		
+		if(SendCapSenseReportNotification(reportPacket, count * CAPSENSE_REPORT_LEN) != CYBLE_ERROR_OK)
+		{
+			break;
+		}
+		
+		reportTail += count;
+	}
+}
+
+#endif  /* #if CAPSENSE_REPORT */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,79 @@
+/*****************************************************************************
+* File Name: CapSenseReport.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the packed CapSense report implemented as part of the
+* PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_CAPSENSE_REPORT_H)
+#define _CAPSENSE_REPORT_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* One report is 8 bytes, little-endian:
+*
+*  Offset  Length  Field
+*  0       1       Sequence number, incremented for every report
+*  1       2       Timestamp in ms, lower 16 bits of the watchdog timestamp
+*  3       2       Slider centroid, 0xFFFF when no finger is on the slider
+*  5       2       Proximity sensor difference count, 0 if not in the design
+*  7       1       Button bitmap, bit n set while CapSense button n is touched
+*
+* A notification carries as many complete reports as fit in the negotiated
+* payload, oldest first.
+*/
+#define CAPSENSE_REPORT_LEN             (8u)
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void CapSenseReport_Reset(void);
+void CapSenseReport_Queue(uint16 sliderPosition, uint16 proximity, uint8 buttons);
+void CapSenseReport_SendPending(void);
+
+
+#endif  /* #if !defined(_CAPSENSE_REPORT_H) */
+
+/* [] END OF FILE */
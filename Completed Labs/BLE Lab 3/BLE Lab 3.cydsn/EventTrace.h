@@ -0,0 +1,107 @@
+/*****************************************************************************
+* File Name: EventTrace.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the functions for the BLE event trace implemented as part
+* of the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_EVENT_TRACE_H)
+#define _EVENT_TRACE_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include <main.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Handles generated by the BLE component for the custom Event Trace 
+ * service. The service has one "Event Trace" characteristic with the Notify
+ * property and its Client Characteristic Configuration descriptor.
+ */
+#define EVENT_TRACE_CHAR_HANDLE             (CYBLE_EVENT_TRACE_SERVICE_EVENT_TRACE_CHAR_HANDLE)
+#define EVENT_TRACE_CCC_HANDLE              (CYBLE_EVENT_TRACE_SERVICE_EVENT_TRACE_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+
+/* Indexes of the same attributes, used by the write dispatch table */
+#define EVENT_TRACE_SERVICE_INDEX           (CYBLE_EVENT_TRACE_SERVICE_SERVICE_INDEX)
+#define EVENT_TRACE_CHAR_INDEX              (CYBLE_EVENT_TRACE_SERVICE_EVENT_TRACE_CHAR_INDEX)
+#define EVENT_TRACE_CCC_INDEX               (CYBLE_EVENT_TRACE_SERVICE_EVENT_TRACE_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX)
+
+/* Size of one record in the dump, see EVENT_TRACE_RECORD_T */
+#define EVENT_TRACE_RECORD_LEN              (8u)
+
+/* Records a BLE event in the trace. Compiles to nothing unless the 
+ * EVENT_TRACE option is enabled in main.h.
+ */
+#if EVENT_TRACE
+#define EVENT_TRACE_BLE_EVENT(event, eventParam) \
+            EventTrace_Record((event), EventTrace_GetPayload((event), (eventParam)))
+#else
+#define EVENT_TRACE_BLE_EVENT(event, eventParam)
+#endif
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+/* Trace record. The dump sends each record as 8 little-endian bytes in 
+ * this field order.
+ */
+typedef struct
+{
+    uint32 timestamp;       /* Watchdog timer timestamp in ms */
+    uint16 eventId;         /* Lower 16 bits of the CYBLE_EVT_* code */
+    uint16 payload;         /* Event specific, see EventTrace_GetPayload() */
+} EVENT_TRACE_RECORD_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+extern void EventTrace_Record(uint32 event, uint16 payload);
+extern uint16 EventTrace_GetPayload(uint32 event, void *eventParam);
+extern void EventTrace_SetNotification(bool enable);
+extern void EventTrace_SendPending(void);
+
+
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,190 @@
+/*****************************************************************************
+* File Name: NotifyFilter.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the notification rate limiter for CapSense values in
+* the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <NotifyFilter.h>
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: NotifyFilter_Init
+********************************************************************************
+* Summary:
+* Sets the filter configuration and clears its state and counters. A filter
+* with all parameters zero sends every change, like having no filter.
+*
+* Parameters:
+*  filter:           Filter to initialize
+*  deadband:         Largest change from the last sent value that is not sent
+*  hysteresis:       Extra change needed when the value reverses direction
+*  minIntervalScans: Minimum number of scans between two notifications
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void NotifyFilter_Init(NOTIFY_FILTER_T *filter, uint16 deadband, uint16 hysteresis, uint16 minIntervalScans)
+{
+    filter->deadband = deadband;
+    filter->hysteresis = hysteresis;
+    filter->minIntervalScans = minIntervalScans;
+    filter->lastSent = 0;
+    filter->lastValue = 0;
+    filter->scansSinceSent = 0;
+    filter->lastDirection = 0;
+    filter->touched = FALSE;
+    filter->sentCount = 0;
+    filter->suppressedCount = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: NotifyFilter_Update
+********************************************************************************
+* Summary:
+* Runs one scan result through the filter and decides whether to notify it.
+*
+* While touched, a value is sent when it differs from the last sent value by
+* more than the deadband, plus the hysteresis if it moves back the way it 
+* came, and at least minIntervalScans scans have passed. The first value of
+* a touch is sent at once. On release the last touched value is flushed if 
+* it was held back, then the release value is sent, both without waiting 
+* for the interval.
+*
+* Parameters:
+*  filter:    Filter state
+*  value:     Present scan result
+*  released:  TRUE if value means "not touched" (NO_FINGER, no proximity)
+*  sendValue: Returns the value to notify
+*
+* Return:
+*  uint8: TRUE if *sendValue should be sent now
+*
+*******************************************************************************/
+uint8 NotifyFilter_Update(NOTIFY_FILTER_T *filter, uint16 value, uint8 released, uint16 *sendValue)
+{
+    uint16 change;
+    uint16 threshold;
+    int8 direction;
+    
+    if(filter->scansSinceSent < 0xFFFFu)
+    {
+        filter->scansSinceSent++;
+    }
+    
+    if(released)
+    {
+        if(filter->touched && (filter->lastValue != filter->lastSent))
+        {
+            /* Flush the final touched value first */
+            *sendValue = filter->lastValue;
+        }
+        else
+        {
+            filter->touched = FALSE;
+            
+            if(value == filter->lastSent)
+            {
+                return FALSE;
+            }
+            
+            *sendValue = value;
+        }
+    }
+    else if(!filter->touched)
+    {
+        /* First value of a new touch */
+        filter->touched = TRUE;
+        filter->lastValue = value;
+        filter->lastDirection = 0;
+        *sendValue = value;
+    }
+    else
+    {
+        filter->lastValue = value;
+        
+        if(value == filter->lastSent)
+        {
+            return FALSE;
+        }
+        
+        if(value > filter->lastSent)
+        {
+            change = value - filter->lastSent;
+            direction = 1;
+        }
+        else
+        {
+            change = filter->lastSent - value;
+            direction = -1;
+        }
+        
+        threshold = filter->deadband;
+        
+        if(direction == -filter->lastDirection)
+        {
+            threshold += filter->hysteresis;
+        }
+        
+        if((change <= threshold) || (filter->scansSinceSent < filter->minIntervalScans))
+        {
+            filter->suppressedCount++;
+            return FALSE;
+        }
+        
+        filter->lastDirection = direction;
+        *sendValue = value;
+    }
+    
+    filter->lastSent = *sendValue;
+    filter->scansSinceSent = 0;
+    filter->sentCount++;
+    return TRUE;
+}
+
+
+/* [] END OF FILE */
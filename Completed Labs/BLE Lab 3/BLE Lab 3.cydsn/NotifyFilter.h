@@ -0,0 +1,83 @@
+/*****************************************************************************
+* File Name: NotifyFilter.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the notification rate limiter for CapSense values
+* implemented as part of the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_NOTIFY_FILTER_H)
+#define _NOTIFY_FILTER_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* Configuration, set by NotifyFilter_Init() */
+    uint16 deadband;            /* Changes up to this size are not sent */
+    uint16 hysteresis;          /* Extra change needed to reverse direction */
+    uint16 minIntervalScans;    /* Scans between two notifications */
+    
+    /* Filter state */
+    uint16 lastSent;
+    uint16 lastValue;
+    uint16 scansSinceSent;
+    int8 lastDirection;
+    uint8 touched;
+    
+    /* Counters of changed values sent and suppressed */
+    uint32 sentCount;
+    uint32 suppressedCount;
+} NOTIFY_FILTER_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void NotifyFilter_Init(NOTIFY_FILTER_T *filter, uint16 deadband, uint16 hysteresis, uint16 minIntervalScans);
+uint8 NotifyFilter_Update(NOTIFY_FILTER_T *filter, uint16 value, uint8 released, uint16 *sendValue);
+
+
+#endif  /* #if !defined(_NOTIFY_FILTER_H) */
+
+/* [] END OF FILE */
@@ -0,0 +1,435 @@
+/*****************************************************************************
+* File Name: RgbAnimation.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the RGB LED animation engine implemented as part of the
+* PSoC 4 BLE Lab 4. The Central device uploads a keyframe list once and the
+* engine fades the LED between the keyframes on the watchdog timer, so the
+* animation needs no further BLE traffic.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <BLEApplications.h>
+#include <RgbColor.h>
+#include <WatchdogTimer.h>
+#include <RgbAnimation.h>
+
+
+#if RGB_ANIMATION
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* Keyframe progress is 0..255, computed from 1/duration in this many 
+ * fraction bits so that every update is a multiply and a shift */
+#define PROGRESS_FRAC_BITS              (16u)
+#define PROGRESS_MAX                    (255u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    uint8 color[RGB_COLOR_CHANNELS + 1u];   /* R, G, B, intensity */
+    uint16 duration;                        /* ms to reach the color */
+    uint8 easing;
+} RGB_KEYFRAME_T;
+
+
+/*****************************************************************************
+* Static variables 
+*****************************************************************************/
+static RGB_KEYFRAME_T keyframes[RGB_ANIMATION_MAX_KEYFRAMES];
+static uint8 keyframeCount = 0;
+static uint8 loopCount = 0;
+
+/* Playback state, mirrored in the RGB Animation State characteristic */
+static uint8 animationState = RGB_ANIMATION_STOPPED;
+static uint8 keyframeIndex = 0;
+static uint8 loopsCompleted = 0;
+
+/* Present keyframe: start color, start time and 1/duration */
+static uint8 fromColor[RGB_COLOR_CHANNELS + 1u];
+static uint32 keyframeStart = 0;
+static uint32 keyframeRate = 0;
+
+/* Color last driven on the LED */
+static uint8 displayColor[RGB_COLOR_CHANNELS + 1u];
+static uint32 lastUpdate = 0;
+
+
+/*****************************************************************************
+* Static function prototypes
+*****************************************************************************/
+static void StartKeyframe(uint32 startTime);
+static uint8 ApplyEasing(uint8 progress, uint8 easing);
+static void UpdateStateAttribute(void);
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: RgbAnimation_Load
+********************************************************************************
+* Summary:
+* Adds the keyframes of a write to the RGB Animation characteristic and 
+* starts playback from the present LED color once the last write of the 
+* list has arrived. Keyframes beyond RGB_ANIMATION_MAX_KEYFRAMES and a 
+* partial keyframe at the end of the write are ignored.
+*
+* Parameters:
+*  data:  Value written, control byte first
+*  len:   Length of the value in bytes, at least RGB_ANIMATION_CONTROL_LEN
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RgbAnimation_Load(const uint8 *data, uint16 len)
+{
+    uint8 control = data[0];
+    uint16 offset;
+    uint16 durationField;
+    uint8 i;
+    
+    /* The first write of a list replaces the running animation */
+    if(RGB_ANIMATION_LOADING != animationState)
+    {
+        RgbAnimation_Stop();
+        keyframeCount = 0;
+        loopCount = control & RGB_ANIMATION_LOOP_MASK;
+    }
+    
+    for(offset = RGB_ANIMATION_CONTROL_LEN; 
+        ((offset + RGB_ANIMATION_KEYFRAME_LEN) <= len) && (keyframeCount < RGB_ANIMATION_MAX_KEYFRAMES);
+        offset += RGB_ANIMATION_KEYFRAME_LEN)
+    {
+        for(i = 0; i <= RGB_COLOR_CHANNELS; i++)
+        {
+            keyframes[keyframeCount].color[i] = data[offset + i];
+        }
+        
+        durationField = CyBle_Get16ByPtr(&data[offset + RGB_COLOR_CHANNELS + 1u]);
+        keyframes[keyframeCount].duration = durationField & RGB_ANIMATION_DURATION_MASK;
+        keyframes[keyframeCount].easing = (uint8)(durationField >> RGB_ANIMATION_EASE_SHIFT);
+        keyframeCount++;
+    }
+    
+    if(0u != (control & RGB_ANIMATION_MORE_FLAG))
+    {
+        animationState = RGB_ANIMATION_LOADING;
+    }
+    else if(0u == keyframeCount)
+    {
+        animationState = RGB_ANIMATION_STOPPED;
+    }
+    else
+    {
+        /* Start from the color on the LED now */
+        for(i = 0; i <= RGB_COLOR_CHANNELS; i++)
+        {
+            displayColor[i] = RGBledData[i];
+        }
+        
+        animationState = RGB_ANIMATION_PLAYING;
+        keyframeIndex = 0;
+        loopsCompleted = 0;
+        StartKeyframe(WatchdogTimer_GetTimestamp());
+    }
+    
+    UpdateStateAttribute();
+}
+
+
+/*******************************************************************************
+* Function Name: RgbAnimation_Stop
+********************************************************************************
+* Summary:
+* Stops the animation. The LED keeps the color it has now until the next 
+* write to the RGB LED characteristic.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RgbAnimation_Stop(void)
+{
+    if(RGB_ANIMATION_STOPPED != animationState)
+    {
+        animationState = RGB_ANIMATION_STOPPED;
+        UpdateStateAttribute();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RgbAnimation_Process
+********************************************************************************
+* Summary:
+* Moves the animation on to the present time. Called from the main loop; 
+* does nothing unless an animation is playing and the watchdog timestamp 
+* has advanced since the last call.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RgbAnimation_Process(void)
+{
+    uint32 now = WatchdogTimer_GetTimestamp();
+    uint32 elapsed;
+    uint32 nextStart;
+    uint8 progress;
+    uint8 target;
+    uint8 advanced = 0;
+    uint8 i;
+    
+    if((RGB_ANIMATION_PLAYING != animationState) || (now == lastUpdate))
+    {
+        return;
+    }
+    lastUpdate = now;
+    
+    /* Step over the keyframes that have ended, at most one pass through the 
+     * list per call so a list of zero-length keyframes cannot hang the loop */
+    elapsed = now - keyframeStart;
+    while((elapsed >= keyframes[keyframeIndex].duration) && (advanced < keyframeCount))
+    {
+        for(i = 0; i <= RGB_COLOR_CHANNELS; i++)
+        {
+            displayColor[i] = keyframes[keyframeIndex].color[i];
+        }
+        nextStart = keyframeStart + keyframes[keyframeIndex].duration;
+        advanced++;
+        
+        keyframeIndex++;
+        if(keyframeIndex >= keyframeCount)
+        {
+            keyframeIndex = 0;
+            if(loopsCompleted < 0xFFu)
+            {
+                loopsCompleted++;
+            }
+            
+            if((0u != loopCount) && (loopsCompleted >= loopCount))
+            {
+                /* Hold the last color and show it in the RGB LED 
+                 * characteristic */
+                for(i = 0; i <= RGB_COLOR_CHANNELS; i++)
+                {
+                    RGBledData[i] = displayColor[i];
+                }
+                UpdateRGBled();
+                
+                animationState = RGB_ANIMATION_FINISHED;
+                UpdateStateAttribute();
+                return;
+            }
+        }
+        
+        StartKeyframe(nextStart);
+        elapsed = now - keyframeStart;
+    }
+    
+    if(0u != advanced)
+    {
+        UpdateStateAttribute();
+    }
+    
+    if(elapsed < keyframes[keyframeIndex].duration)
+    {
+        progress = (uint8)((elapsed * keyframeRate) >> PROGRESS_FRAC_BITS);
+        progress = ApplyEasing(progress, keyframes[keyframeIndex].easing);
+        
+        for(i = 0; i <= RGB_COLOR_CHANNELS; i++)
+        {
+            target = keyframes[keyframeIndex].color[i];
+            if(target >= fromColor[i])
+            {
+                displayColor[i] = fromColor[i] + (uint8)(((uint16)(target - fromColor[i]) * progress) >> 8);
+            }
+            else
+            {
+                displayColor[i] = fromColor[i] - (uint8)(((uint16)(fromColor[i] - target) * progress) >> 8);
+            }
+        }
+    }
+    
+    DriveRGBled(displayColor);
+}
+
+
+/*******************************************************************************
+* Function Name: RgbAnimation_IsPlaying
+********************************************************************************
+* Summary:
+* Returns whether an animation is playing.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8: TRUE while an animation is playing
+*
+*******************************************************************************/
+uint8 RgbAnimation_IsPlaying(void)
+{
+    return (RGB_ANIMATION_PLAYING == animationState) ? TRUE : FALSE;
+}
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: StartKeyframe
+********************************************************************************
+* Summary:
+* Starts fading from the color on the LED to keyframes[keyframeIndex].
+*
+* Parameters:
+*  startTime:  Timestamp at which the keyframe starts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void StartKeyframe(uint32 startTime)
+{
+    uint8 i;
+    
+    for(i = 0; i <= RGB_COLOR_CHANNELS; i++)
+    {
+        fromColor[i] = displayColor[i];
+    }
+    
+    keyframeStart = startTime;
+    
+    /* progress = elapsed * keyframeRate >> PROGRESS_FRAC_BITS, which stays
+     * below 256 since elapsed < duration */
+    keyframeRate = (0u != keyframes[keyframeIndex].duration) ? 
+        (((uint32)(PROGRESS_MAX + 1u) << PROGRESS_FRAC_BITS) / keyframes[keyframeIndex].duration) : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: ApplyEasing
+********************************************************************************
+* Summary:
+* Maps the linear progress through a keyframe onto its easing curve.
+*
+* Parameters:
+*  progress:  Linear progress, 0..255
+*  easing:    One of RGB_ANIMATION_EASE_xxx
+*
+* Return:
+*  uint8: Eased progress, 0..255
+*
+*******************************************************************************/
+static uint8 ApplyEasing(uint8 progress, uint8 easing)
+{
+    uint8 remaining;
+    
+    switch(easing)
+    {
+        case RGB_ANIMATION_EASE_IN:
+            /* Quadratic, slow start */
+            return (uint8)(((uint16)progress * progress) >> 8);
+        
+        case RGB_ANIMATION_EASE_OUT:
+            /* Quadratic, slow end */
+            remaining = PROGRESS_MAX - progress;
+            return (uint8)(PROGRESS_MAX - (((uint16)remaining * remaining) >> 8));
+        
+        case RGB_ANIMATION_EASE_STEP:
+            /* Hold the previous color until the keyframe time */
+            return 0u;
+        
+        default:
+            return progress;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: UpdateStateAttribute
+********************************************************************************
+* Summary:
+* Writes the playback state into the RGB Animation State characteristic so
+* the Central device can read it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void UpdateStateAttribute(void)
+{
+    uint8 stateData[RGB_ANIMATION_STATE_LEN];
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T stateHandle;
+    
+    stateData[0] = animationState;
+    stateData[1] = keyframeIndex;
+    stateData[2] = loopsCompleted;
+    stateData[3] = keyframeCount;
+    
+    stateHandle.attrHandle = RGB_ANIMATION_STATE_CHAR_HANDLE;
+    stateHandle.value.val = stateData;
+    stateHandle.value.len = sizeof(stateData);
+    stateHandle.value.actualLen = sizeof(stateData);
+    
+    CyBle_GattsWriteAttributeValue(&stateHandle, FALSE, &cyBle_connHandle, FALSE);
+}
+
+#endif  /* #if RGB_ANIMATION */
+
+
+/* [] END OF FILE */
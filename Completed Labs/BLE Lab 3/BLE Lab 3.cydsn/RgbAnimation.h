@@ -0,0 +1,111 @@
+/*****************************************************************************
+* File Name: RgbAnimation.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the RGB LED animation engine implemented as part of the
+* PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_RGB_ANIMATION_H)
+#define _RGB_ANIMATION_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* A write to the RGB Animation characteristic is a control byte followed by
+* up to RGB_ANIMATION_KEYS_PER_WRITE keyframes:
+*
+*  Bit 7 of the control byte is set when more keyframe writes follow; 
+*  playback starts after the write that has it clear. Bits 6..0 are the 
+*  number of times to play the list, 0 plays it until stopped. A write 
+*  without keyframes stops the animation.
+*
+*  Keyframe, 6 bytes, little-endian:
+*  Offset  Length  Field
+*  0       4       Red, green, blue and intensity, as the RGB LED characteristic
+*  4       2       Bits 13..0: time to reach this color in ms
+*                  Bits 15..14: easing, one of RGB_ANIMATION_EASE_xxx
+*/
+#define RGB_ANIMATION_CONTROL_LEN       (1u)
+#define RGB_ANIMATION_KEYFRAME_LEN      (6u)
+#define RGB_ANIMATION_MAX_KEYFRAMES     (16u)
+
+#define RGB_ANIMATION_MORE_FLAG         (0x80u)
+#define RGB_ANIMATION_LOOP_MASK         (0x7Fu)
+
+#define RGB_ANIMATION_DURATION_MASK     (0x3FFFu)
+#define RGB_ANIMATION_EASE_SHIFT        (14u)
+
+#define RGB_ANIMATION_EASE_LINEAR       (0u)
+#define RGB_ANIMATION_EASE_IN           (1u)
+#define RGB_ANIMATION_EASE_OUT          (2u)
+#define RGB_ANIMATION_EASE_STEP         (3u)
+
+/* Keyframes that fit in one write at the largest ATT MTU */
+#define RGB_ANIMATION_KEYS_PER_WRITE    ((MTU_XCHANGE_DATA_LEN - ATT_NOTIFICATION_HEADER_LEN - \
+                                          RGB_ANIMATION_CONTROL_LEN) / RGB_ANIMATION_KEYFRAME_LEN)
+#define RGB_ANIMATION_MAX_WRITE_LEN     (RGB_ANIMATION_CONTROL_LEN + \
+                                         (RGB_ANIMATION_KEYS_PER_WRITE * RGB_ANIMATION_KEYFRAME_LEN))
+
+/* The RGB Animation State characteristic is 4 bytes:
+*  {state, keyframe index, loops completed, keyframe count}
+*/
+#define RGB_ANIMATION_STATE_LEN         (4u)
+
+#define RGB_ANIMATION_STOPPED           (0u)
+#define RGB_ANIMATION_LOADING           (1u)
+#define RGB_ANIMATION_PLAYING           (2u)
+#define RGB_ANIMATION_FINISHED          (3u)
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void RgbAnimation_Load(const uint8 *data, uint16 len);
+void RgbAnimation_Stop(void);
+void RgbAnimation_Process(void);
+uint8 RgbAnimation_IsPlaying(void);
+
+
+#endif  /* #if !defined(_RGB_ANIMATION_H) */
+
+/* [] END OF FILE */
@@ -0,0 +1,202 @@
+/*****************************************************************************
+* File Name: RgbColor.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the color pipeline of the RGB LED implemented as part of
+* the PSoC 4 BLE Lab 4. It replaces the divisions that scaled the color by the
+* intensity with a multiply and shifts, corrects the gamma of the LED with a
+* constant table and optionally mixes the channels through a calibration
+* matrix.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <RgbColor.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Fraction bits of the calibration matrix coefficients */
+#define CALIBRATION_FRAC_BITS           (8u)
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+#if RGB_GAMMA_CORRECTION
+/* Perceived brightness to LED duty, 255 * (i / 255)^2.2 */
+static const uint8 gammaTable[256u] =
+{
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255
+};
+#endif
+
+#if RGB_CALIBRATION
+/* Linear duty mixing of the three LED dies, rows are red, green and blue 
+ * outputs, columns red, green and blue inputs, 256 is 1.0. Measure these
+ * for the board; the identity matrix leaves the colors as they are. */
+static const int16 calibrationMatrix[RGB_COLOR_CHANNELS][RGB_COLOR_CHANNELS] =
+{
+    { 256,    0,    0 },
+    {   0,  256,    0 },
+    {   0,    0,  256 }
+};
+#endif
+
+
+/*****************************************************************************
+* Static function prototypes
+*****************************************************************************/
+static uint8 ScaleByIntensity(uint8 value, uint8 intensity);
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: RgbColor_Convert
+********************************************************************************
+* Summary:
+* Converts the color and intensity written by the central into the PrISM 
+* densities of the red, green and blue LED. Each color is scaled by the 
+* intensity, gamma corrected when RGB_GAMMA_CORRECTION is set and mixed by
+* the calibration matrix when RGB_CALIBRATION is set. There is no division 
+* and the time taken does not depend on the color.
+*
+* Parameters:
+*  rgbData: Red, green, blue and intensity at RED_INDEX..INTENSITY_INDEX
+*  density: Returns the "on" density of the red, green and blue LED
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RgbColor_Convert(const uint8 *rgbData, uint8 *density)
+{
+    uint8 linear[RGB_COLOR_CHANNELS];
+    uint8 channel;
+    
+    #if RGB_CALIBRATION
+    int32 mixed;
+    uint8 input;
+    #endif
+    
+    for(channel = 0; channel < RGB_COLOR_CHANNELS; channel++)
+    {
+        linear[channel] = ScaleByIntensity(rgbData[RED_INDEX + channel], rgbData[INTENSITY_INDEX]);
+        
+        #if RGB_GAMMA_CORRECTION
+        linear[channel] = gammaTable[linear[channel]];
+        #endif
+    }
+    
+    #if RGB_CALIBRATION
+    for(channel = 0; channel < RGB_COLOR_CHANNELS; channel++)
+    {
+        mixed = 0;
+        for(input = 0; input < RGB_COLOR_CHANNELS; input++)
+        {
+            mixed += (int32)calibrationMatrix[channel][input] * linear[input];
+        }
+        mixed = (mixed + (1 << (CALIBRATION_FRAC_BITS - 1u))) >> CALIBRATION_FRAC_BITS;
+        
+        if(mixed < 0)
+        {
+            mixed = 0;
+        }
+        else if(mixed > RGB_LED_MAX_VAL)
+        {
+            mixed = RGB_LED_MAX_VAL;
+        }
+        density[channel] = (uint8)mixed;
+    }
+    #else
+    for(channel = 0; channel < RGB_COLOR_CHANNELS; channel++)
+    {
+        density[channel] = linear[channel];
+    }
+    #endif
+}
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: ScaleByIntensity
+********************************************************************************
+* Summary:
+* Returns value * intensity / 255 rounded to nearest, computed with a 
+* multiply and shifts. x / 255 equals (x + 128 + ((x + 128) >> 8)) >> 8 for
+* every product of two 8-bit values.
+*
+* Parameters:
+*  value:     Color component
+*  intensity: Intensity, 255 is full
+*
+* Return:
+*  uint8: Scaled color component
+*
+*******************************************************************************/
+static uint8 ScaleByIntensity(uint8 value, uint8 intensity)
+{
+    uint16 product = (uint16)((uint16)value * intensity) + 128u;
+    
+    return (uint8)((product + (product >> 8)) >> 8);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,409 @@
+/*****************************************************************************
+* File Name: SampleCodec.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the lossless delta and Rice compression of sensor
+* samples in the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <stdbool.h>
+#include <SampleCodec.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define COUNT_BITS                          (5u)
+#define ORDER_BITS                          (1u)
+#define RICE_PARAM_BITS                     (4u)
+#define SAMPLE_BITS                         (16u)
+#define RICE_PARAM_MAX                      (15u)
+
+#define FIRST_ORDER                         (0u)
+#define SECOND_ORDER                        (1u)
+
+
+/*****************************************************************************
+* Types
+*****************************************************************************/
+typedef struct
+{
+    uint8 *data;
+    uint16 size;
+    uint16 len;
+    uint32 acc;
+    uint8 accBits;
+    bool overflow;
+} BIT_WRITER;
+
+typedef struct
+{
+    const uint8 *data;
+    uint16 len;
+    uint16 pos;
+    uint32 acc;
+    uint8 accBits;
+    bool underflow;
+} BIT_READER;
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: PutBits
+********************************************************************************
+* Summary:
+* Appends up to 24 bits to the output bit stream.
+*
+* Bits are gathered in a 32-bit accumulator and written out a byte at a 
+* time. Bytes that do not fit in the output buffer set the overflow flag.
+*
+* Parameters:
+*  writer: Bit stream state
+*  value:  Bits to append, right aligned
+*  bits:   Number of bits to append
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void PutBits(BIT_WRITER *writer, uint32 value, uint8 bits)
+{
+    writer->acc = (writer->acc << bits) | (value & ((1uL << bits) - 1u));
+    writer->accBits += bits;
+    
+    while(writer->accBits >= 8u)
+    {
+        writer->accBits -= 8u;
+        
+        if(writer->len < writer->size)
+        {
+            writer->data[writer->len++] = (uint8)(writer->acc >> writer->accBits);
+        }
+        else
+        {
+            writer->overflow = true;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GetBits
+********************************************************************************
+* Summary:
+* Reads up to 24 bits from the input bit stream.
+*
+* Reading past the end of the input returns zero bits and sets the 
+* underflow flag.
+*
+* Parameters:
+*  reader: Bit stream state
+*  bits:   Number of bits to read
+*
+* Return:
+*  uint32: Bits read, right aligned
+*
+*******************************************************************************/
+static uint32 GetBits(BIT_READER *reader, uint8 bits)
+{
+    while(reader->accBits < bits)
+    {
+        reader->acc <<= 8u;
+        
+        if(reader->pos < reader->len)
+        {
+            reader->acc |= reader->data[reader->pos++];
+        }
+        else
+        {
+            reader->underflow = true;
+        }
+        
+        reader->accBits += 8u;
+    }
+    
+    reader->accBits -= bits;
+    
+    return (reader->acc >> reader->accBits) & ((1uL << bits) - 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: ZigZag
+********************************************************************************
+* Summary:
+* Maps a signed residual to an unsigned value: 0, -1, 1, -2 ... become 
+* 0, 1, 2, 3 ...
+*
+* Parameters:
+*  residual: Prediction residual
+*
+* Return:
+*  uint32: Mapped value
+*
+*******************************************************************************/
+static uint32 ZigZag(int32 residual)
+{
+    return ((uint32)residual << 1) ^ (uint32)(residual >> 31);
+}
+
+
+/*******************************************************************************
+* Function Name: Predict
+********************************************************************************
+* Summary:
+* Returns the predicted value of samples[index].
+*
+* The first order predictor repeats the previous sample. The second order 
+* predictor extrapolates the line through the two previous samples. The 
+* second sample of a block always uses the first order predictor.
+*
+* Parameters:
+*  samples: Sample block
+*  index:   Index of the sample to predict, 1 or more
+*  order:   FIRST_ORDER or SECOND_ORDER
+*
+* Return:
+*  int32: Predicted value
+*
+*******************************************************************************/
+static int32 Predict(const int16 *samples, uint8 index, uint8 order)
+{
+    if((order == SECOND_ORDER) && (index >= 2u))
+    {
+        return (2 * (int32)samples[index - 1u]) - (int32)samples[index - 2u];
+    }
+    
+    return samples[index - 1u];
+}
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: SampleCodec_EncodeBlock
+********************************************************************************
+* Summary:
+* Compresses a block of samples.
+*
+* A first pass sums the zigzag mapped residuals of both predictors and 
+* keeps the predictor with the smaller sum. The Rice parameter k starts at 
+* 0 and is raised while 2^(k + 1) does not exceed the mean mapped residual,
+* so it ends at floor(log2(mean)), or 0 for a mean below 2. A second pass 
+* writes the codes. The escape code bounds every sample to 34 
+* bits, and the k search to 15 steps, so the work per block is linear in 
+* the block length and uses only shifts and adds (the Cortex-M0 has no 
+* divide instruction).
+*
+* Parameters:
+*  samples:    Samples to encode
+*  count:      Number of samples, 1 to SAMPLE_CODEC_MAX_BLOCK_LEN
+*  output:     Buffer for the encoded block
+*  outputSize: Size of the output buffer in bytes
+*
+* Return:
+*  uint16: Encoded length in bytes, or 0 if the block did not fit in the 
+*          output buffer
+*
+*******************************************************************************/
+uint16 SampleCodec_EncodeBlock(const int16 *samples, uint8 count, uint8 *output, uint16 outputSize)
+{
+    BIT_WRITER writer;
+    uint32 firstOrderSum = 0;
+    uint32 secondOrderSum = 0;
+    uint32 residualSum;
+    uint32 mapped;
+    uint32 quotient;
+    uint8 order;
+    uint8 riceParam = 0;
+    uint8 index;
+    
+    if((count == 0u) || (count > SAMPLE_CODEC_MAX_BLOCK_LEN))
+    {
+        return 0;
+    }
+    
+    /* Pick the predictor with the smaller total residual */
+    for(index = 1; index < count; index++)
+    {
+        firstOrderSum += ZigZag(samples[index] - Predict(samples, index, FIRST_ORDER));
+        secondOrderSum += ZigZag(samples[index] - Predict(samples, index, SECOND_ORDER));
+    }
+    
+    if(secondOrderSum < firstOrderSum)
+    {
+        order = SECOND_ORDER;
+        residualSum = secondOrderSum;
+    }
+    else
+    {
+        order = FIRST_ORDER;
+        residualSum = firstOrderSum;
+    }
+    
+    /* Raise k while 2^(k + 1) <= mean, i.e. (count - 1) * 2^(k + 1) <= sum */
+    while((riceParam < RICE_PARAM_MAX) && 
+          (((uint32)(count - 1u) << (riceParam + 1u)) <= residualSum))
+    {
+        riceParam++;
+    }
+    
+    writer.data = output;
+    writer.size = outputSize;
+    writer.len = 0;
+    writer.acc = 0;
+    writer.accBits = 0;
+    writer.overflow = false;
+    
+    PutBits(&writer, count - 1u, COUNT_BITS);
+    PutBits(&writer, order, ORDER_BITS);
+    PutBits(&writer, riceParam, RICE_PARAM_BITS);
+    PutBits(&writer, (uint16)samples[0], SAMPLE_BITS);
+    
+    for(index = 1; (index < count) && !writer.overflow; index++)
+    {
+        mapped = ZigZag(samples[index] - Predict(samples, index, order));
+        quotient = mapped >> riceParam;
+        
+        if(quotient < SAMPLE_CODEC_ESCAPE_QUOTIENT)
+        {
+            /* Unary quotient terminated by a zero, then the remainder */
+            PutBits(&writer, (1uL << (quotient + 1u)) - 2u, (uint8)(quotient + 1u));
+            PutBits(&writer, mapped, riceParam);
+        }
+        else
+        {
+            PutBits(&writer, (1uL << SAMPLE_CODEC_ESCAPE_QUOTIENT) - 1u, SAMPLE_CODEC_ESCAPE_QUOTIENT);
+            PutBits(&writer, mapped, SAMPLE_CODEC_ESCAPE_BITS);
+        }
+    }
+    
+    /* Pad the last byte with zeros */
+    if(writer.accBits != 0u)
+    {
+        PutBits(&writer, 0, 8u - writer.accBits);
+    }
+    
+    return writer.overflow ? 0u : writer.len;
+}
+
+
+/*******************************************************************************
+* Function Name: SampleCodec_DecodeBlock
+********************************************************************************
+* Summary:
+* Decompresses a block produced by SampleCodec_EncodeBlock().
+*
+* The decoder mirrors the encoder and has no hardware dependencies, so the
+* central or a host tool can build this file with the cytypes integer types 
+* to read the stream.
+*
+* Parameters:
+*  input:    Encoded block
+*  inputLen: Length of the encoded block in bytes
+*  samples:  Buffer for the decoded samples
+*  maxCount: Size of the sample buffer
+*
+* Return:
+*  uint8: Number of decoded samples, or 0 if the block is malformed
+*
+*******************************************************************************/
+uint8 SampleCodec_DecodeBlock(const uint8 *input, uint16 inputLen, int16 *samples, uint8 maxCount)
+{
+    BIT_READER reader;
+    uint32 mapped;
+    uint32 quotient;
+    uint8 count;
+    uint8 order;
+    uint8 riceParam;
+    uint8 index;
+    
+    reader.data = input;
+    reader.len = inputLen;
+    reader.pos = 0;
+    reader.acc = 0;
+    reader.accBits = 0;
+    reader.underflow = false;
+    
+    count = (uint8)GetBits(&reader, COUNT_BITS) + 1u;
+    order = (uint8)GetBits(&reader, ORDER_BITS);
+    riceParam = (uint8)GetBits(&reader, RICE_PARAM_BITS);
+    
+    if(count > maxCount)
+    {
+        return 0;
+    }
+    
+    samples[0] = (int16)GetBits(&reader, SAMPLE_BITS);
+    
+    for(index = 1; index < count; index++)
+    {
+        quotient = 0;
+        
+        while((quotient < SAMPLE_CODEC_ESCAPE_QUOTIENT) && (GetBits(&reader, 1u) != 0u))
+        {
+            quotient++;
+        }
+        
+        if(quotient < SAMPLE_CODEC_ESCAPE_QUOTIENT)
+        {
+            mapped = (quotient << riceParam) | GetBits(&reader, riceParam);
+        }
+        else
+        {
+            mapped = GetBits(&reader, SAMPLE_CODEC_ESCAPE_BITS);
+        }
+        
+        /* Undo the zigzag mapping and add the prediction */
+        samples[index] = (int16)(Predict(samples, index, order) + 
+                                 (int32)((mapped >> 1) ^ (0u - (mapped & 1u))));
+    }
+    
+    return reader.underflow ? 0u : count;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,242 @@
+/*****************************************************************************
+* File Name: SliderCentroid.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the high-resolution slider centroid and position tracker
+* implemented as part of the PSoC 4 BLE Lab 4. The centroid is interpolated
+* from the difference counts of the sensor with the largest signal and its two
+* neighbours at a configurable resolution, and an alpha-beta filter can track
+* the position and velocity of the finger.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <SliderCentroid.h>
+
+
+#if SLIDER_HIGH_RES
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* Largest reported velocity magnitude */
+#define VELOCITY_MAX                    (32767)
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: SliderCentroid_Compute
+********************************************************************************
+* Summary:
+* Interpolates the finger position between the slider sensors. The position
+* within the sensor with the largest difference count is moved towards the 
+* neighbour with the larger signal by (right - left) / (left + peak + right)
+* of a sensor pitch. A sensor outside the slider counts as zero.
+*
+* Parameters:
+*  diffCounts:  Difference counts of the slider sensors, in slider order
+*  sensorCount: Number of slider sensors, at least 2
+*  maxPosition: Position reported at the centre of the last sensor
+*
+* Return:
+*  uint16: Position, 0..maxPosition, or NO_FINGER if all counts are zero
+*
+*******************************************************************************/
+uint16 SliderCentroid_Compute(const uint16 *diffCounts, uint8 sensorCount, uint16 maxPosition)
+{
+    uint8 peak = 0;
+    uint8 sensor;
+    int32 left;
+    int32 right;
+    int32 sum;
+    int32 scaled;
+    
+    for(sensor = 1; sensor < sensorCount; sensor++)
+    {
+        if(diffCounts[sensor] > diffCounts[peak])
+        {
+            peak = sensor;
+        }
+    }
+    
+    left = (peak > 0u) ? (int32)diffCounts[peak - 1u] : 0;
+    right = (peak < (sensorCount - 1u)) ? (int32)diffCounts[peak + 1u] : 0;
+    sum = left + (int32)diffCounts[peak] + right;
+    
+    if(0 == sum)
+    {
+        return NO_FINGER;
+    }
+    
+    /* Position in sensor pitches is peak + (right - left) / sum, scaled to
+     * maxPosition over (sensorCount - 1) pitches */
+    scaled = ((((int32)peak * sum) + (right - left)) * (int32)maxPosition) / (sum * (int32)(sensorCount - 1u));
+    
+    if(scaled < 0)
+    {
+        scaled = 0;
+    }
+    else if(scaled > (int32)maxPosition)
+    {
+        scaled = (int32)maxPosition;
+    }
+    
+    return (uint16)scaled;
+}
+
+
+/*******************************************************************************
+* Function Name: SliderTracker_Init
+********************************************************************************
+* Summary:
+* Sets the tracker gains and clears its state.
+*
+* Parameters:
+*  tracker: Tracker to initialize
+*  alpha:   Position gain in 1/256, 256 follows the measurement exactly
+*  beta:    Velocity gain in 1/256, 0 tracks no velocity
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void SliderTracker_Init(SLIDER_TRACKER_T *tracker, uint16 alpha, uint16 beta)
+{
+    tracker->alpha = alpha;
+    tracker->beta = beta;
+    SliderTracker_Reset(tracker);
+}
+
+
+/*******************************************************************************
+* Function Name: SliderTracker_Reset
+********************************************************************************
+* Summary:
+* Forgets the tracked finger. Called when the finger is lifted, so that the 
+* next touch starts from its first measurement.
+*
+* Parameters:
+*  tracker: Tracker state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void SliderTracker_Reset(SLIDER_TRACKER_T *tracker)
+{
+    tracker->position = 0;
+    tracker->velocity = 0;
+    tracker->tracking = FALSE;
+}
+
+
+/*******************************************************************************
+* Function Name: SliderTracker_Update
+********************************************************************************
+* Summary:
+* Runs one alpha-beta filter step: the position is predicted from the 
+* velocity, then both are corrected by a share of the prediction error.
+*
+* Parameters:
+*  tracker:     Tracker state
+*  measured:    Centroid of the present scan
+*  maxPosition: Largest position to report
+*  velocity:    Returns the velocity in 1/256 position per scan
+*
+* Return:
+*  uint16: Tracked position, 0..maxPosition
+*
+*******************************************************************************/
+uint16 SliderTracker_Update(SLIDER_TRACKER_T *tracker, uint16 measured, uint16 maxPosition, int16 *velocity)
+{
+    int32 residual;
+    int32 position;
+    
+    if(FALSE == tracker->tracking)
+    {
+        tracker->position = (int32)measured << SLIDER_TRACKER_FRAC_BITS;
+        tracker->velocity = 0;
+        tracker->tracking = TRUE;
+    }
+    else
+    {
+        tracker->position += tracker->velocity;
+        residual = ((int32)measured << SLIDER_TRACKER_FRAC_BITS) - tracker->position;
+        
+        tracker->position += (residual * (int32)tracker->alpha) / (1 << SLIDER_TRACKER_FRAC_BITS);
+        tracker->velocity += (residual * (int32)tracker->beta) / (1 << SLIDER_TRACKER_FRAC_BITS);
+    }
+    
+    if(tracker->velocity > VELOCITY_MAX)
+    {
+        *velocity = VELOCITY_MAX;
+    }
+    else if(tracker->velocity < -VELOCITY_MAX)
+    {
+        *velocity = -VELOCITY_MAX;
+    }
+    else
+    {
+        *velocity = (int16)tracker->velocity;
+    }
+    
+    /* Round to the nearest position inside the slider */
+    if(tracker->position <= 0)
+    {
+        position = 0;
+    }
+    else
+    {
+        position = (tracker->position + (1 << (SLIDER_TRACKER_FRAC_BITS - 1u))) >> SLIDER_TRACKER_FRAC_BITS;
+    }
+    
+    if(position > (int32)maxPosition)
+    {
+        position = (int32)maxPosition;
+    }
+    
+    return (uint16)position;
+}
+
+#endif  /* #if SLIDER_HIGH_RES */
+
+
+/* [] END OF FILE */
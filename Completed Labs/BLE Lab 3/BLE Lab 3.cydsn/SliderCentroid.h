@@ -0,0 +1,96 @@
+/*****************************************************************************
+* File Name: SliderCentroid.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the high-resolution slider centroid and position tracker
+* implemented as part of the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_SLIDER_CENTROID_H)
+#define _SLIDER_CENTROID_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* With SLIDER_HIGH_RES the slider characteristic is 4 bytes, little-endian:
+*
+*  Offset  Length  Field
+*  0       2       Position, 0..SLIDER_HIGH_RES_MAX_VALUE, NO_FINGER when 
+*                  the finger is lifted
+*  2       2       Velocity in 1/256 position per scan, signed, 0 without 
+*                  SLIDER_TRACKING
+*/
+#define SLIDER_HIGH_RES_REPORT_LEN      (4u)
+
+/* Fraction bits of the tracker state and gains */
+#define SLIDER_TRACKER_FRAC_BITS        (8u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* Gains in 1/256, set by SliderTracker_Init() */
+    uint16 alpha;
+    uint16 beta;
+    
+    /* Position and velocity per scan, with SLIDER_TRACKER_FRAC_BITS 
+     * fraction bits */
+    int32 position;
+    int32 velocity;
+    uint8 tracking;
+} SLIDER_TRACKER_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+uint16 SliderCentroid_Compute(const uint16 *diffCounts, uint8 sensorCount, uint16 maxPosition);
+void SliderTracker_Init(SLIDER_TRACKER_T *tracker, uint16 alpha, uint16 beta);
+void SliderTracker_Reset(SLIDER_TRACKER_T *tracker);
+uint16 SliderTracker_Update(SLIDER_TRACKER_T *tracker, uint16 measured, uint16 maxPosition, int16 *velocity);
+
+
+#endif  /* #if !defined(_SLIDER_CENTROID_H) */
+
+/* [] END OF FILE */
@@ -0,0 +1,311 @@
+/*****************************************************************************
+* File Name: SliderGesture.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the CapSense slider gesture recognizer implemented as
+* part of the PSoC 4 BLE Lab 4. It follows the timestamped slider positions of
+* a touch and reports a tap, a swipe left or right, or a hold as one event,
+* instead of every position on the way.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <SliderGesture.h>
+
+
+#if SLIDER_GESTURES
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+#define MS_PER_SECOND                   (1000)
+
+/* The velocity estimate moves 1/2^VELOCITY_SMOOTHING_SHIFT of the way to 
+ * each new measurement */
+#define VELOCITY_SMOOTHING_SHIFT        (1u)
+
+
+/*****************************************************************************
+* Static function prototypes
+*****************************************************************************/
+static uint8 Classify(const SLIDER_GESTURE_T *gesture, uint32 duration);
+static void BuildEvent(SLIDER_GESTURE_T *gesture, uint8 type, uint32 timestamp, uint8 *eventData);
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: SliderGesture_Init
+********************************************************************************
+* Summary:
+* Sets the recognizer thresholds and clears its state.
+*
+* Parameters:
+*  gesture:        Recognizer to initialize
+*  tapMaxMs:       Longest touch that is a tap
+*  tapMaxTravel:   Largest finger movement of a tap or a hold
+*  swipeMinTravel: Shortest finger movement of a swipe
+*  swipeMinSpeed:  Slowest mean speed of a swipe, in positions per second
+*  holdMs:         Touch time after which a finger that has not moved holds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void SliderGesture_Init(SLIDER_GESTURE_T *gesture, uint16 tapMaxMs, uint16 tapMaxTravel, 
+                        uint16 swipeMinTravel, uint16 swipeMinSpeed, uint16 holdMs)
+{
+    gesture->tapMaxMs = tapMaxMs;
+    gesture->tapMaxTravel = tapMaxTravel;
+    gesture->swipeMinTravel = swipeMinTravel;
+    gesture->swipeMinSpeed = swipeMinSpeed;
+    gesture->holdMs = holdMs;
+    gesture->touched = FALSE;
+    gesture->holdSent = FALSE;
+    gesture->sequence = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: SliderGesture_Update
+********************************************************************************
+* Summary:
+* Feeds one slider scan to the recognizer. A hold is reported while the 
+* finger is still down; a tap or a swipe is reported when the finger is 
+* lifted. A touch that is none of these, such as a slow drag, is not 
+* reported.
+*
+* Parameters:
+*  gesture:   Recognizer state
+*  position:  Slider centroid, NO_FINGER when not touched
+*  timestamp: Time of the scan in ms
+*  eventData: Returns SLIDER_GESTURE_EVENT_LEN bytes of event
+*
+* Return:
+*  uint8: TRUE if *eventData holds a new event
+*
+*******************************************************************************/
+uint8 SliderGesture_Update(SLIDER_GESTURE_T *gesture, uint16 position, uint32 timestamp, uint8 *eventData)
+{
+    int32 measured;
+    uint32 duration;
+    uint8 type;
+    
+    if(NO_FINGER == position)
+    {
+        if(FALSE == gesture->touched)
+        {
+            return FALSE;
+        }
+        gesture->touched = FALSE;
+        
+        /* A hold has already been reported for this touch */
+        if(TRUE == gesture->holdSent)
+        {
+            return FALSE;
+        }
+        
+        type = Classify(gesture, timestamp - gesture->startTime);
+        if(0u == type)
+        {
+            return FALSE;
+        }
+        
+        BuildEvent(gesture, type, timestamp, eventData);
+        return TRUE;
+    }
+    
+    if(FALSE == gesture->touched)
+    {
+        /* Touch down */
+        gesture->touched = TRUE;
+        gesture->holdSent = FALSE;
+        gesture->startPosition = position;
+        gesture->minPosition = position;
+        gesture->maxPosition = position;
+        gesture->startTime = timestamp;
+        gesture->velocityPosition = position;
+        gesture->velocityTime = timestamp;
+        gesture->velocity = 0;
+        gesture->peakVelocity = 0;
+    }
+    else
+    {
+        if(position < gesture->minPosition)
+        {
+            gesture->minPosition = position;
+        }
+        if(position > gesture->maxPosition)
+        {
+            gesture->maxPosition = position;
+        }
+        
+        /* Velocity from the movement since the last timestamp tick, 
+         * smoothed, and its peak over the touch */
+        if(timestamp != gesture->velocityTime)
+        {
+            measured = (((int32)position - (int32)gesture->velocityPosition) * MS_PER_SECOND) / 
+                       (int32)(timestamp - gesture->velocityTime);
+            gesture->velocity += (int16)((measured - gesture->velocity) / (1 << VELOCITY_SMOOTHING_SHIFT));
+            
+            if(((gesture->velocity >= 0) ? gesture->velocity : -gesture->velocity) > 
+               ((gesture->peakVelocity >= 0) ? gesture->peakVelocity : -gesture->peakVelocity))
+            {
+                gesture->peakVelocity = gesture->velocity;
+            }
+            
+            gesture->velocityPosition = position;
+            gesture->velocityTime = timestamp;
+        }
+    }
+    gesture->lastPosition = position;
+    
+    /* A finger that stays put long enough is a hold, reported at once */
+    duration = timestamp - gesture->startTime;
+    if((FALSE == gesture->holdSent) && (duration >= gesture->holdMs) &&
+       ((uint16)(gesture->maxPosition - gesture->minPosition) <= gesture->tapMaxTravel))
+    {
+        gesture->holdSent = TRUE;
+        BuildEvent(gesture, SLIDER_GESTURE_HOLD, timestamp, eventData);
+        return TRUE;
+    }
+    
+    return FALSE;
+}
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: Classify
+********************************************************************************
+* Summary:
+* Classifies a finished touch that was not a hold.
+*
+* A swipe has to cover swipeMinTravel at a mean speed of at least 
+* swipeMinSpeed and must not have turned back by more than tapMaxTravel 
+* from its furthest point. A tap is short and moves less than tapMaxTravel.
+*
+* Parameters:
+*  gesture:  Recognizer state at the release
+*  duration: Touch time in ms
+*
+* Return:
+*  uint8: SLIDER_GESTURE_xxx, or 0 if the touch was no gesture
+*
+*******************************************************************************/
+static uint8 Classify(const SLIDER_GESTURE_T *gesture, uint32 duration)
+{
+    uint16 travel;
+    
+    if(gesture->lastPosition >= gesture->startPosition)
+    {
+        travel = gesture->lastPosition - gesture->startPosition;
+        
+        if((travel >= gesture->swipeMinTravel) &&
+           (((uint32)travel * MS_PER_SECOND) >= ((uint32)gesture->swipeMinSpeed * duration)) &&
+           ((gesture->maxPosition - gesture->lastPosition) <= gesture->tapMaxTravel))
+        {
+            return SLIDER_GESTURE_SWIPE_RIGHT;
+        }
+    }
+    else
+    {
+        travel = gesture->startPosition - gesture->lastPosition;
+        
+        if((travel >= gesture->swipeMinTravel) &&
+           (((uint32)travel * MS_PER_SECOND) >= ((uint32)gesture->swipeMinSpeed * duration)) &&
+           ((gesture->lastPosition - gesture->minPosition) <= gesture->tapMaxTravel))
+        {
+            return SLIDER_GESTURE_SWIPE_LEFT;
+        }
+    }
+    
+    if((duration <= gesture->tapMaxMs) && 
+       ((uint16)(gesture->maxPosition - gesture->minPosition) <= gesture->tapMaxTravel))
+    {
+        return SLIDER_GESTURE_TAP;
+    }
+    
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: BuildEvent
+********************************************************************************
+* Summary:
+* Packs a gesture event for notification.
+*
+* Parameters:
+*  gesture:   Recognizer state
+*  type:      SLIDER_GESTURE_xxx
+*  timestamp: Time of the event in ms
+*  eventData: Returns SLIDER_GESTURE_EVENT_LEN bytes of event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void BuildEvent(SLIDER_GESTURE_T *gesture, uint8 type, uint32 timestamp, uint8 *eventData)
+{
+    uint32 duration = timestamp - gesture->startTime;
+    
+    if(duration > 0xFFFFu)
+    {
+        duration = 0xFFFFu;
+    }
+    
+    eventData[0] = gesture->sequence++;
+    eventData[1] = type;
+    eventData[2] = LO8(gesture->startPosition);
+    eventData[3] = LO8(gesture->lastPosition);
+    eventData[4] = LO8(duration);
+    eventData[5] = HI8(duration);
+    eventData[6] = LO8((uint16)gesture->peakVelocity);
+    eventData[7] = HI8((uint16)gesture->peakVelocity);
+}
+
+#endif  /* #if SLIDER_GESTURES */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/*****************************************************************************
+* File Name: SliderGesture.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the CapSense slider gesture recognizer implemented as
+* part of the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_SLIDER_GESTURE_H)
+#define _SLIDER_GESTURE_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* One gesture event is 8 bytes, little-endian:
+*
+*  Offset  Length  Field
+*  0       1       Sequence number, incremented for every event
+*  1       1       Gesture, one of SLIDER_GESTURE_xxx
+*  2       1       Slider position where the finger touched down
+*  3       1       Slider position where the gesture ended
+*  4       2       Duration of the touch in ms, up to the event
+*  6       2       Peak speed in slider positions per second, signed,
+*                  positive towards the higher positions
+*/
+#define SLIDER_GESTURE_EVENT_LEN        (8u)
+
+#define SLIDER_GESTURE_TAP              (1u)
+#define SLIDER_GESTURE_SWIPE_LEFT       (2u)
+#define SLIDER_GESTURE_SWIPE_RIGHT      (3u)
+#define SLIDER_GESTURE_HOLD             (4u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* Configuration, set by SliderGesture_Init() */
+    uint16 tapMaxMs;            /* Longest touch that is a tap */
+    uint16 tapMaxTravel;        /* Largest movement of a tap or hold */
+    uint16 swipeMinTravel;      /* Shortest movement of a swipe */
+    uint16 swipeMinSpeed;       /* Slowest mean speed of a swipe, positions/s */
+    uint16 holdMs;              /* Touch time after which a still finger holds */
+    
+    /* Present touch */
+    uint8 touched;
+    uint8 holdSent;
+    uint16 startPosition;
+    uint16 lastPosition;
+    uint16 minPosition;
+    uint16 maxPosition;
+    uint32 startTime;
+    
+    /* Velocity, updated whenever the timestamp advances */
+    uint16 velocityPosition;
+    uint32 velocityTime;
+    int16 velocity;
+    int16 peakVelocity;
+    
+    uint8 sequence;
+} SLIDER_GESTURE_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void SliderGesture_Init(SLIDER_GESTURE_T *gesture, uint16 tapMaxMs, uint16 tapMaxTravel, 
+                        uint16 swipeMinTravel, uint16 swipeMinSpeed, uint16 holdMs);
+uint8 SliderGesture_Update(SLIDER_GESTURE_T *gesture, uint16 position, uint32 timestamp, uint8 *eventData);
+
+
+#endif  /* #if !defined(_SLIDER_GESTURE_H) */
+
+/* [] END OF FILE */
@@ -0,0 +1,206 @@
+/*****************************************************************************
+* File Name: WriteDispatcher.c
+*
+* Version: 1.0
+*
+* Description:
+* This file implements the table-driven dispatcher for GATT write requests in
+* the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <BLEApplications.h>
+#include <WriteDispatcher.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+#define NO_ENTRY                        (0xFFu)
+#define CCC_NOTIFICATION_BIT            (0x01u)
+
+
+/*****************************************************************************
+* Static variables 
+*****************************************************************************/
+/* Registered entries, and the entry index for every attribute handle */
+static const WRITE_DISPATCH_ENTRY_T *dispatchEntries;
+static uint8 handleToEntry[WRITE_DISPATCH_MAX_HANDLE + 1u];
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: WriteDispatcher_Init
+********************************************************************************
+* Summary:
+* Builds the handle-indexed dispatch table.
+*
+* The attribute handle of every entry is looked up once in the custom 
+* service data generated by the BLE component (cyBle_customs), and the 
+* entry index is stored at that handle in a byte table. A write is then 
+* dispatched with a single table lookup, however many characteristics the
+* services have.
+*
+* Parameters:
+*  entries:    Write handlers, kept by reference
+*  entryCount: Number of entries, less than 255
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void WriteDispatcher_Init(const WRITE_DISPATCH_ENTRY_T *entries, uint8 entryCount)
+{
+    const CYBLE_CUSTOMS_INFO_T *charInfo;
+    CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle;
+    uint16 handle;
+    uint8 index;
+    
+    dispatchEntries = entries;
+    
+    for(handle = 0; handle <= WRITE_DISPATCH_MAX_HANDLE; handle++)
+    {
+        handleToEntry[handle] = NO_ENTRY;
+    }
+    
+    for(index = 0; index < entryCount; index++)
+    {
+        charInfo = &cyBle_customs[entries[index].serviceIndex].customServiceInfo[entries[index].charIndex];
+        
+        if(entries[index].descriptorIndex == WRITE_DISPATCH_CHAR_VALUE)
+        {
+            attrHandle = charInfo->customServiceCharHandle;
+        }
+        else
+        {
+            attrHandle = charInfo->customServiceCharDescriptors[entries[index].descriptorIndex];
+        }
+        
+        if(attrHandle <= WRITE_DISPATCH_MAX_HANDLE)
+        {
+            handleToEntry[attrHandle] = index;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WriteDispatcher_Dispatch
+********************************************************************************
+* Summary:
+* Validates a write and passes it to the registered handler. Writes to 
+* attributes without an entry are rejected, so that the Central is not told
+* that a write nobody handled succeeded.
+*
+* For a CCCD entry the notification bit is copied to the entry flag and the
+* descriptor value is written back to the GATT DB, so that it reads back 
+* correctly, before the optional handler is called. With a mirror the GATT
+* DB write is skipped when the descriptor value has not changed.
+*
+* Parameters:
+*  handleValPair: Attribute handle and value from the write event
+*
+* Return:
+*  CYBLE_GATT_ERR_CODE_T: CYBLE_GATT_ERR_NONE if the write was handled, 
+*                         CYBLE_GATT_ERR_INVALID_HANDLE if the handle is 
+*                         outside the GATT DB,
+*                         CYBLE_GATT_ERR_WRITE_NOT_PERMITTED if no entry is
+*                         registered for the handle,
+*                         CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN if the value 
+*                         length is outside the entry limits
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T WriteDispatcher_Dispatch(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair)
+{
+    const WRITE_DISPATCH_ENTRY_T *entry;
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T cccdHandle;
+    uint8 cccdValue[CCC_DATA_LEN];
+    uint8 entryIndex;
+    
+    if(handleValPair->attrHandle > WRITE_DISPATCH_MAX_HANDLE)
+    {
+        return CYBLE_GATT_ERR_INVALID_HANDLE;
+    }
+    
+    entryIndex = handleToEntry[handleValPair->attrHandle];
+    
+    if(entryIndex == NO_ENTRY)
+    {
+        return CYBLE_GATT_ERR_WRITE_NOT_PERMITTED;
+    }
+    
+    entry = &dispatchEntries[entryIndex];
+    
+    if((handleValPair->value.len < entry->minLen) || (handleValPair->value.len > entry->maxLen))
+    {
+        return CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    
+    if(entry->cccdFlag != NULL)
+    {
+        *entry->cccdFlag = ((handleValPair->value.val[CCC_DATA_INDEX] & CCC_NOTIFICATION_BIT) != 0u) ? TRUE : FALSE;
+        
+        cccdValue[0] = *entry->cccdFlag;
+        cccdValue[1] = 0x00;
+        
+        if(entry->cccdMirror != NULL)
+        {
+            (void)AttributeMirror_Commit(entry->cccdMirror, cccdValue);
+        }
+        else
+        {
+            cccdHandle.attrHandle = handleValPair->attrHandle;
+            cccdHandle.value.val = cccdValue;
+            cccdHandle.value.len = sizeof(cccdValue);
+            
+            CyBle_GattsWriteAttributeValue(&cccdHandle, ZERO, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+        }
+    }
+    
+    if(entry->handler != NULL)
+    {
+        entry->handler(handleValPair);
+    }
+    
+    return CYBLE_GATT_ERR_NONE;
+}
+
+
+/* [] END OF FILE */
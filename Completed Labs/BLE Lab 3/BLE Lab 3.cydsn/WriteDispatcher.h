@@ -0,0 +1,100 @@
+/*****************************************************************************
+* File Name: WriteDispatcher.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the table-driven dispatcher for GATT write requests to
+* the custom services in the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_WRITE_DISPATCHER_H)
+#define _WRITE_DISPATCHER_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+#include <AttributeMirror.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+/* Descriptor index of an entry that handles the characteristic value */
+#define WRITE_DISPATCH_CHAR_VALUE       (0xFFu)
+
+/* Attribute handles start at 1 and there is one handle per GATT DB entry */
+#define WRITE_DISPATCH_MAX_HANDLE       (CYBLE_GATT_DB_INDEX_COUNT)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+/* Handler called with the written value after validation */
+typedef void (*WRITE_HANDLER_T)(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair);
+
+typedef struct
+{
+    /* Service, characteristic and descriptor index in cyBle_customs[] */
+    uint8 serviceIndex;
+    uint8 charIndex;
+    uint8 descriptorIndex;
+    
+    /* Accepted value length in bytes */
+    uint8 minLen;
+    uint8 maxLen;
+    
+    /* Called for a valid write. May be NULL for a CCCD entry. */
+    WRITE_HANDLER_T handler;
+    
+    /* CCCD entries only: flag that mirrors the notification bit. The 
+     * descriptor value is stored in the GATT DB by the dispatcher. */
+    uint8 *cccdFlag;
+    
+    /* CCCD entries only, may be NULL: mirror of the descriptor value. The
+     * GATT DB is then only written when the value changes. */
+    ATTRIBUTE_MIRROR_T *cccdMirror;
+} WRITE_DISPATCH_ENTRY_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void WriteDispatcher_Init(const WRITE_DISPATCH_ENTRY_T *entries, uint8 entryCount);
+CYBLE_GATT_ERR_CODE_T WriteDispatcher_Dispatch(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair);
+
+
+#endif  /* #if !defined(_WRITE_DISPATCHER_H) */
+
+/* [] END OF FILE */
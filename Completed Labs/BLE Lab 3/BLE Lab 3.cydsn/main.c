@@ -1,192 +1,724 @@
-/*****************************************************************************
-* File Name: main.c
-*
-* Version: 1.0
-*
-* Description:
-* This is the top level application for the PSoC 4 BLE Lab 4.
-*
-* Hardware Dependency:
-* CY8CKIT-042 BLE Pioneer Kit
-*
-******************************************************************************
-* Copyright (2014), Cypress Semiconductor Corporation.
-******************************************************************************
-* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
-* protected by and subject to worldwide patent protection (United States and
-* foreign), United States copyright laws and international treaty provisions.
-* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
-* license to copy, use, modify, create derivative works of, and compile the
-* Cypress Source Code and derivative works for the sole purpose of creating
-* custom software in support of licensee product to be used only in conjunction
-* with a Cypress integrated circuit as specified in the applicable agreement.
-* Any reproduction, modification, translation, compilation, or representation of
-* this software except as specified above is prohibited without the express
-* written permission of Cypress.
-*
-* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
-* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
-* Cypress reserves the right to make changes without further notice to the
-* materials described herein. Cypress does not assume any liability arising out
-* of the application or use of any product or circuit described herein. Cypress
-* does not authorize its products for use as critical components in life-support
-* systems where a malfunction or failure may reasonably be expected to result in
-* significant injury to the user. The inclusion of Cypress' product in a life-
-* support systems application implies that the manufacturer assumes all risk of
-* such use and in doing so indemnifies Cypress against all charges. Use may be
-* limited by and subject to the applicable Cypress software license agreement.
-*****************************************************************************/
-
-
-/*****************************************************************************
-* Included headers
-*****************************************************************************/
-#include <main.h>
-#include <BLEApplications.h>
-
-
-/*****************************************************************************
-* Function Prototypes
-*****************************************************************************/
-static void InitializeSystem(void);
-static void HandleCapSenseSlider(void);
-
-
-/*****************************************************************************
-* Public functions
-*****************************************************************************/
-
-/*******************************************************************************
-* Function Name: main
-********************************************************************************
-* Summary:
-* System entrance point. This calls the initializing function and continuously
-* process BLE and CapSense events.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  int
-*
-*******************************************************************************/
-int main()
-{
-	/* This function will initialize the system resources such as BLE and CapSense */
-    InitializeSystem();
-	
-    for(;;)
-    {
-        /*Process event callback to handle BLE events. The events generated and 
-		* used for this application are inside the 'CustomEventHandler' routine*/
-        CyBle_ProcessEvents();
-		
-		if(TRUE == deviceConnected)
-		{
-			/* Send CapSense Slider data when respective notification is enabled */
-			if(TRUE == sendCapSenseSliderNotifications)
-			{
-				/* Check for CapSense slider swipe and send data accordingly */
-				HandleCapSenseSlider();
-			}
-		}
-    }	
-}
-
-
-/*******************************************************************************
-* Function Name: InitializeSystem
-********************************************************************************
-* Summary:
-* Start the components and initialize system.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void InitializeSystem(void)
-{
-	/* Enable global interrupt mask */
-	CyGlobalIntEnable; 
-		
-	/* Start BLE component and register the CustomEventHandler function. This 
-	 * function exposes the events from BLE component for application use */
-    CyBle_Start(CustomEventHandler);	
-    
-	/* Start both the PrISM components for LED control*/
-    PRS_1_Start();
-    PRS_2_Start();
-	
-	/* The RGB LED on BLE Pioneer kit are active low. Drive HIGH on 
-	 * pin for OFF and drive LOW on pin for ON*/
-	PRS_1_WritePulse0(RGB_LED_OFF);
-	PRS_1_WritePulse1(RGB_LED_OFF);
-	PRS_2_WritePulse0(RGB_LED_OFF);
-	
-	/* Set Drive mode of output pins from HiZ to Strong */
-	RED_SetDriveMode(RED_DM_STRONG);
-	GREEN_SetDriveMode(GREEN_DM_STRONG);
-	BLUE_SetDriveMode(BLUE_DM_STRONG);
-	
-	/* Initialize CapSense component and initialize baselines*/
-	CapSense_Start();
-	CapSense_InitializeAllBaselines();
-}
-
-
-/*******************************************************************************
-* Function Name: HandleCapSenseSlider
-********************************************************************************
-* Summary:
-* This function scans for finger position on CapSense slider, and if the  
-* position is different, triggers separate routine for BLE notification.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void HandleCapSenseSlider(void)
-{
-	/* Last read CapSense slider position value */
-	static uint16 lastPosition;	
-	
-	/* Present slider position read by CapSense */
-	uint16 sliderPosition;
-		
-	/* Update CapSense baseline for next reading*/
-	CapSense_UpdateEnabledBaselines();	
-		
-	/* ADD_CODE to scan the slider widget */
-	CapSense_ScanEnabledWidgets();			
-	
-	/* Wait for CapSense scanning to be complete. This could take about 5 ms */
-	while(CapSense_IsBusy());
-	
-	/* ADD_CODE to read the finger position on the slider */
-	sliderPosition = CapSense_GetCentroidPos(CapSense_LINEARSLIDER0__LS);	
-
-    /* If finger position on the slider is changed then send data as BLE notifications */
-	if(sliderPosition != lastPosition)
-	{
-		/*If finger is detected on the slider*/
-		if((sliderPosition == NO_FINGER) || (sliderPosition <= SLIDER_MAX_VALUE))
-		{
-			/* Send data over Slider Notification */
-			SendCapSenseNotification((uint8)sliderPosition);
-
-		}	/* if(sliderPosition != NO_FINGER) */
-		
-		/* Update local static variable with present finger position on slider*/
-		lastPosition = sliderPosition;
-		
-	}	/* if(sliderPosition != lastPosition) */	
-}
-
-/* [] END OF FILE */
+/*****************************************************************************
+* File Name: main.c
+*
+* Version: 1.0
+*
+* Description:
+* This is the top level application for the PSoC 4 BLE Lab 4.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <BLEApplications.h>
+#include <NotifyFilter.h>
+#if BASELINE_MANAGER
+#include <BaselineManager.h>
+#endif
+#if SLIDER_HIGH_RES
+#include <SliderCentroid.h>
+#endif
+#if SLIDER_COMPRESSION
+#include <SampleCodec.h>
+#endif
+#if (EVENT_TRACE || CAPSENSE_REPORT || RGB_ANIMATION || SLIDER_GESTURES)
+#include <WatchdogTimer.h>
+#endif
+#if EVENT_TRACE
+#include <EventTrace.h>
+#endif
+#if CAPSENSE_REPORT
+#include <CapSenseReport.h>
+#endif
+#if RGB_ANIMATION
+#include <RgbAnimation.h>
+#endif
+#if SLIDER_GESTURES
+#include <SliderGesture.h>
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#if SLIDER_COMPRESSION
+/* Slider scans per compressed notification */
+#define SLIDER_BLOCK_LEN				(16u)
+
+/* Queued slider scans. Must be a power of two, and hold a few blocks so
+ * that a busy stack does not drop scans. */
+#define SLIDER_QUEUE_SIZE				(64u)
+#define SLIDER_QUEUE_MASK				(SLIDER_QUEUE_SIZE - 1u)
+
+/* Block header: 16-bit sequence number of the first scan in the block */
+#define SLIDER_BLOCK_HEADER_LEN			(2u)
+
+/* Notification payload with the largest accepted ATT MTU */
+#define SLIDER_BLOCK_MAX_ENCODED_LEN	(MTU_XCHANGE_DATA_LEN - ATT_NOTIFICATION_HEADER_LEN)
+#endif
+
+/* The slider is scanned while position or gesture notifications are on */
+#if SLIDER_GESTURES
+#define SLIDER_NOTIFICATIONS_ENABLED	((TRUE == sendCapSenseSliderNotifications) || \
+										 (TRUE == sendSliderGestureNotifications))
+#else
+#define SLIDER_NOTIFICATIONS_ENABLED	(TRUE == sendCapSenseSliderNotifications)
+#endif
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+#if !SLIDER_COMPRESSION
+/* Rate limiter between the slider scans and the notifications */
+static NOTIFY_FILTER_T sliderFilter;
+#endif
+
+#if (SLIDER_HIGH_RES && SLIDER_TRACKING)
+/* Position and velocity tracker of the high-resolution slider */
+static SLIDER_TRACKER_T sliderTracker;
+#endif
+
+#if BASELINE_MANAGER
+/* Schedules the CapSense baseline updates of every sensor */
+static BASELINE_MANAGER_T baselineManager;
+#endif
+
+#if SLIDER_GESTURES
+/* Gesture recognizer fed with every slider scan */
+static SLIDER_GESTURE_T sliderGesture;
+#endif
+
+#if SLIDER_COMPRESSION
+/* Slider scans waiting to be compressed and sent, NO_FINGER stored as -1 */
+static int16 sliderQueue[SLIDER_QUEUE_SIZE];
+static uint16 sliderQueueHead = 0;
+static uint16 sliderQueueTail = 0;
+
+/* Sequence number of the scan at the tail of the queue. Scans dropped on 
+ * overflow still advance it, so the central can see the gap. */
+static uint16 sliderTailSequence = 0;
+#endif
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void InitializeSystem(void);
+static void HandleCapSenseSlider(void);
+#if SLIDER_COMPRESSION
+static void QueueCompressedSliderSample(uint16 sliderPosition);
+static void SendCompressedSliderBlocks(void);
+#endif
+#if CAPSENSE_REPORT
+static void HandleCapSenseReport(void);
+#endif
+#if BASELINE_MANAGER
+static void UpdateCapSenseBaselines(void);
+static void UpdateCapSenseSignal(uint8 sensor);
+#endif
+#if (SLIDER_HIGH_RES && !SLIDER_COMPRESSION)
+static uint16 GetHighResSliderPosition(uint16 sliderPosition, int16 *velocity);
+#endif
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* System entrance point. This calls the initializing function and continuously
+* process BLE and CapSense events.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main()
+{
+	/* This function will initialize the system resources such as BLE and CapSense */
+    InitializeSystem();
+	
+    for(;;)
+    {
+        /*Process event callback to handle BLE events. The events generated and 
+		* used for this application are inside the 'CustomEventHandler' routine*/
+        CyBle_ProcessEvents();
+		
+	#if RGB_WRITE_COMMAND
+		/* Show the latest color written without response */
+		ApplyPendingRGBled();
+	#endif
+		
+		if(TRUE == deviceConnected)
+		{
+		#if CAPSENSE_REPORT
+			/* The packed report carries the slider position too, so it 
+			 * takes over the scan while its notification is enabled */
+			if(TRUE == sendCapSenseReportNotifications)
+			{
+				HandleCapSenseReport();
+			}
+			else if(SLIDER_NOTIFICATIONS_ENABLED)
+			{
+				HandleCapSenseSlider();
+			}
+		#else
+			/* Send CapSense Slider data when respective notification is enabled */
+			if(SLIDER_NOTIFICATIONS_ENABLED)
+			{
+				/* Check for CapSense slider swipe and send data accordingly */
+				HandleCapSenseSlider();
+			}
+		#endif
+			
+		#if EVENT_TRACE
+			/* Send the next part of a trace dump requested by the Central */
+			EventTrace_SendPending();
+		#endif
+		}
+		
+	#if RGB_ANIMATION
+		/* Fade the RGB LED towards the next keyframe */
+		RgbAnimation_Process();
+	#endif
+    }	
+}
+
+
+/*******************************************************************************
+* Function Name: InitializeSystem
+********************************************************************************
+* Summary:
+* Start the components and initialize system.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void InitializeSystem(void)
+{
+	/* Enable global interrupt mask */
+	CyGlobalIntEnable; 
+	
+#if (EVENT_TRACE || CAPSENSE_REPORT || RGB_ANIMATION || SLIDER_GESTURES)
+	/* Start the watchdog timer that timestamps the event trace records, the
+	 * CapSense reports and the slider gestures and times the RGB LED 
+	 * animation */
+	WatchdogTimer_Start();
+#endif
+		
+	/* Start BLE component and register the CustomEventHandler function. This 
+	 * function exposes the events from BLE component for application use */
+    CyBle_Start(CustomEventHandler);	
+	
+	/* Build the dispatch table for GATT write requests */
+	RegisterWriteHandlers();
+    
+	/* Start both the PrISM components for LED control*/
+    PRS_1_Start();
+    PRS_2_Start();
+	
+	/* The RGB LED on BLE Pioneer kit are active low. Drive HIGH on 
+	 * pin for OFF and drive LOW on pin for ON*/
+	PRS_1_WritePulse0(RGB_LED_OFF);
+	PRS_1_WritePulse1(RGB_LED_OFF);
+	PRS_2_WritePulse0(RGB_LED_OFF);
+	
+	/* Set Drive mode of output pins from HiZ to Strong */
+	RED_SetDriveMode(RED_DM_STRONG);
+	GREEN_SetDriveMode(GREEN_DM_STRONG);
+	BLUE_SetDriveMode(BLUE_DM_STRONG);
+	
+	/* Initialize CapSense component and initialize baselines*/
+	CapSense_Start();
+	CapSense_InitializeAllBaselines();
+	
+	#if (SLIDER_HIGH_RES && !SLIDER_COMPRESSION)
+	NotifyFilter_Init(&sliderFilter, SLIDER_DEADBAND * SLIDER_RESOLUTION_MULTIPLIER, 
+					  SLIDER_HYSTERESIS * SLIDER_RESOLUTION_MULTIPLIER, SLIDER_MIN_INTERVAL_SCANS);
+	#elif !SLIDER_COMPRESSION
+	NotifyFilter_Init(&sliderFilter, SLIDER_DEADBAND, SLIDER_HYSTERESIS, SLIDER_MIN_INTERVAL_SCANS);
+	#endif
+	
+	#if (SLIDER_HIGH_RES && SLIDER_TRACKING)
+	SliderTracker_Init(&sliderTracker, SLIDER_TRACKER_ALPHA, SLIDER_TRACKER_BETA);
+	#endif
+	
+	#if BASELINE_MANAGER
+	BaselineManager_Init(&baselineManager, CapSense_TOTAL_SENSOR_COUNT, BASELINE_IDLE_INTERVAL_SCANS, 
+						 BASELINE_DRIFT_THRESHOLD, BASELINE_FAST_SCANS);
+	#endif
+	
+	#if SLIDER_GESTURES
+	SliderGesture_Init(&sliderGesture, GESTURE_TAP_MAX_MS, GESTURE_TAP_MAX_TRAVEL, 
+					   GESTURE_SWIPE_MIN_TRAVEL, GESTURE_SWIPE_MIN_SPEED, GESTURE_HOLD_MS);
+	#endif
+}
+
+
+/*******************************************************************************
+* Function Name: HandleCapSenseSlider
+********************************************************************************
+* Summary:
+* This function scans for finger position on CapSense slider, and if the  
+* position has changed enough, triggers separate routine for BLE 
+* notification. sliderFilter drops the centroid jitter and limits the 
+* notification rate. With SLIDER_GESTURES every scan also goes to the 
+* gesture recognizer, which notifies one event per gesture.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void HandleCapSenseSlider(void)
+{
+	#if !SLIDER_COMPRESSION
+	/* Slider position to notify, from the filter */
+	uint16 notifyPosition;
+	#endif
+	
+	#if (SLIDER_HIGH_RES && !SLIDER_COMPRESSION)
+	/* High-resolution position and velocity */
+	uint16 highResPosition;
+	int16 velocity;
+	#endif
+	
+	/* Present slider position read by CapSense */
+	uint16 sliderPosition;
+	
+	#if SLIDER_GESTURES
+	/* Gesture event to notify */
+	uint8 gestureEvent[SLIDER_GESTURE_EVENT_LEN];
+	#endif
+		
+	#if BASELINE_MANAGER
+	/* Compute the signals, and update the baselines that are due */
+	UpdateCapSenseBaselines();
+	#else
+	/* Update CapSense baseline for next reading*/
+	CapSense_UpdateEnabledBaselines();	
+	#endif
+		
+	/* ADD_CODE to scan the slider widget */
+	CapSense_ScanEnabledWidgets();			
+	
+	/* Wait for CapSense scanning to be complete. This could take about 5 ms */
+	while(CapSense_IsBusy());
+	
+	/* ADD_CODE to read the finger position on the slider */
+	sliderPosition = CapSense_GetCentroidPos(CapSense_LINEARSLIDER0__LS);	
+
+	#if SLIDER_GESTURES
+	if((TRUE == sendSliderGestureNotifications) && 
+	   ((sliderPosition == NO_FINGER) || (sliderPosition <= SLIDER_MAX_VALUE)))
+	{
+		if(SliderGesture_Update(&sliderGesture, sliderPosition, WatchdogTimer_GetTimestamp(), gestureEvent))
+		{
+			(void)SendSliderGestureNotification(gestureEvent, sizeof(gestureEvent));
+		}
+	}
+	
+	/* Positions are only sent while their notification is enabled too */
+	if(TRUE != sendCapSenseSliderNotifications)
+	{
+		return;
+	}
+	#endif
+	
+	#if SLIDER_COMPRESSION
+	/* Every scan result goes into the compressed stream, so the central 
+	 * sees the full sample rate at a fraction of the notification count */
+	QueueCompressedSliderSample(sliderPosition);
+	SendCompressedSliderBlocks();
+	#elif SLIDER_HIGH_RES
+	/* Interpolate the position from the sensor signals while a finger is 
+	 * detected by the CapSense component */
+	highResPosition = GetHighResSliderPosition(sliderPosition, &velocity);
+	
+	if(NotifyFilter_Update(&sliderFilter, highResPosition, (highResPosition == NO_FINGER), &notifyPosition))
+	{
+		SendCapSenseHighResNotification(notifyPosition, velocity);
+	}
+	#else
+	/*If finger is detected on the slider, or lifted*/
+	if((sliderPosition == NO_FINGER) || (sliderPosition <= SLIDER_MAX_VALUE))
+	{
+		/* Send data over Slider Notification when the filter passes it */
+		if(NotifyFilter_Update(&sliderFilter, sliderPosition, (sliderPosition == NO_FINGER), &notifyPosition))
+		{
+			SendCapSenseNotification((uint8)notifyPosition);
+		}
+	}
+	#endif	/* #if SLIDER_COMPRESSION */
+}
+
+
+#if SLIDER_COMPRESSION
+/*******************************************************************************
+* Function Name: QueueCompressedSliderSample
+********************************************************************************
+* Summary:
+* Queues a slider position for the compressed stream. If the queue is full,
+* the oldest scan is dropped and the tail sequence number is advanced past 
+* it.
+*
+* Parameters:
+*  sliderPosition:	Slider centroid, or NO_FINGER
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void QueueCompressedSliderSample(uint16 sliderPosition)
+{
+	if((uint16)(sliderQueueHead - sliderQueueTail) >= SLIDER_QUEUE_SIZE)
+	{
+		sliderQueueTail++;
+		sliderTailSequence++;
+	}
+	
+	/* NO_FINGER is stored as -1 */
+	sliderQueue[sliderQueueHead & SLIDER_QUEUE_MASK] = (int16)sliderPosition;
+	sliderQueueHead++;
+}
+
+
+/*******************************************************************************
+* Function Name: SendCompressedSliderBlocks
+********************************************************************************
+* Summary:
+* Sends the queued slider positions in blocks of SLIDER_BLOCK_LEN scans, one
+* compressed notification per block, while the BLE stack is free. 
+* Consecutive positions are nearly equal, so the first order delta predictor
+* makes most residuals zero and an idle block costs about one bit per scan.
+*
+* Each notification starts with the 16-bit sequence number of its first 
+* scan, so the central can detect lost blocks. A block that does not fit the
+* negotiated notification payload is split in halves. Scans leave the queue
+* only once their notification has been accepted by the stack.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void SendCompressedSliderBlocks(void)
+{
+	int16 sliderBlock[SLIDER_BLOCK_LEN];
+	uint8 encodedBlock[SLIDER_BLOCK_MAX_ENCODED_LEN];
+	uint16 encodedLen;
+	uint8 count;
+	uint8 index;
+	
+	while(((uint16)(sliderQueueHead - sliderQueueTail) >= SLIDER_BLOCK_LEN) &&
+	      (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+	{
+		for(index = 0; index < SLIDER_BLOCK_LEN; index++)
+		{
+			sliderBlock[index] = sliderQueue[(sliderQueueTail + index) & SLIDER_QUEUE_MASK];
+		}
+		
+		count = SLIDER_BLOCK_LEN;
+		
+		/* A single sample always fits, so this terminates */
+		do
+		{
+			encodedLen = SampleCodec_EncodeBlock(sliderBlock, count, 
+			                                     &encodedBlock[SLIDER_BLOCK_HEADER_LEN], 
+			                                     GetNotificationPayloadLen() - SLIDER_BLOCK_HEADER_LEN);
+			if(encodedLen == 0u)
+			{
+				count >>= 1;
+			}
+		} while(encodedLen == 0u);
+		
+		encodedBlock[0] = LO8(sliderTailSequence);
+		encodedBlock[1] = HI8(sliderTailSequence);
+		
+		/* Keep the scans queued if the stack did not take the notification */
+		if(SendCapSenseBlockNotification(encodedBlock, encodedLen + SLIDER_BLOCK_HEADER_LEN) != CYBLE_ERROR_OK)
+		{
+			break;
+		}
+		
+		sliderQueueTail += count;
+		sliderTailSequence += count;
+	}
+}
+#endif
+
+
+#if CAPSENSE_REPORT
+/*******************************************************************************
+* Function Name: HandleCapSenseReport
+********************************************************************************
+* Summary:
+* Scans all enabled CapSense widgets and queues a packed report when any of 
+* them has changed, then sends the queued reports. The proximity sensor and
+* buttons are reported if they are added to the CapSense component; 
+* otherwise their fields stay zero.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void HandleCapSenseReport(void)
+{
+	/* Last queued values */
+	static uint16 lastPosition = 0;
+	static uint16 lastProximity = 0;
+	static uint8 lastButtons = 0;
+	
+	/* Present values read by CapSense */
+	uint16 sliderPosition;
+	uint16 proximity = 0;
+	uint8 buttons = 0;
+	
+	#if BASELINE_MANAGER
+	/* Compute the signals, and update the baselines that are due */
+	UpdateCapSenseBaselines();
+	#else
+	/* Update CapSense baseline for next reading*/
+	CapSense_UpdateEnabledBaselines();	
+	#endif
+	
+	/* Scan the enabled widgets */
+	CapSense_ScanEnabledWidgets();			
+	
+	/* Wait for CapSense scanning to be complete. This could take about 5 ms */
+	while(CapSense_IsBusy());
+	
+	sliderPosition = CapSense_GetCentroidPos(CapSense_LINEARSLIDER0__LS);
+	
+	#if defined(CapSense_PROXIMITYSENSOR0__PROX)
+	proximity = CapSense_GetDiffCountData(CapSense_PROXIMITYSENSOR0__PROX);
+	#endif
+	
+	#if defined(CapSense_BUTTON0__BTN)
+	buttons |= CapSense_CheckIsWidgetActive(CapSense_BUTTON0__BTN) ? 0x01u : 0x00u;
+	#endif
+	
+	#if defined(CapSense_BUTTON1__BTN)
+	buttons |= CapSense_CheckIsWidgetActive(CapSense_BUTTON1__BTN) ? 0x02u : 0x00u;
+	#endif
+	
+	if((sliderPosition != lastPosition) || (proximity != lastProximity) || (buttons != lastButtons))
+	{
+		CapSenseReport_Queue(sliderPosition, proximity, buttons);
+		
+		lastPosition = sliderPosition;
+		lastProximity = proximity;
+		lastButtons = buttons;
+	}
+	
+	CapSenseReport_SendPending();
+}
+#endif
+
+
+#if BASELINE_MANAGER
+/*******************************************************************************
+* Function Name: UpdateCapSenseBaselines
+********************************************************************************
+* Summary:
+* Replaces CapSense_UpdateEnabledBaselines(). Every sensor gets its signal
+* from the last scan; the sensors scheduled by the baseline manager also 
+* run the baseline filter step of the component, in 
+* CapSense_UpdateSensorBaseline(). The difference counts given to the 
+* manager are the raw counts minus the baselines, signed and before the 
+* noise threshold. All sensors of this lab are enabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void UpdateCapSenseBaselines(void)
+{
+	int16 diffCounts[CapSense_TOTAL_SENSOR_COUNT];
+	uint16 fingerThresholds[CapSense_TOTAL_SENSOR_COUNT];
+	int32 diffCount;
+	uint16 updateMask;
+	uint8 sensor;
+	
+	for(sensor = 0; sensor < CapSense_TOTAL_SENSOR_COUNT; sensor++)
+	{
+		diffCount = (int32)CapSense_sensorRaw[sensor] - (int32)CapSense_sensorBaseline[sensor];
+		
+		if(diffCount > 0x7FFF)
+		{
+			diffCount = 0x7FFF;
+		}
+		else if(diffCount < -0x7FFF)
+		{
+			diffCount = -0x7FFF;
+		}
+		
+		diffCounts[sensor] = (int16)diffCount;
+		fingerThresholds[sensor] = CapSense_fingerThreshold[CapSense_widgetNumber[sensor]];
+	}
+	
+	updateMask = BaselineManager_Schedule(&baselineManager, diffCounts, fingerThresholds);
+	
+	for(sensor = 0; sensor < CapSense_TOTAL_SENSOR_COUNT; sensor++)
+	{
+		if((updateMask & (1u << sensor)) != 0u)
+		{
+			CapSense_UpdateSensorBaseline(sensor);
+		}
+		else
+		{
+			UpdateCapSenseSignal(sensor);
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: UpdateCapSenseSignal
+********************************************************************************
+* Summary:
+* Computes the signal of a sensor from its raw count and baseline as 
+* CapSense_UpdateSensorBaseline() does, without the baseline filter step:
+* the difference above the noise threshold, or zero.
+*
+* Parameters:
+*  sensor:	Sensor number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void UpdateCapSenseSignal(uint8 sensor)
+{
+	uint16 noiseThreshold = CapSense_noiseThreshold[CapSense_widgetNumber[sensor]];
+	uint16 rawCount = CapSense_sensorRaw[sensor];
+	uint16 baseline = CapSense_sensorBaseline[sensor];
+	uint16 diffCount;
+	
+	if((rawCount > baseline) && ((uint16)(rawCount - baseline) > noiseThreshold))
+	{
+		diffCount = rawCount - baseline;
+		
+		#if (CapSense_SIGNAL_SIZE == CapSense_SIGNAL_SIZE_UINT8)
+		CapSense_sensorSignal[sensor] = (diffCount > 0xFFu) ? 0xFFu : (uint8)diffCount;
+		#else
+		CapSense_sensorSignal[sensor] = diffCount;
+		#endif
+	}
+	else
+	{
+		CapSense_sensorSignal[sensor] = 0u;
+	}
+}
+#endif
+
+
+#if (SLIDER_HIGH_RES && !SLIDER_COMPRESSION)
+/*******************************************************************************
+* Function Name: GetHighResSliderPosition
+********************************************************************************
+* Summary:
+* Computes the high-resolution slider position from the difference counts
+* of the slider sensors, and tracks it when SLIDER_TRACKING is set. The 
+* CapSense component still decides whether a finger is on the slider.
+*
+* Parameters:
+*  sliderPosition:	Centroid from the CapSense component
+*  velocity:		Returns the velocity in 1/256 position per scan
+*
+* Return:
+*  uint16: Position, 0..SLIDER_HIGH_RES_MAX_VALUE, or NO_FINGER
+*
+*******************************************************************************/
+static uint16 GetHighResSliderPosition(uint16 sliderPosition, int16 *velocity)
+{
+	/* Difference counts of the slider sensors. The CapSense component of 
+	 * this lab holds only the slider. */
+	uint16 diffCounts[CapSense_TOTAL_SENSOR_COUNT];
+	uint16 position;
+	uint8 sensor;
+	
+	*velocity = 0;
+	
+	if((sliderPosition == NO_FINGER) || (sliderPosition > SLIDER_MAX_VALUE))
+	{
+		#if SLIDER_TRACKING
+		SliderTracker_Reset(&sliderTracker);
+		#endif
+		
+		return NO_FINGER;
+	}
+	
+	for(sensor = 0; sensor < CapSense_TOTAL_SENSOR_COUNT; sensor++)
+	{
+		diffCounts[sensor] = CapSense_GetDiffCountData(sensor);
+	}
+	
+	position = SliderCentroid_Compute(diffCounts, CapSense_TOTAL_SENSOR_COUNT, SLIDER_HIGH_RES_MAX_VALUE);
+	
+	#if SLIDER_TRACKING
+	if(position != NO_FINGER)
+	{
+		position = SliderTracker_Update(&sliderTracker, position, SLIDER_HIGH_RES_MAX_VALUE, velocity);
+	}
+	#endif
+	
+	return position;
+}
+#endif
+
+/* [] END OF FILE */
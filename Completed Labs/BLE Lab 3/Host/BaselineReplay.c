@@ -0,0 +1,702 @@
+/*****************************************************************************
+* File Name: BaselineReplay.c
+*
+* Version: 1.0
+*
+* Description:
+* This file replays CapSense difference count traces through the baseline
+* update of the BLE Lab 3 on a PC, with the baseline filter of the CapSense
+* component updated on every scan as the lab does, and as scheduled by
+* BaselineManager.c. Build with: gcc -O2 -I. -I"../BLE Lab 3.cydsn" -o
+* baseline_replay BaselineReplay.c. Run ./baseline_replay [-c
+* idle_scans,drift_threshold,fast_scans]... [-t finger,noise,hysteresis] [-p
+* scan_ms] [-k cycles_per_step] [-a] trace.csv, or - for stdin. A trace line
+* is the counts of every sensor above their value at the start of the trace,
+* comma separated, and optionally a last field of 1 while a finger really
+* touches, which is needed to count false and missed touches. -a replays the
+* component with its automatic baseline reset on. Without -c the settings of
+* main.h are replayed. Each output line is a JSON object for the lab update or
+* one setting. Run ./baseline_replay -g seconds[,drift_per_s[,seed]] to print
+* a synthetic trace instead.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <main.h>
+
+/* The manager is compiled out unless BASELINE_MANAGER is set, which main.h
+ * leaves off; the replay turns it on for BaselineManager.c */
+#undef BASELINE_MANAGER
+#define BASELINE_MANAGER                    (1)
+
+#include "../BLE Lab 3.cydsn/BaselineManager.c"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+/* Slider sensors of the lab and their scan period, the watchdog period */
+#define SENSOR_COUNT                        (5u)
+#define DEFAULT_SCAN_PERIOD_MS              (10u)
+#define MAX_SETTINGS                        (16u)
+#define MAX_SCANS                           (1000000u)
+#define LINE_MAX_LEN                        (256u)
+
+/* Thresholds of the CapSense component, in counts */
+#define DEFAULT_FINGER_THRESHOLD            (100u)
+#define DEFAULT_NOISE_THRESHOLD             (20u)
+#define DEFAULT_HYSTERESIS                  (10u)
+#define NEGATIVE_NOISE_THRESHOLD            (20u)
+#define LOW_BASELINE_RESET                  (50u)
+
+/* Raw count of an untouched sensor; the trace counts are added to it */
+#define RAW_COUNT_OFFSET                    (1000)
+
+/* Cortex-M0 cycles of the baseline filter step of 
+ * CapSense_UpdateSensorBaseline(), estimated from its instructions: the 
+ * 24-bit baseline is loaded, the raw count added and the baseline 
+ * subtracted, and both parts and the reset counter stored */
+#define DEFAULT_CYCLES_PER_STEP             (20u)
+
+/* Synthetic trace */
+#define GEN_DEFAULT_DRIFT_PER_S             (2.0)
+#define GEN_DEFAULT_SEED                    (1u)
+#define GEN_NOISE_COUNTS                    (2)
+#define GEN_DRIFT_PERIOD_S                  (60.0)
+#define GEN_CYCLE_S                         (10.0)
+#define GEN_FINGER_COUNTS                   (150.0)
+#define GEN_NEIGHBOR_SHARE                  (0.4)
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint16 idleIntervalScans;
+    uint16 driftThreshold;
+    uint16 fastScans;
+} BASELINE_SETTING_T;
+
+typedef struct
+{
+    uint16 fingerThreshold;
+    uint16 noiseThreshold;
+    uint16 hysteresis;
+    uint8 autoReset;
+} COMPONENT_SETTING_T;
+
+/* State the CapSense component keeps for a sensor */
+typedef struct
+{
+    uint16 baseline;
+    uint8 baselineLow;
+    uint8 lowResetCount;
+    uint16 signal;
+    uint8 active;
+} SENSOR_T;
+
+typedef struct
+{
+    uint32 steps;               /* Baseline filter steps run */
+    uint32 skipped;             /* Baseline filter steps skipped */
+    uint32 touches;             /* Touches detected */
+    uint32 falseTouches;        /* Detected touches with no finger */
+    uint32 falseTouchScans;     /* Scans detected as touched with no finger */
+    uint32 missedTouches;       /* Finger touches never detected */
+    uint32 missedTouchScans;    /* Scans with a finger not detected */
+    uint32 driftEvents;         /* From the manager */
+    uint32 wideTouches;
+} REPLAY_RESULT_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static int16 scans[MAX_SCANS][SENSOR_COUNT];
+static uint8 truth[MAX_SCANS];
+static uint32 scanCount = 0;
+static int hasTruth = -1;
+
+static SENSOR_T sensors[SENSOR_COUNT];
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: LoadTrace()
+******************************************************************************
+* Summary:
+* Reads one line of counts per scan. Lines that do not parse, such as a CSV
+* header, are skipped. The first line decides whether the touch field is 
+* there.
+*
+* Return:
+* int: 0 on success
+*
+*****************************************************************************/
+static int LoadTrace(FILE *file)
+{
+    char line[LINE_MAX_LEN];
+    long fields[SENSOR_COUNT + 1u];
+    char *field;
+    char *end;
+    uint32 fieldCount;
+    uint32 sensor;
+    
+    while((fgets(line, sizeof(line), file) != NULL) && (scanCount < MAX_SCANS))
+    {
+        fieldCount = 0;
+        field = line;
+        
+        while(fieldCount < (SENSOR_COUNT + 1u))
+        {
+            fields[fieldCount] = strtol(field, &end, 0);
+            if(end == field)
+            {
+                break;
+            }
+            fieldCount++;
+            field = end;
+            
+            while((*field == ' ') || (*field == '\t'))
+            {
+                field++;
+            }
+            if(*field != ',')
+            {
+                break;
+            }
+            field++;
+        }
+        
+        if((fieldCount != SENSOR_COUNT) && (fieldCount != (SENSOR_COUNT + 1u)))
+        {
+            continue;
+        }
+        
+        if(hasTruth < 0)
+        {
+            hasTruth = (fieldCount == (SENSOR_COUNT + 1u));
+        }
+        
+        for(sensor = 0; sensor < SENSOR_COUNT; sensor++)
+        {
+            fields[sensor] = (fields[sensor] < -0x7FFF) ? -0x7FFF : 
+                             ((fields[sensor] > 0x7FFF) ? 0x7FFF : fields[sensor]);
+            scans[scanCount][sensor] = (int16)fields[sensor];
+        }
+        truth[scanCount] = (hasTruth && (fieldCount > SENSOR_COUNT) && (fields[SENSOR_COUNT] != 0)) ? 1u : 0u;
+        scanCount++;
+    }
+    
+    return (scanCount != 0u) ? 0 : 1;
+}
+
+
+/*****************************************************************************
+* Function Name: RawCount()
+******************************************************************************
+* Summary:
+* Returns the raw count of a sensor on a scan.
+*
+*****************************************************************************/
+static uint16 RawCount(uint32 scan, uint32 sensor)
+{
+    int32 rawCount = RAW_COUNT_OFFSET + scans[scan][sensor];
+    
+    return (uint16)((rawCount < 0) ? 0 : ((rawCount > 0xFFFF) ? 0xFFFF : rawCount));
+}
+
+
+/*****************************************************************************
+* Function Name: UpdateSignal()
+******************************************************************************
+* Summary:
+* The signal of CapSense_UpdateSensorBaseline() without the filter step, 
+* as UpdateCapSenseSignal() of main.c computes it.
+*
+*****************************************************************************/
+static void UpdateSignal(SENSOR_T *sensor, uint16 rawCount, const COMPONENT_SETTING_T *component)
+{
+    if((rawCount > sensor->baseline) && ((uint16)(rawCount - sensor->baseline) > component->noiseThreshold))
+    {
+        sensor->signal = rawCount - sensor->baseline;
+    }
+    else
+    {
+        sensor->signal = 0;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: UpdateBaseline()
+******************************************************************************
+* Summary:
+* A model of CapSense_UpdateSensorBaseline() of the CapSense CSD component
+* v2.30 without a raw data filter: the 24-bit baseline moves 1/256 of the 
+* way to the raw count when the difference is within the noise thresholds
+* or automatic reset is on, and is reset to the raw count after 
+* LOW_BASELINE_RESET scans below it. Then the signal is computed.
+*
+*****************************************************************************/
+static void UpdateBaseline(SENSOR_T *sensor, uint16 rawCount, const COMPONENT_SETTING_T *component)
+{
+    uint32 calc;
+    uint16 difference;
+    uint8 positive;
+    
+    positive = (rawCount >= sensor->baseline) ? TRUE : FALSE;
+    difference = positive ? (rawCount - sensor->baseline) : (sensor->baseline - rawCount);
+    
+    if(positive)
+    {
+        sensor->lowResetCount = 0;
+    }
+    
+    if((!positive) && (difference > NEGATIVE_NOISE_THRESHOLD))
+    {
+        if(sensor->lowResetCount >= LOW_BASELINE_RESET)
+        {
+            sensor->baseline = rawCount;
+            sensor->baselineLow = 0;
+            sensor->lowResetCount = 0;
+        }
+        else
+        {
+            sensor->lowResetCount++;
+        }
+    }
+    else if(component->autoReset || (difference <= component->noiseThreshold) || (!positive))
+    {
+        calc = ((uint32)sensor->baseline << 8) | sensor->baselineLow;
+        calc += rawCount;
+        calc -= sensor->baseline;
+        sensor->baseline = (uint16)(calc >> 8);
+        sensor->baselineLow = (uint8)calc;
+        sensor->lowResetCount = 0;
+    }
+    
+    UpdateSignal(sensor, rawCount, component);
+}
+
+
+/*****************************************************************************
+* Function Name: Replay()
+******************************************************************************
+* Summary:
+* Runs the trace through the component model, with every baseline updated
+* on every scan when setting is NULL, as CapSense_UpdateEnabledBaselines()
+* does, or as BaselineManager_Schedule() decides. A sensor turns active 
+* when its signal exceeds the finger threshold plus the hysteresis and 
+* inactive when it falls to the finger threshold minus the hysteresis; a
+* touch is any sensor active.
+*
+*****************************************************************************/
+static void Replay(const BASELINE_SETTING_T *setting, const COMPONENT_SETTING_T *component, 
+                   REPLAY_RESULT_T *result)
+{
+    BASELINE_MANAGER_T manager;
+    int16 diffCounts[SENSOR_COUNT];
+    uint16 fingerThresholds[SENSOR_COUNT];
+    uint16 updateMask;
+    uint16 rawCount;
+    int32 diffCount;
+    uint8 touched = FALSE;
+    uint8 fingerSeen = FALSE;
+    uint8 detected;
+    uint8 wasFinger = FALSE;
+    uint8 fingerDetected = FALSE;
+    uint32 scan;
+    uint32 sensor;
+    
+    memset(result, 0, sizeof(*result));
+    
+    for(sensor = 0; sensor < SENSOR_COUNT; sensor++)
+    {
+        memset(&sensors[sensor], 0, sizeof(sensors[sensor]));
+        sensors[sensor].baseline = RawCount(0, sensor);
+        fingerThresholds[sensor] = component->fingerThreshold;
+    }
+    
+    if(setting != NULL)
+    {
+        BaselineManager_Init(&manager, SENSOR_COUNT, setting->idleIntervalScans, setting->driftThreshold, 
+                             setting->fastScans);
+    }
+    
+    for(scan = 0; scan < scanCount; scan++)
+    {
+        if(setting == NULL)
+        {
+            updateMask = (uint16)((1u << SENSOR_COUNT) - 1u);
+            result->steps += SENSOR_COUNT;
+        }
+        else
+        {
+            for(sensor = 0; sensor < SENSOR_COUNT; sensor++)
+            {
+                diffCount = (int32)RawCount(scan, sensor) - (int32)sensors[sensor].baseline;
+                diffCounts[sensor] = (int16)((diffCount > 0x7FFF) ? 0x7FFF : 
+                                             ((diffCount < -0x7FFF) ? -0x7FFF : diffCount));
+            }
+            updateMask = BaselineManager_Schedule(&manager, diffCounts, fingerThresholds);
+        }
+        
+        detected = FALSE;
+        for(sensor = 0; sensor < SENSOR_COUNT; sensor++)
+        {
+            rawCount = RawCount(scan, sensor);
+            
+            if((updateMask & (1u << sensor)) != 0u)
+            {
+                UpdateBaseline(&sensors[sensor], rawCount, component);
+            }
+            else
+            {
+                UpdateSignal(&sensors[sensor], rawCount, component);
+            }
+            
+            if(sensors[sensor].signal > (component->fingerThreshold + component->hysteresis))
+            {
+                sensors[sensor].active = TRUE;
+            }
+            else if(sensors[sensor].signal <= (component->fingerThreshold - component->hysteresis))
+            {
+                sensors[sensor].active = FALSE;
+            }
+            
+            detected |= sensors[sensor].active;
+        }
+        
+        /* Detected touches, false if no finger was there at any time */
+        if(detected && (!touched))
+        {
+            result->touches++;
+            fingerSeen = FALSE;
+        }
+        if(detected && truth[scan])
+        {
+            fingerSeen = TRUE;
+        }
+        if(touched && (!detected) && hasTruth && (!fingerSeen))
+        {
+            result->falseTouches++;
+        }
+        touched = detected;
+        
+        /* Finger touches, missed if never detected */
+        if(truth[scan] && (!wasFinger))
+        {
+            fingerDetected = FALSE;
+        }
+        if(truth[scan] && detected)
+        {
+            fingerDetected = TRUE;
+        }
+        if(wasFinger && (!truth[scan]) && (!fingerDetected))
+        {
+            result->missedTouches++;
+        }
+        wasFinger = truth[scan];
+        
+        if(hasTruth && detected && (!truth[scan]))
+        {
+            result->falseTouchScans++;
+        }
+        if(truth[scan] && (!detected))
+        {
+            result->missedTouchScans++;
+        }
+    }
+    
+    /* A touch still detected at the end of the trace */
+    if(touched && hasTruth && (!fingerSeen))
+    {
+        result->falseTouches++;
+    }
+    
+    if(setting != NULL)
+    {
+        result->steps = manager.updateCount;
+        result->skipped = manager.skipCount;
+        result->driftEvents = manager.driftEvents;
+        result->wideTouches = manager.falseTouchCount;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: PrintResult()
+******************************************************************************
+* Summary:
+* Prints the result of one replay as a JSON object.
+*
+*****************************************************************************/
+static void PrintResult(const BASELINE_SETTING_T *setting, const REPLAY_RESULT_T *result, double seconds,
+                        uint32 cyclesPerStep)
+{
+    if(setting == NULL)
+    {
+        printf("{\"update\":\"every_scan\",");
+    }
+    else
+    {
+        printf("{\"update\":\"manager\",\"idle_scans\":%u,\"drift_threshold\":%u,\"fast_scans\":%u,",
+               (unsigned)setting->idleIntervalScans, (unsigned)setting->driftThreshold, 
+               (unsigned)setting->fastScans);
+    }
+    
+    printf("\"seconds\":%.1f,\"steps_per_s\":%.1f,\"skipped_per_s\":%.1f,\"cycles_saved_per_s\":%.0f,"
+           "\"touches\":%u,\"drift_events\":%u,\"wide_touches\":%u",
+           seconds, result->steps / seconds, result->skipped / seconds, 
+           (result->skipped * (double)cyclesPerStep) / seconds, (unsigned)result->touches, 
+           (unsigned)result->driftEvents, (unsigned)result->wideTouches);
+    
+    if(hasTruth)
+    {
+        printf(",\"false_touches\":%u,\"false_touch_scans\":%u,\"missed_touches\":%u,\"missed_touch_scans\":%u",
+               (unsigned)result->falseTouches, (unsigned)result->falseTouchScans, 
+               (unsigned)result->missedTouches, (unsigned)result->missedTouchScans);
+    }
+    printf("}\n");
+}
+
+
+/*****************************************************************************
+* Function Name: Generate()
+******************************************************************************
+* Summary:
+* Prints a synthetic trace of the lab slider with the touch field.
+*
+* Theory:
+* All sensors share a temperature drift that rises at driftPerS counts 
+* per second for half of a GEN_DRIFT_PERIOD_S period and falls back in the
+* other half, plus up to GEN_NOISE_COUNTS of noise each. Every 
+* GEN_CYCLE_S, a finger taps one sensor for 150 ms, then touches another 
+* with a slow 2 s rise, holds for 2 s and lifts in 0.3 s. A finger raises 
+* its sensor by GEN_FINGER_COUNTS and the neighbors by GEN_NEIGHBOR_SHARE
+* of that. The touch field is 1 while the finger raises a sensor by the 
+* default finger threshold or more.
+*
+*****************************************************************************/
+static void Generate(double seconds, double driftPerS, uint32 scanPeriodMs)
+{
+    uint32 scanTotal = (uint32)((seconds * 1000.0) / scanPeriodMs);
+    uint32 scan;
+    uint32 sensor;
+    uint32 tapSensor = 0;
+    uint32 slowSensor = 0;
+    double t;
+    double phase;
+    double drift;
+    double finger;
+    double counts[SENSOR_COUNT];
+    uint32 fingerSensor;
+    uint32 distance;
+    uint32 cycle = (uint32)-1;
+    
+    printf("s0,s1,s2,s3,s4,touch\n");
+    
+    for(scan = 0; scan < scanTotal; scan++)
+    {
+        t = (scan * (double)scanPeriodMs) / 1000.0;
+        
+        phase = t - (GEN_DRIFT_PERIOD_S * (uint32)(t / GEN_DRIFT_PERIOD_S));
+        drift = driftPerS * ((phase < (GEN_DRIFT_PERIOD_S / 2.0)) ? phase : (GEN_DRIFT_PERIOD_S - phase));
+        
+        if((uint32)(t / GEN_CYCLE_S) != cycle)
+        {
+            cycle = (uint32)(t / GEN_CYCLE_S);
+            tapSensor = (uint32)(rand() % SENSOR_COUNT);
+            slowSensor = (uint32)(rand() % SENSOR_COUNT);
+        }
+        phase = t - (GEN_CYCLE_S * cycle);
+        
+        finger = 0.0;
+        fingerSensor = tapSensor;
+        if((phase >= 2.0) && (phase < 2.15))
+        {
+            finger = GEN_FINGER_COUNTS;
+        }
+        else if((phase >= 4.0) && (phase < 8.3))
+        {
+            fingerSensor = slowSensor;
+            finger = (phase < 6.0) ? (GEN_FINGER_COUNTS * ((phase - 4.0) / 2.0)) : 
+                     ((phase < 8.0) ? GEN_FINGER_COUNTS : (GEN_FINGER_COUNTS * ((8.3 - phase) / 0.3)));
+        }
+        
+        for(sensor = 0; sensor < SENSOR_COUNT; sensor++)
+        {
+            distance = (sensor > fingerSensor) ? (sensor - fingerSensor) : (fingerSensor - sensor);
+            counts[sensor] = drift + (rand() % ((2 * GEN_NOISE_COUNTS) + 1)) - GEN_NOISE_COUNTS;
+            counts[sensor] += (distance == 0u) ? finger : ((distance == 1u) ? (finger * GEN_NEIGHBOR_SHARE) : 0.0);
+            printf("%ld,", (long)counts[sensor]);
+        }
+        printf("%u\n", (finger >= DEFAULT_FINGER_THRESHOLD) ? 1u : 0u);
+    }
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Generates a trace, or replays one with the lab update and every setting
+* and prints the results.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    BASELINE_SETTING_T settings[MAX_SETTINGS];
+    COMPONENT_SETTING_T component;
+    REPLAY_RESULT_T result;
+    const char *tracePath = NULL;
+    uint32 scanPeriodMs = DEFAULT_SCAN_PERIOD_MS;
+    uint32 cyclesPerStep = DEFAULT_CYCLES_PER_STEP;
+    unsigned settingCount = 0;
+    unsigned value[3];
+    unsigned seed = GEN_DEFAULT_SEED;
+    double seconds = 0.0;
+    double driftPerS = GEN_DEFAULT_DRIFT_PER_S;
+    unsigned index;
+    int argIndex;
+    FILE *file;
+    
+    component.fingerThreshold = DEFAULT_FINGER_THRESHOLD;
+    component.noiseThreshold = DEFAULT_NOISE_THRESHOLD;
+    component.hysteresis = DEFAULT_HYSTERESIS;
+    component.autoReset = FALSE;
+    
+    if((argc == 3) && (strcmp(argv[1], "-g") == 0) && 
+       (sscanf(argv[2], "%lf,%lf,%u", &seconds, &driftPerS, &seed) >= 1) && (seconds > 0.0))
+    {
+        srand(seed);
+        Generate(seconds, driftPerS, scanPeriodMs);
+        return 0;
+    }
+    
+    for(argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if((strcmp(argv[argIndex], "-c") == 0) && ((argIndex + 1) < argc) && (settingCount < MAX_SETTINGS) &&
+           (sscanf(argv[argIndex + 1], "%u,%u,%u", &value[0], &value[1], &value[2]) == 3))
+        {
+            settings[settingCount].idleIntervalScans = (uint16)value[0];
+            settings[settingCount].driftThreshold = (uint16)value[1];
+            settings[settingCount].fastScans = (uint16)value[2];
+            settingCount++;
+            argIndex++;
+        }
+        else if((strcmp(argv[argIndex], "-t") == 0) && ((argIndex + 1) < argc) &&
+                (sscanf(argv[argIndex + 1], "%u,%u,%u", &value[0], &value[1], &value[2]) == 3) &&
+                (value[2] < value[0]))
+        {
+            component.fingerThreshold = (uint16)value[0];
+            component.noiseThreshold = (uint16)value[1];
+            component.hysteresis = (uint16)value[2];
+            argIndex++;
+        }
+        else if((strcmp(argv[argIndex], "-p") == 0) && ((argIndex + 1) < argc))
+        {
+            scanPeriodMs = (uint32)strtoul(argv[++argIndex], NULL, 0);
+        }
+        else if((strcmp(argv[argIndex], "-k") == 0) && ((argIndex + 1) < argc))
+        {
+            cyclesPerStep = (uint32)strtoul(argv[++argIndex], NULL, 0);
+        }
+        else if(strcmp(argv[argIndex], "-a") == 0)
+        {
+            component.autoReset = TRUE;
+        }
+        else if((tracePath == NULL) && ((argv[argIndex][0] != '-') || (argv[argIndex][1] == '\0')))
+        {
+            tracePath = argv[argIndex];
+        }
+        else
+        {
+            tracePath = NULL;
+            break;
+        }
+    }
+    
+    if((tracePath == NULL) || (scanPeriodMs == 0u))
+    {
+        fprintf(stderr, "usage: %s [-c idle_scans,drift_threshold,fast_scans]... [-t finger,noise,hysteresis] "
+                "[-p scan_ms] [-k cycles_per_step] [-a] trace.csv\n       %s -g seconds[,drift_per_s[,seed]]\n",
+                argv[0], argv[0]);
+        return 1;
+    }
+    
+    if(settingCount == 0u)
+    {
+        settings[0].idleIntervalScans = BASELINE_IDLE_INTERVAL_SCANS;
+        settings[0].driftThreshold = BASELINE_DRIFT_THRESHOLD;
+        settings[0].fastScans = BASELINE_FAST_SCANS;
+        settingCount = 1;
+    }
+    
+    file = (strcmp(tracePath, "-") == 0) ? stdin : fopen(tracePath, "r");
+    
+    if((file == NULL) || (LoadTrace(file) != 0))
+    {
+        fprintf(stderr, "%s: no trace\n", tracePath);
+        return 1;
+    }
+    seconds = (scanCount * (double)scanPeriodMs) / 1000.0;
+    
+    Replay(NULL, &component, &result);
+    PrintResult(NULL, &result, seconds, cyclesPerStep);
+    
+    for(index = 0; index < settingCount; index++)
+    {
+        Replay(&settings[index], &component, &result);
+        PrintResult(&settings[index], &result, seconds, cyclesPerStep);
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
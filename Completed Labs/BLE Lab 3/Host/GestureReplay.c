@@ -0,0 +1,630 @@
+/*****************************************************************************
+* File Name: GestureReplay.c
+*
+* Version: 1.0
+*
+* Description:
+* This file replays slider traces through the gesture recognizer of the BLE
+* Lab 3 on a PC, to check the gesture thresholds and compare settings. Build
+* with: gcc -O2 -I. -I"../BLE Lab 3.cydsn" -o gesture_replay GestureReplay.c
+* "../BLE Lab 3.cydsn/NotifyFilter.c". Run ./gesture_replay [-c
+* tap_ms,tap_travel,swipe_travel,swipe_speed,hold_ms]... [-p scan_ms] [-n]
+* trace.csv, or - for stdin. Traces are the ones of NotifyReplay.c; a line
+* expect tap, left, right, hold or none labels the next touch, and
+* notify_replay skips it. Without -c the settings of main.h are replayed. Each
+* output line is a JSON object with the results of one setting, and the
+* position notifications sent by the filter of main.h for comparison; -n also
+* prints the gesture events. Run ./gesture_replay -g rounds[,seed] to print a
+* labeled synthetic trace instead.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <main.h>
+
+/* The recognizer is compiled out unless SLIDER_GESTURES is set, which
+ * main.h leaves off; the replay turns it on for SliderGesture.c */
+#undef SLIDER_GESTURES
+#define SLIDER_GESTURES                     (1)
+
+#include "../BLE Lab 3.cydsn/SliderGesture.c"
+#include <NotifyFilter.h>
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+/* Scan period of untimed traces, the watchdog period of the lab */
+#define DEFAULT_SCAN_PERIOD_MS              (10u)
+#define MAX_SETTINGS                        (16u)
+#define MAX_SCANS                           (1000000u)
+#define LINE_MAX_LEN                        (128u)
+
+/* Labels of the touches, SLIDER_GESTURE_xxx or no gesture at all */
+#define LABEL_NONE                          (5u)
+#define LABEL_COUNT                         (6u)
+
+/* Synthetic trace */
+#define GEN_DEFAULT_SEED                    (1u)
+#define GEN_GAP_SCANS                       (20u)
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint16 tapMaxMs;
+    uint16 tapMaxTravel;
+    uint16 swipeMinTravel;
+    uint16 swipeMinSpeed;
+    uint16 holdMs;
+} GESTURE_SETTING_T;
+
+typedef struct
+{
+    uint32 touches;             /* Touch downs in the trace */
+    uint32 labeled;             /* Touches with an expect line */
+    uint32 correct;             /* Labeled touches with the expected result */
+    uint32 wrong;               /* Another gesture, or more than one */
+    uint32 missed;              /* A gesture expected and no event */
+    uint32 spurious;            /* No gesture expected and an event */
+    uint32 events[LABEL_COUNT]; /* Events by gesture */
+    uint32 eventCount;
+    uint32 positionNotifications;
+} REPLAY_RESULT_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static const char * const labelNames[LABEL_COUNT] = { "", "tap", "left", "right", "hold", "none" };
+
+static uint16 scans[MAX_SCANS];
+static uint32 scanTimes[MAX_SCANS];
+
+/* Label of the touch that starts at a scan, 0 if unlabeled */
+static uint8 labels[MAX_SCANS];
+static uint32 scanCount = 0;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: ParsePosition()
+******************************************************************************
+* Summary:
+* Converts a position field to a scan value, with -1 for NO_FINGER.
+*
+* Return:
+* int: 1 if the field is a position
+*
+*****************************************************************************/
+static int ParsePosition(const char *field, uint16 *position)
+{
+    char *end;
+    long value = strtol(field, &end, 0);
+    
+    while((*end == ' ') || (*end == '\t') || (*end == '\r') || (*end == '\n'))
+    {
+        end++;
+    }
+    
+    if((end == field) || (*end != '\0') || (value < -1) || (value > 0xFFFF))
+    {
+        return 0;
+    }
+    
+    *position = (value == -1) ? NO_FINGER : (uint16)value;
+    return 1;
+}
+
+
+/*****************************************************************************
+* Function Name: ParseLabel()
+******************************************************************************
+* Summary:
+* Converts an expect line to a label.
+*
+* Return:
+* uint8: The label, 0 if the line is no expect line
+*
+*****************************************************************************/
+static uint8 ParseLabel(const char *line)
+{
+    char name[16];
+    uint8 label;
+    
+    if(sscanf(line, "expect %15s", name) != 1)
+    {
+        return 0u;
+    }
+    
+    for(label = 1; label < LABEL_COUNT; label++)
+    {
+        if(strcmp(name, labelNames[label]) == 0)
+        {
+            return label;
+        }
+    }
+    return 0u;
+}
+
+
+/*****************************************************************************
+* Function Name: AddScan()
+******************************************************************************
+* Summary:
+* Appends a scan, labeled if it is the touch down after an expect line.
+*
+*****************************************************************************/
+static void AddScan(uint16 position, uint32 time, uint8 *pendingLabel)
+{
+    if(scanCount >= MAX_SCANS)
+    {
+        return;
+    }
+    
+    labels[scanCount] = 0u;
+    if((position != NO_FINGER) && ((scanCount == 0u) || (scans[scanCount - 1u] == NO_FINGER)))
+    {
+        labels[scanCount] = *pendingLabel;
+        *pendingLabel = 0u;
+    }
+    
+    scans[scanCount] = position;
+    scanTimes[scanCount] = time;
+    scanCount++;
+}
+
+
+/*****************************************************************************
+* Function Name: LoadTrace()
+******************************************************************************
+* Summary:
+* Reads a trace into one value and timestamp per scan. A timed position 
+* holds until the time of the next line, at one scan per scan period. 
+* Lines that do not parse, such as a CSV header, are skipped.
+*
+* Return:
+* int: 0 on success
+*
+*****************************************************************************/
+static int LoadTrace(FILE *file, uint32 scanPeriodMs)
+{
+    char line[LINE_MAX_LEN];
+    char *comma;
+    uint16 position;
+    uint16 heldPosition = NO_FINGER;
+    uint8 pendingLabel = 0u;
+    uint8 label;
+    unsigned long time;
+    unsigned long scanTime = 0;
+    int timed = -1;
+    int first = 1;
+    
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        label = ParseLabel(line);
+        if(label != 0u)
+        {
+            pendingLabel = label;
+            continue;
+        }
+        
+        comma = strchr(line, ',');
+        
+        if(!ParsePosition((comma != NULL) ? (comma + 1) : line, &position))
+        {
+            continue;
+        }
+        
+        if(timed < 0)
+        {
+            timed = (comma != NULL);
+        }
+        
+        if(timed)
+        {
+            *comma = '\0';
+            time = strtoul(line, NULL, 0);
+            
+            if(first)
+            {
+                scanTime = time;
+                first = 0;
+            }
+            
+            /* Hold the previous position up to this time */
+            while(scanTime < time)
+            {
+                AddScan(heldPosition, (uint32)scanTime, &pendingLabel);
+                scanTime += scanPeriodMs;
+            }
+            heldPosition = position;
+        }
+        else
+        {
+            AddScan(position, (uint32)(scanCount * scanPeriodMs), &pendingLabel);
+        }
+    }
+    
+    /* The last timed position lasts one scan */
+    if(timed > 0)
+    {
+        AddScan(heldPosition, (uint32)scanTime, &pendingLabel);
+    }
+    
+    return (scanCount != 0u) ? 0 : 1;
+}
+
+
+/*****************************************************************************
+* Function Name: Score()
+******************************************************************************
+* Summary:
+* Scores the events of a finished touch against its label.
+*
+*****************************************************************************/
+static void Score(uint8 label, uint32 touchEvents, uint8 firstEvent, REPLAY_RESULT_T *result)
+{
+    if(label == 0u)
+    {
+        return;
+    }
+    result->labeled++;
+    
+    if(label == LABEL_NONE)
+    {
+        if(touchEvents == 0u)
+        {
+            result->correct++;
+        }
+        else
+        {
+            result->spurious++;
+        }
+    }
+    else if(touchEvents == 0u)
+    {
+        result->missed++;
+    }
+    else if((touchEvents == 1u) && (firstEvent == label))
+    {
+        result->correct++;
+    }
+    else
+    {
+        result->wrong++;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: Replay()
+******************************************************************************
+* Summary:
+* Runs the trace through the recognizer with one setting, as 
+* HandleCapSenseSlider() does, and the position path through the 
+* notification filter of main.h.
+*
+* Theory:
+* A touch runs from the touch down to the NO_FINGER scan after it, which 
+* is when taps and swipes are reported; holds are reported while the 
+* finger is down. A labeled touch is correct when it gave exactly the 
+* expected event, or none for a none label.
+*
+*****************************************************************************/
+static void Replay(const GESTURE_SETTING_T *setting, int printEvents, REPLAY_RESULT_T *result)
+{
+    SLIDER_GESTURE_T gesture;
+    NOTIFY_FILTER_T filter;
+    uint8 eventData[SLIDER_GESTURE_EVENT_LEN];
+    uint16 sendValue;
+    uint8 touchLabel = 0u;
+    uint8 touched = FALSE;
+    uint8 firstEvent = 0u;
+    uint32 touchEvents = 0u;
+    uint32 scan;
+    
+    memset(result, 0, sizeof(*result));
+    SliderGesture_Init(&gesture, setting->tapMaxMs, setting->tapMaxTravel, setting->swipeMinTravel, 
+                       setting->swipeMinSpeed, setting->holdMs);
+    NotifyFilter_Init(&filter, SLIDER_DEADBAND, SLIDER_HYSTERESIS, SLIDER_MIN_INTERVAL_SCANS);
+    
+    for(scan = 0; scan < scanCount; scan++)
+    {
+        /* Out of range centroids are not passed on by the lab */
+        if((scans[scan] != NO_FINGER) && (scans[scan] > SLIDER_MAX_VALUE))
+        {
+            continue;
+        }
+        
+        if((scans[scan] != NO_FINGER) && (!touched))
+        {
+            touched = TRUE;
+            touchLabel = labels[scan];
+            touchEvents = 0u;
+            firstEvent = 0u;
+            result->touches++;
+        }
+        
+        if(SliderGesture_Update(&gesture, scans[scan], scanTimes[scan], eventData))
+        {
+            if(touchEvents == 0u)
+            {
+                firstEvent = eventData[1];
+            }
+            touchEvents++;
+            result->eventCount++;
+            result->events[eventData[1]]++;
+            
+            if(printEvents)
+            {
+                printf("%u,%s,%u,%u,%u,%d\n", (unsigned)scan, labelNames[eventData[1]], (unsigned)eventData[2],
+                       (unsigned)eventData[3], (unsigned)(eventData[4] | (eventData[5] << 8)),
+                       (int)(int16)(eventData[6] | (eventData[7] << 8)));
+            }
+        }
+        
+        if((scans[scan] == NO_FINGER) && touched)
+        {
+            touched = FALSE;
+            Score(touchLabel, touchEvents, firstEvent, result);
+        }
+        
+        if(NotifyFilter_Update(&filter, scans[scan], (scans[scan] == NO_FINGER), &sendValue))
+        {
+            result->positionNotifications++;
+        }
+    }
+    
+    /* A touch still down at the end of the trace */
+    if(touched)
+    {
+        Score(touchLabel, touchEvents, firstEvent, result);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: Jitter()
+******************************************************************************
+* Summary:
+* Returns -1, 0 or 1, the centroid noise of a still finger.
+*
+*****************************************************************************/
+static int Jitter(void)
+{
+    return (rand() % 3) - 1;
+}
+
+
+/*****************************************************************************
+* Function Name: PrintTouch()
+******************************************************************************
+* Summary:
+* Prints a labeled touch that moves from start at step positions per scan,
+* with jitter, followed by a gap with no finger.
+*
+*****************************************************************************/
+static void PrintTouch(const char *label, int start, double step, uint32 touchScans)
+{
+    uint32 scan;
+    int position;
+    
+    printf("expect %s\n", label);
+    
+    for(scan = 0; scan < touchScans; scan++)
+    {
+        position = start + (int)(step * scan) + Jitter();
+        position = (position < 0) ? 0 : ((position > SLIDER_MAX_VALUE) ? SLIDER_MAX_VALUE : position);
+        printf("%d\n", position);
+    }
+    
+    for(scan = 0; scan < GEN_GAP_SCANS; scan++)
+    {
+        printf("-1\n");
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: Generate()
+******************************************************************************
+* Summary:
+* Prints a labeled synthetic trace at one scan per DEFAULT_SCAN_PERIOD_MS.
+*
+* Theory:
+* Every round has one touch of each kind, with 200 ms without a finger 
+* after each:
+* - a swipe right of 25 to 40 scans at 1.5 to 2.5 positions per scan, 
+*   150 to 250 positions/s
+* - a swipe left of 20 to 30 scans at the same speeds
+* - a tap of 5 to 15 scans, 50 to 150 ms, on a still finger
+* - a hold of 100 to 150 scans, 1 to 1.5 s, on a still finger
+* - a slow drag of 400 scans at 1/8 position per scan, 12.5 positions/s,
+*   that is no gesture
+* A still finger has a centroid jitter of one position either way.
+*
+*****************************************************************************/
+static void Generate(uint32 rounds)
+{
+    uint32 round;
+    double step;
+    uint32 touchScans;
+    
+    for(round = 0; round < rounds; round++)
+    {
+        step = 1.5 + ((rand() % 11) / 10.0);
+        touchScans = 25u + (uint32)(rand() % 16);
+        PrintTouch("right", 5 + (rand() % 10), step, touchScans);
+        
+        step = 1.5 + ((rand() % 11) / 10.0);
+        touchScans = 20u + (uint32)(rand() % 11);
+        PrintTouch("left", 95 - (rand() % 10), -step, touchScans);
+        
+        PrintTouch("tap", 20 + (rand() % 60), 0.0, 5u + (uint32)(rand() % 11));
+        PrintTouch("hold", 20 + (rand() % 60), 0.0, 100u + (uint32)(rand() % 51));
+        PrintTouch("none", 20, 0.125, 400u);
+    }
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Generates a trace, or replays one with every setting and prints the 
+* results.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    GESTURE_SETTING_T settings[MAX_SETTINGS];
+    REPLAY_RESULT_T result;
+    const char *tracePath = NULL;
+    uint32 scanPeriodMs = DEFAULT_SCAN_PERIOD_MS;
+    unsigned settingCount = 0;
+    unsigned value[5];
+    unsigned rounds;
+    unsigned seed = GEN_DEFAULT_SEED;
+    unsigned index;
+    int printEvents = 0;
+    int argIndex;
+    FILE *file;
+    
+    if((argc == 3) && (strcmp(argv[1], "-g") == 0) && 
+       (sscanf(argv[2], "%u,%u", &rounds, &seed) >= 1) && (rounds != 0u))
+    {
+        srand(seed);
+        Generate(rounds);
+        return 0;
+    }
+    
+    for(argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if((strcmp(argv[argIndex], "-c") == 0) && ((argIndex + 1) < argc) && (settingCount < MAX_SETTINGS) &&
+           (sscanf(argv[argIndex + 1], "%u,%u,%u,%u,%u", &value[0], &value[1], &value[2], &value[3], &value[4]) == 5))
+        {
+            settings[settingCount].tapMaxMs = (uint16)value[0];
+            settings[settingCount].tapMaxTravel = (uint16)value[1];
+            settings[settingCount].swipeMinTravel = (uint16)value[2];
+            settings[settingCount].swipeMinSpeed = (uint16)value[3];
+            settings[settingCount].holdMs = (uint16)value[4];
+            settingCount++;
+            argIndex++;
+        }
+        else if((strcmp(argv[argIndex], "-p") == 0) && ((argIndex + 1) < argc))
+        {
+            scanPeriodMs = (uint32)strtoul(argv[++argIndex], NULL, 0);
+        }
+        else if(strcmp(argv[argIndex], "-n") == 0)
+        {
+            printEvents = 1;
+        }
+        else if((tracePath == NULL) && ((argv[argIndex][0] != '-') || (argv[argIndex][1] == '\0')))
+        {
+            tracePath = argv[argIndex];
+        }
+        else
+        {
+            tracePath = NULL;
+            break;
+        }
+    }
+    
+    if((tracePath == NULL) || (scanPeriodMs == 0u))
+    {
+        fprintf(stderr, "usage: %s [-c tap_ms,tap_travel,swipe_travel,swipe_speed,hold_ms]... [-p scan_ms] [-n] "
+                "trace.csv\n       %s -g rounds[,seed]\n", argv[0], argv[0]);
+        return 1;
+    }
+    
+    if(settingCount == 0u)
+    {
+        settings[0].tapMaxMs = GESTURE_TAP_MAX_MS;
+        settings[0].tapMaxTravel = GESTURE_TAP_MAX_TRAVEL;
+        settings[0].swipeMinTravel = GESTURE_SWIPE_MIN_TRAVEL;
+        settings[0].swipeMinSpeed = GESTURE_SWIPE_MIN_SPEED;
+        settings[0].holdMs = GESTURE_HOLD_MS;
+        settingCount = 1;
+    }
+    
+    file = (strcmp(tracePath, "-") == 0) ? stdin : fopen(tracePath, "r");
+    
+    if((file == NULL) || (LoadTrace(file, scanPeriodMs) != 0))
+    {
+        fprintf(stderr, "%s: no trace\n", tracePath);
+        return 1;
+    }
+    
+    for(index = 0; index < settingCount; index++)
+    {
+        if(printEvents)
+        {
+            printf("scan,gesture,start,end,duration_ms,peak_speed\n");
+        }
+        
+        Replay(&settings[index], printEvents, &result);
+        
+        printf("{\"tap_ms\":%u,\"tap_travel\":%u,\"swipe_travel\":%u,\"swipe_speed\":%u,\"hold_ms\":%u,"
+               "\"scans\":%u,\"touches\":%u,\"labeled\":%u,\"correct\":%u,\"wrong\":%u,\"missed\":%u,"
+               "\"spurious\":%u,\"taps\":%u,\"lefts\":%u,\"rights\":%u,\"holds\":%u,\"gesture_events\":%u,"
+               "\"position_notifications\":%u}\n",
+               (unsigned)settings[index].tapMaxMs, (unsigned)settings[index].tapMaxTravel,
+               (unsigned)settings[index].swipeMinTravel, (unsigned)settings[index].swipeMinSpeed,
+               (unsigned)settings[index].holdMs, (unsigned)scanCount, (unsigned)result.touches,
+               (unsigned)result.labeled, (unsigned)result.correct, (unsigned)result.wrong, 
+               (unsigned)result.missed, (unsigned)result.spurious, 
+               (unsigned)result.events[SLIDER_GESTURE_TAP], (unsigned)result.events[SLIDER_GESTURE_SWIPE_LEFT],
+               (unsigned)result.events[SLIDER_GESTURE_SWIPE_RIGHT], (unsigned)result.events[SLIDER_GESTURE_HOLD],
+               (unsigned)result.eventCount, (unsigned)result.positionNotifications);
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
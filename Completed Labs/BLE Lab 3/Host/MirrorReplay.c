@@ -0,0 +1,465 @@
+/*****************************************************************************
+* File Name: MirrorReplay.c
+*
+* Version: 1.0
+*
+* Description:
+* This file replays GATT write traces through the BLE Lab 3 on a PC and counts
+* the GATT DB and PrISM writes that the attribute mirrors skip.
+* BLEApplications.c is included, so the real CustomEventHandler(),
+* WriteDispatcher_Dispatch() and AttributeMirror_Commit() take the writes, and
+* CyBle_GattsWriteAttributeValue() is a stub that counts them. Build with: gcc
+* -O2 -I. -I"../BLE Lab 3.cydsn" -o mirror_replay MirrorReplay.c "../BLE Lab
+* 3.cydsn/WriteDispatcher.c" "../BLE Lab 3.cydsn/AttributeMirror.c" "../BLE
+* Lab 3.cydsn/RgbColor.c". Run ./mirror_replay trace.csv, or - for stdin. A
+* trace line is connect, disconnect, or an attribute handle, a comma and the
+* value written in hex, such as 0x000E,ff800040 for the RGB LED
+* characteristic. The output is a JSON object with the commits and writes of
+* each attribute. Run ./mirror_replay -g sessions[,hold_pct[,seed]] to print a
+* synthetic color picker trace instead.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <main.h>
+
+#include "../BLE Lab 3.cydsn/BLEApplications.c"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define LINE_MAX_LEN                        (128u)
+#define MAX_VALUE_LEN                       (32u)
+
+/* Synthetic trace: the picker sends a color per frame while dragged */
+#define GEN_FRAME_RATE_HZ                   (60u)
+#define GEN_DEFAULT_HOLD_PCT                (20u)
+#define GEN_DEFAULT_SEED                    (1u)
+#define GEN_MIN_DRAG_FRAMES                 (30u)
+#define GEN_MAX_DRAG_FRAMES                 (180u)
+#define GEN_MAX_DRAGS                       (4u)
+#define GEN_MAX_STEP_PX                     (8u)
+
+/* The hue strip of the picker: 600 pixels across the 1536 hues of the
+ * RGB color wheel, so every pixel of travel changes the color */
+#define GEN_STRIP_PX                        (600u)
+#define GEN_HUE_COUNT                       (1536u)
+
+/* Chance in percent of the events of a session */
+#define GEN_RESUBSCRIBE_PCT                 (25u)
+#define GEN_OFF_PCT                         (50u)
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint32 rgbDbWrites;         /* GATT DB writes of the RGB LED value */
+    uint32 cccdDbWrites;        /* GATT DB writes of the slider CCCD */
+    uint32 otherDbWrites;       /* GATT DB writes of any other attribute */
+    uint32 prismWrites;         /* PrISM density register writes */
+    uint32 writeRequests;       /* Write requests in the trace */
+    uint32 errorResponses;      /* Write requests rejected */
+    uint32 disconnects;         /* Disconnects in the trace */
+} REPLAY_RESULT_T;
+
+
+/*****************************************************************************
+* GATT DB and stubs of the BLE component and the PrISMs
+*****************************************************************************/
+const CYBLE_CUSTOMS_T cyBle_customs[CYBLE_CUSTOMS_SERVICE_COUNT] =
+{
+    { 0x000Cu, { { RGB_LED_CHAR_HANDLE, { 0x000Fu } } } },
+    { 0x002Cu, { { CAPSENSE_SLIDER_CHAR_HANDLE, { CAPSENSE_CCC_HANDLE } } } }
+};
+
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+static REPLAY_RESULT_T result;
+
+CYBLE_STATE_T CyBle_GetState(void)
+{
+    return (deviceConnected) ? CYBLE_STATE_CONNECTED : CYBLE_STATE_DISCONNECTED;
+}
+
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType)
+{
+    (void)advertisingIntervalType;
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair, uint16 offset,
+                                                  CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    (void)offset;
+    (void)connHandle;
+    (void)flags;
+    
+    if(handleValuePair->attrHandle == RGB_LED_CHAR_HANDLE)
+    {
+        result.rgbDbWrites++;
+    }
+    else if(handleValuePair->attrHandle == CAPSENSE_CCC_HANDLE)
+    {
+        result.cccdDbWrites++;
+    }
+    else
+    {
+        result.otherDbWrites++;
+    }
+    return CYBLE_ERROR_OK;
+}
+
+void CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle)
+{
+    (void)connHandle;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_GATTS_ERR_PARAM_T *errRspParam)
+{
+    (void)connHandle;
+    (void)errRspParam;
+    
+    result.errorResponses++;
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    (void)connHandle;
+    (void)ntfParam;
+    return CYBLE_ERROR_OK;
+}
+
+void PRS_1_WritePulse0(uint8 pulseDensity0)
+{
+    (void)pulseDensity0;
+    result.prismWrites++;
+}
+
+void PRS_1_WritePulse1(uint8 pulseDensity1)
+{
+    (void)pulseDensity1;
+    result.prismWrites++;
+}
+
+void PRS_2_WritePulse0(uint8 pulseDensity0)
+{
+    (void)pulseDensity0;
+    result.prismWrites++;
+}
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: ParseWrite()
+******************************************************************************
+* Summary:
+* Converts a handle,hex line to a handle and a value.
+*
+* Return:
+* int: 1 if the line is a write
+*
+*****************************************************************************/
+static int ParseWrite(const char *line, CYBLE_GATT_DB_ATTR_HANDLE_T *handle, uint8 *value, uint16 *len)
+{
+    const char *field;
+    char *end;
+    unsigned long number;
+    unsigned byte;
+    
+    number = strtoul(line, &end, 0);
+    if((end == line) || (*end != ',') || (number > 0xFFFFu))
+    {
+        return 0;
+    }
+    *handle = (CYBLE_GATT_DB_ATTR_HANDLE_T)number;
+    
+    *len = 0;
+    for(field = end + 1; sscanf(field, "%2x", &byte) == 1; field += 2)
+    {
+        if(*len >= MAX_VALUE_LEN)
+        {
+            return 0;
+        }
+        value[(*len)++] = (uint8)byte;
+    }
+    
+    return (*len != 0u);
+}
+
+
+/*****************************************************************************
+* Function Name: Replay()
+******************************************************************************
+* Summary:
+* Feeds the trace to CustomEventHandler() as the BLE stack would.
+*
+* Return:
+* int: 0 if the trace had at least one write
+*
+*****************************************************************************/
+static int Replay(FILE *file)
+{
+    CYBLE_GATTS_WRITE_REQ_PARAM_T writeParam;
+    uint8 value[MAX_VALUE_LEN];
+    char line[LINE_MAX_LEN];
+    
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        if(strncmp(line, "connect", 7) == 0)
+        {
+            CustomEventHandler(CYBLE_EVT_GATT_CONNECT_IND, NULL);
+        }
+        else if(strncmp(line, "disconnect", 10) == 0)
+        {
+            CustomEventHandler(CYBLE_EVT_GATT_DISCONNECT_IND, NULL);
+            result.disconnects++;
+        }
+        else if(ParseWrite(line, &writeParam.handleValPair.attrHandle, value, &writeParam.handleValPair.value.len))
+        {
+            writeParam.connHandle = cyBle_connHandle;
+            writeParam.handleValPair.value.val = value;
+            writeParam.handleValPair.value.actualLen = writeParam.handleValPair.value.len;
+            result.writeRequests++;
+            
+            CustomEventHandler(CYBLE_EVT_GATTS_WRITE_REQ, &writeParam);
+        }
+    }
+    
+    return (result.writeRequests != 0u) ? 0 : 1;
+}
+
+
+/*****************************************************************************
+* Function Name: Percent()
+******************************************************************************
+* Summary:
+* Returns the share of skipped commits in percent.
+*
+*****************************************************************************/
+static double Percent(uint32 skipped, uint32 commits)
+{
+    return (commits != 0u) ? ((100.0 * skipped) / commits) : 0.0;
+}
+
+
+/*****************************************************************************
+* Function Name: PrintHue()
+******************************************************************************
+* Summary:
+* Prints a write of the color at a hue of the RGB color wheel, at full 
+* intensity.
+*
+*****************************************************************************/
+static void PrintHue(uint32 hue)
+{
+    uint32 sector = hue / 256u;
+    uint32 rise = hue % 256u;
+    uint32 fall = 255u - rise;
+    uint32 rgb[3];
+    
+    rgb[0] = ((sector == 0u) || (sector == 5u)) ? 255u : ((sector == 1u) ? fall : ((sector == 4u) ? rise : 0u));
+    rgb[1] = ((sector == 1u) || (sector == 2u)) ? 255u : ((sector == 0u) ? rise : ((sector == 3u) ? fall : 0u));
+    rgb[2] = ((sector == 3u) || (sector == 4u)) ? 255u : ((sector == 2u) ? rise : ((sector == 5u) ? fall : 0u));
+    
+    printf("0x%04X,%02x%02x%02x%02x\n", RGB_LED_CHAR_HANDLE, (unsigned)rgb[0], (unsigned)rgb[1], (unsigned)rgb[2],
+           RGB_LED_MAX_VAL);
+}
+
+
+/*****************************************************************************
+* Function Name: Generate()
+******************************************************************************
+* Summary:
+* Prints a synthetic trace of sessions with a color picker app.
+*
+* Theory:
+* Each session connects and enables the slider notifications; a quarter of
+* the sessions enable them a second time, as an app does when it comes 
+* back to its CapSense screen. The app restores the color of the last 
+* session, then the user drags the finger along the hue strip 1 to 4 
+* times, for 0.5 to 3 s each. The app sends the color under the finger 
+* every frame at 60 Hz. In hold_pct of the frames the finger rests and 
+* the color is the one last sent; otherwise it moves 1 to 8 pixels. Half 
+* the sessions end by switching the LED off before the disconnect.
+*
+*****************************************************************************/
+static void Generate(uint32 sessions, uint32 holdPct)
+{
+    uint32 session;
+    uint32 drag;
+    uint32 dragCount;
+    uint32 frame;
+    uint32 frameCount;
+    uint32 step;
+    uint32 px = GEN_STRIP_PX / 2u;
+    
+    for(session = 0; session < sessions; session++)
+    {
+        printf("connect\n");
+        printf("0x%04X,0100\n", CAPSENSE_CCC_HANDLE);
+        
+        if((uint32)(rand() % 100) < GEN_RESUBSCRIBE_PCT)
+        {
+            printf("0x%04X,0100\n", CAPSENSE_CCC_HANDLE);
+        }
+        
+        PrintHue((px * GEN_HUE_COUNT) / GEN_STRIP_PX);
+        
+        dragCount = 1u + (uint32)(rand() % GEN_MAX_DRAGS);
+        for(drag = 0; drag < dragCount; drag++)
+        {
+            frameCount = GEN_MIN_DRAG_FRAMES + (uint32)(rand() % (GEN_MAX_DRAG_FRAMES - GEN_MIN_DRAG_FRAMES + 1u));
+            for(frame = 0; frame < frameCount; frame++)
+            {
+                if((uint32)(rand() % 100) >= holdPct)
+                {
+                    step = 1u + (uint32)(rand() % GEN_MAX_STEP_PX);
+                    px = (rand() % 2) ? ((px + step) % GEN_STRIP_PX) : ((px + GEN_STRIP_PX - step) % GEN_STRIP_PX);
+                }
+                PrintHue((px * GEN_HUE_COUNT) / GEN_STRIP_PX);
+            }
+        }
+        
+        if((uint32)(rand() % 100) < GEN_OFF_PCT)
+        {
+            printf("0x%04X,00000000\n", RGB_LED_CHAR_HANDLE);
+        }
+        printf("disconnect\n");
+    }
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Generates a trace, or replays one and prints the commits and writes.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    const char *tracePath = NULL;
+    unsigned sessions = 0;
+    unsigned holdPct = GEN_DEFAULT_HOLD_PCT;
+    unsigned seed = GEN_DEFAULT_SEED;
+    uint32 commits;
+    uint32 dbWrites;
+    FILE *file;
+    int status;
+    
+    if((argc == 3) && (strcmp(argv[1], "-g") == 0) && 
+       (sscanf(argv[2], "%u,%u,%u", &sessions, &holdPct, &seed) >= 1) && (sessions != 0u) && (holdPct <= 100u))
+    {
+        srand(seed);
+        Generate(sessions, holdPct);
+        return 0;
+    }
+    
+    if(argc == 2)
+    {
+        tracePath = argv[1];
+    }
+    
+    if(tracePath == NULL)
+    {
+        fprintf(stderr, "usage: %s trace.csv | -\n       %s -g sessions[,hold_pct[,seed]]\n", argv[0], argv[0]);
+        return 1;
+    }
+    
+    file = (strcmp(tracePath, "-") == 0) ? stdin : fopen(tracePath, "r");
+    if(file == NULL)
+    {
+        perror(tracePath);
+        return 1;
+    }
+    
+    RegisterWriteHandlers();
+    status = Replay(file);
+    
+    if(file != stdin)
+    {
+        fclose(file);
+    }
+    
+    if(status != 0)
+    {
+        fprintf(stderr, "%s: no writes in the trace\n", tracePath);
+        return 1;
+    }
+    
+    /* A commit is a call of AttributeMirror_Commit(); the stub counts the 
+     * ones that reached the GATT DB, which the mirror counters must match */
+    commits = rgbLedMirror.writeCount + rgbLedMirror.skipCount + 
+              capSenseSliderCccdMirror.writeCount + capSenseSliderCccdMirror.skipCount;
+    dbWrites = result.rgbDbWrites + result.cccdDbWrites;
+    
+    printf("{\"write_requests\":%u,\"errors\":%u,\"disconnects\":%u,"
+           "\"rgb_commits\":%u,\"rgb_db_writes\":%u,\"rgb_eliminated_pct\":%.1f,"
+           "\"cccd_commits\":%u,\"cccd_db_writes\":%u,\"cccd_eliminated_pct\":%.1f,"
+           "\"commits\":%u,\"db_writes\":%u,\"eliminated_pct\":%.1f,"
+           "\"prism_updates\":%u,\"prism_writes\":%u,\"prism_eliminated_pct\":%.1f,\"counters_match\":%s}\n",
+           (unsigned)result.writeRequests, (unsigned)result.errorResponses, (unsigned)result.disconnects,
+           (unsigned)(rgbLedMirror.writeCount + rgbLedMirror.skipCount), (unsigned)result.rgbDbWrites,
+           Percent(rgbLedMirror.skipCount, rgbLedMirror.writeCount + rgbLedMirror.skipCount),
+           (unsigned)(capSenseSliderCccdMirror.writeCount + capSenseSliderCccdMirror.skipCount), 
+           (unsigned)result.cccdDbWrites,
+           Percent(capSenseSliderCccdMirror.skipCount, 
+                   capSenseSliderCccdMirror.writeCount + capSenseSliderCccdMirror.skipCount),
+           (unsigned)commits, (unsigned)dbWrites, Percent(commits - dbWrites, commits),
+           (unsigned)(rgbLedMirror.writeCount + rgbLedMirror.skipCount), (unsigned)(result.prismWrites / 3u),
+           Percent((rgbLedMirror.writeCount + rgbLedMirror.skipCount) - (result.prismWrites / 3u),
+                   rgbLedMirror.writeCount + rgbLedMirror.skipCount),
+           ((result.rgbDbWrites == rgbLedMirror.writeCount) && 
+            (result.cccdDbWrites == capSenseSliderCccdMirror.writeCount)) ? "true" : "false");
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
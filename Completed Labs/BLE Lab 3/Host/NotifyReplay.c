@@ -0,0 +1,393 @@
+/*****************************************************************************
+* File Name: NotifyReplay.c
+*
+* Version: 1.0
+*
+* Description:
+* This file replays slider traces through the notification filter of the BLE
+* Lab 3 on a PC, to tune the filter and compare settings. Build with: gcc -O2
+* -I. -I"../BLE Lab 3.cydsn" -o notify_replay NotifyReplay.c "../BLE Lab
+* 3.cydsn/NotifyFilter.c". Run ./notify_replay [-c
+* deadband,hysteresis,interval]... [-p scan_ms] [-n] trace.csv, or - for
+* stdin. A trace line is either the slider position of one scan, or a time in
+* ms, a comma and the position from that time on, as received with the filter
+* of main.h set to all zero, which sends every change; NO_FINGER is 65535 or
+* -1. Without -c the settings of main.h are replayed. Each output line is a
+* JSON object with the results of one setting; -n also prints the
+* notifications.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <main.h>
+#include <NotifyFilter.h>
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+/* Scan period of timed traces, the watchdog period of the lab */
+#define DEFAULT_SCAN_PERIOD_MS              (10u)
+
+#define MAX_SETTINGS                        (16u)
+#define MAX_SCANS                           (1000000u)
+#define LINE_MAX_LEN                        (128u)
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint16 deadband;
+    uint16 hysteresis;
+    uint16 minIntervalScans;
+} FILTER_SETTING_T;
+
+typedef struct
+{
+    uint32 touches;             /* Touch downs in the trace */
+    uint32 changes;             /* Scans with a new position */
+    uint32 sent;                /* Notifications */
+    uint32 suppressed;          /* Changes held back by the filter */
+    uint32 touchedScans;        /* Scans with a finger on the slider */
+    uint32 errorSum;            /* Sum of |shown - true| over those scans */
+    uint32 errorMax;
+    uint32 staleReleases;       /* Releases with a final value not shown */
+} REPLAY_RESULT_T;
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+static uint16 scans[MAX_SCANS];
+static uint32 scanCount = 0;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: ParsePosition()
+******************************************************************************
+* Summary:
+* Converts a position field to a scan value, with -1 for NO_FINGER.
+*
+* Return:
+* int: 1 if the field is a position
+*
+*****************************************************************************/
+static int ParsePosition(const char *field, uint16 *position)
+{
+    char *end;
+    long value = strtol(field, &end, 0);
+    
+    while((*end == ' ') || (*end == '\t') || (*end == '\r') || (*end == '\n'))
+    {
+        end++;
+    }
+    
+    if((end == field) || (*end != '\0') || (value < -1) || (value > 0xFFFF))
+    {
+        return 0;
+    }
+    
+    *position = (value == -1) ? NO_FINGER : (uint16)value;
+    return 1;
+}
+
+
+/*****************************************************************************
+* Function Name: LoadTrace()
+******************************************************************************
+* Summary:
+* Reads a trace into one value per scan. A timed position holds until the
+* time of the next line, at one scan per scan period. Lines that do not 
+* parse, such as a CSV header, are skipped.
+*
+* Return:
+* int: 0 on success
+*
+*****************************************************************************/
+static int LoadTrace(FILE *file, uint32 scanPeriodMs)
+{
+    char line[LINE_MAX_LEN];
+    char *comma;
+    uint16 position;
+    uint16 heldPosition = NO_FINGER;
+    unsigned long time;
+    unsigned long scanTime = 0;
+    int timed = -1;
+    int first = 1;
+    
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        comma = strchr(line, ',');
+        
+        if(!ParsePosition((comma != NULL) ? (comma + 1) : line, &position))
+        {
+            continue;
+        }
+        
+        if(timed < 0)
+        {
+            timed = (comma != NULL);
+        }
+        
+        if(timed)
+        {
+            *comma = '\0';
+            time = strtoul(line, NULL, 0);
+            
+            if(first)
+            {
+                scanTime = time;
+                first = 0;
+            }
+            
+            /* Hold the previous position up to this time */
+            while((scanTime < time) && (scanCount < MAX_SCANS))
+            {
+                scans[scanCount++] = heldPosition;
+                scanTime += scanPeriodMs;
+            }
+            
+            heldPosition = position;
+        }
+        else if(scanCount < MAX_SCANS)
+        {
+            scans[scanCount++] = position;
+        }
+    }
+    
+    /* The last timed position lasts one scan */
+    if((timed > 0) && (scanCount < MAX_SCANS))
+    {
+        scans[scanCount++] = heldPosition;
+    }
+    
+    return (scanCount != 0u) ? 0 : 1;
+}
+
+
+/*****************************************************************************
+* Function Name: Replay()
+******************************************************************************
+* Summary:
+* Runs the trace through a filter with one setting, as 
+* HandleCapSenseSlider() does, and scores what the central would show.
+*
+* Theory:
+* The central shows the last notified position. The tracking error is the
+* difference between the shown and the true position over the touched 
+* scans. A release is stale if the position shown when NO_FINGER is 
+* notified is not the last touched one.
+*
+*****************************************************************************/
+static void Replay(const FILTER_SETTING_T *setting, int printNotifications, REPLAY_RESULT_T *result)
+{
+    NOTIFY_FILTER_T filter;
+    uint16 shown = NO_FINGER;
+    uint16 previous = NO_FINGER;
+    uint16 lastTouched = NO_FINGER;
+    uint16 sendValue;
+    uint32 error;
+    uint32 scan;
+    
+    memset(result, 0, sizeof(*result));
+    NotifyFilter_Init(&filter, setting->deadband, setting->hysteresis, setting->minIntervalScans);
+    
+    for(scan = 0; scan < scanCount; scan++)
+    {
+        /* Out of range centroids are not sent by the lab */
+        if((scans[scan] != NO_FINGER) && (scans[scan] > SLIDER_MAX_VALUE))
+        {
+            continue;
+        }
+        
+        if(scans[scan] != previous)
+        {
+            result->changes++;
+            
+            if(previous == NO_FINGER)
+            {
+                result->touches++;
+            }
+        }
+        
+        if(NotifyFilter_Update(&filter, scans[scan], (scans[scan] == NO_FINGER), &sendValue))
+        {
+            if((sendValue == NO_FINGER) && (shown != NO_FINGER) && (shown != lastTouched))
+            {
+                result->staleReleases++;
+            }
+            
+            shown = sendValue;
+            
+            if(printNotifications)
+            {
+                printf("%u,%u\n", (unsigned)scan, (unsigned)sendValue);
+            }
+        }
+        
+        if(scans[scan] != NO_FINGER)
+        {
+            lastTouched = scans[scan];
+            result->touchedScans++;
+            error = (shown == NO_FINGER) ? 0u : 
+                    ((shown > scans[scan]) ? (uint32)(shown - scans[scan]) : (uint32)(scans[scan] - shown));
+            result->errorSum += error;
+            
+            if(error > result->errorMax)
+            {
+                result->errorMax = error;
+            }
+        }
+        
+        previous = scans[scan];
+    }
+    
+    result->sent = filter.sentCount;
+    result->suppressed = filter.suppressedCount;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Replays the trace with every setting and prints the results.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    FILTER_SETTING_T settings[MAX_SETTINGS];
+    REPLAY_RESULT_T result;
+    const char *tracePath = NULL;
+    uint32 scanPeriodMs = DEFAULT_SCAN_PERIOD_MS;
+    unsigned settingCount = 0;
+    unsigned deadband;
+    unsigned hysteresis;
+    unsigned interval;
+    unsigned index;
+    int printNotifications = 0;
+    int argIndex;
+    FILE *file;
+    
+    for(argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if((strcmp(argv[argIndex], "-c") == 0) && ((argIndex + 1) < argc) && (settingCount < MAX_SETTINGS) &&
+           (sscanf(argv[argIndex + 1], "%u,%u,%u", &deadband, &hysteresis, &interval) == 3))
+        {
+            settings[settingCount].deadband = (uint16)deadband;
+            settings[settingCount].hysteresis = (uint16)hysteresis;
+            settings[settingCount].minIntervalScans = (uint16)interval;
+            settingCount++;
+            argIndex++;
+        }
+        else if((strcmp(argv[argIndex], "-p") == 0) && ((argIndex + 1) < argc))
+        {
+            scanPeriodMs = (uint32)strtoul(argv[++argIndex], NULL, 0);
+        }
+        else if(strcmp(argv[argIndex], "-n") == 0)
+        {
+            printNotifications = 1;
+        }
+        else if((tracePath == NULL) && ((argv[argIndex][0] != '-') || (argv[argIndex][1] == '\0')))
+        {
+            tracePath = argv[argIndex];
+        }
+        else
+        {
+            tracePath = NULL;
+            break;
+        }
+    }
+    
+    if((tracePath == NULL) || (scanPeriodMs == 0u))
+    {
+        fprintf(stderr, "usage: %s [-c deadband,hysteresis,interval]... [-p scan_ms] [-n] trace.csv\n", argv[0]);
+        return 1;
+    }
+    
+    if(settingCount == 0u)
+    {
+        settings[0].deadband = SLIDER_DEADBAND;
+        settings[0].hysteresis = SLIDER_HYSTERESIS;
+        settings[0].minIntervalScans = SLIDER_MIN_INTERVAL_SCANS;
+        settingCount = 1;
+    }
+    
+    file = (strcmp(tracePath, "-") == 0) ? stdin : fopen(tracePath, "r");
+    
+    if((file == NULL) || (LoadTrace(file, scanPeriodMs) != 0))
+    {
+        fprintf(stderr, "%s: no trace\n", tracePath);
+        return 1;
+    }
+    
+    for(index = 0; index < settingCount; index++)
+    {
+        if(printNotifications)
+        {
+            printf("scan,notification\n");
+        }
+        
+        Replay(&settings[index], printNotifications, &result);
+        
+        printf("{\"deadband\":%u,\"hysteresis\":%u,\"min_interval_scans\":%u,\"scans\":%u,\"touches\":%u,"
+               "\"changes\":%u,\"sent\":%u,\"suppressed\":%u,\"sent_per_change\":%.3f,"
+               "\"mean_error\":%.2f,\"max_error\":%u,\"stale_releases\":%u}\n",
+               (unsigned)settings[index].deadband, (unsigned)settings[index].hysteresis, 
+               (unsigned)settings[index].minIntervalScans, (unsigned)scanCount, (unsigned)result.touches,
+               (unsigned)result.changes, (unsigned)result.sent, (unsigned)result.suppressed,
+               (result.changes != 0u) ? ((double)result.sent / result.changes) : 0.0,
+               (result.touchedScans != 0u) ? ((double)result.errorSum / result.touchedScans) : 0.0,
+               (unsigned)result.errorMax, (unsigned)result.staleReleases);
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,248 @@
+/*****************************************************************************
+* File Name: RgbColorBench.c
+*
+* Version: 1.0
+*
+* Description:
+* This file checks and times the RGB LED color conversion of the BLE Lab 3 on
+* a PC. RgbColor.c is included rather than linked, so the bench can check the
+* static ScaleByIntensity() directly. Build with: gcc -O2 -I. -I"../BLE Lab
+* 3.cydsn" -o rgb_color_bench RgbColorBench.c. Run ./rgb_color_bench
+* [updates]. The first output line reports the exhaustive check of
+* ScaleByIntensity() against value * intensity / 255 rounded to nearest, for
+* all 65536 pairs of 8-bit inputs; the second times RgbColor_Convert() with
+* the options of main.h against the three divisions UpdateRGBled() used
+* before, in ns and in time stamp counter ticks per update where the PC has
+* one.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "../BLE Lab 3.cydsn/RgbColor.c"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define DEFAULT_UPDATES                     (20000000u)
+
+/* Colors cycled through by the timing loop */
+#define COLOR_COUNT                         (4096u)
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+/* Divisor of the old path, volatile so the compiler emits a division as the
+ * Cortex-M0 build does with its software division, instead of the 
+ * multiply a PC build would use for a constant divisor */
+static volatile uint16 oldDivisor = RGB_LED_MAX_VAL;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: OldConvert()
+******************************************************************************
+* Summary:
+* The intensity scaling of UpdateRGBled() before RgbColor_Convert(): one 
+* division per channel, truncating, and no gamma correction.
+*
+*****************************************************************************/
+static void __attribute__((noinline)) OldConvert(const uint8 *rgbData, uint8 *density)
+{
+    uint16 divisor = oldDivisor;
+    
+    density[RED_INDEX] = (uint8)(((uint16)rgbData[RED_INDEX] * rgbData[INTENSITY_INDEX]) / divisor);
+    density[GREEN_INDEX] = (uint8)(((uint16)rgbData[GREEN_INDEX] * rgbData[INTENSITY_INDEX]) / divisor);
+    density[BLUE_INDEX] = (uint8)(((uint16)rgbData[BLUE_INDEX] * rgbData[INTENSITY_INDEX]) / divisor);
+}
+
+
+/*****************************************************************************
+* Function Name: NewConvert()
+******************************************************************************
+* Summary:
+* Calls RgbColor_Convert() out of line, as UpdateRGBled() does.
+*
+*****************************************************************************/
+static void __attribute__((noinline)) NewConvert(const uint8 *rgbData, uint8 *density)
+{
+    RgbColor_Convert(rgbData, density);
+}
+
+
+/*****************************************************************************
+* Function Name: ReadTicks()
+******************************************************************************
+* Summary:
+* Returns the time stamp counter of the PC, or 0 where there is none.
+*
+*****************************************************************************/
+static uint64_t ReadTicks(void)
+{
+    #if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+    #else
+    return 0;
+    #endif
+}
+
+
+/*****************************************************************************
+* Function Name: TimeConvert()
+******************************************************************************
+* Summary:
+* Runs a conversion over the colors updates times and returns the ns and
+* the time stamp counter ticks per update.
+*
+*****************************************************************************/
+static double TimeConvert(void (*convert)(const uint8 *, uint8 *), const uint8 (*colors)[4], 
+                          uint32 updates, double *ticksPerUpdate)
+{
+    struct timespec start;
+    struct timespec end;
+    uint8 density[RGB_COLOR_CHANNELS];
+    volatile uint32 sum = 0;
+    uint64_t startTicks;
+    uint32 update;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    startTicks = ReadTicks();
+    
+    for(update = 0; update < updates; update++)
+    {
+        convert(colors[update % COLOR_COUNT], density);
+        sum += density[RED_INDEX];
+    }
+    
+    *ticksPerUpdate = (double)(ReadTicks() - startTicks) / updates;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    
+    return (((double)(end.tv_sec - start.tv_sec) * 1e9) + (double)(end.tv_nsec - start.tv_nsec)) / updates;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Runs the exhaustive check, then times both conversions.
+*
+* Theory:
+* The reference rounds value * intensity / 255 to nearest with integer 
+* arithmetic: (2 * value * intensity + 255) / 510. The largest error of the
+* old truncating division is reported alongside.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    static uint8 colors[COLOR_COUNT][4];
+    uint32 updates = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : DEFAULT_UPDATES;
+    uint32 mismatches = 0;
+    uint32 oldMismatches = 0;
+    uint32 expected;
+    uint32 value;
+    uint32 intensity;
+    uint32 index;
+    double oldTicks;
+    double newTicks;
+    double oldNs;
+    double newNs;
+    
+    if(updates == 0u)
+    {
+        fprintf(stderr, "usage: %s [updates, non-zero]\n", argv[0]);
+        return 1;
+    }
+    
+    for(value = 0; value <= RGB_LED_MAX_VAL; value++)
+    {
+        for(intensity = 0; intensity <= RGB_LED_MAX_VAL; intensity++)
+        {
+            expected = ((2u * value * intensity) + RGB_LED_MAX_VAL) / (2u * RGB_LED_MAX_VAL);
+            
+            if(ScaleByIntensity((uint8)value, (uint8)intensity) != expected)
+            {
+                mismatches++;
+            }
+            
+            if(((value * intensity) / RGB_LED_MAX_VAL) != expected)
+            {
+                oldMismatches++;
+            }
+        }
+    }
+    
+    printf("{\"check\":\"scale_by_intensity\",\"pairs\":%u,\"mismatches\":%u,\"old_division_mismatches\":%u}\n",
+           (unsigned)((RGB_LED_MAX_VAL + 1u) * (RGB_LED_MAX_VAL + 1u)), (unsigned)mismatches, 
+           (unsigned)oldMismatches);
+    
+    srand(1u);
+    
+    for(index = 0; index < COLOR_COUNT; index++)
+    {
+        colors[index][RED_INDEX] = (uint8)rand();
+        colors[index][GREEN_INDEX] = (uint8)rand();
+        colors[index][BLUE_INDEX] = (uint8)rand();
+        colors[index][INTENSITY_INDEX] = (uint8)rand();
+    }
+    
+    oldNs = TimeConvert(OldConvert, (const uint8 (*)[4])colors, updates, &oldTicks);
+    newNs = TimeConvert(NewConvert, (const uint8 (*)[4])colors, updates, &newTicks);
+    
+    printf("{\"check\":\"convert_time\",\"updates\":%u,\"gamma_correction\":%u,\"calibration\":%u,"
+           "\"old_ns_per_update\":%.2f,\"old_ticks_per_update\":%.1f,"
+           "\"ns_per_update\":%.2f,\"ticks_per_update\":%.1f}\n",
+           (unsigned)updates, (unsigned)RGB_GAMMA_CORRECTION, (unsigned)RGB_CALIBRATION,
+           oldNs, oldTicks, newNs, newTicks);
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,400 @@
+/*****************************************************************************
+* File Name: RgbWriteBench.c
+*
+* Version: 1.0
+*
+* Description:
+* This file compares Write Request and Write Command on the RGB LED
+* characteristic of the BLE Lab 3, with a simulated central on a PC.
+* BLEApplications.c is included with the RGB_WRITE_COMMAND option forced on,
+* so the real CustomEventHandler() and ApplyPendingRGBled() take the writes.
+* Build with: gcc -O2 -I. -I"../BLE Lab 3.cydsn" -o rgb_write_bench
+* RgbWriteBench.c "../BLE Lab 3.cydsn/WriteDispatcher.c" "../BLE Lab
+* 3.cydsn/AttributeMirror.c" "../BLE Lab 3.cydsn/RgbColor.c". Run
+* ./rgb_write_bench [-p color_period_ms] [-e pdus_per_event] [-s seconds]. The
+* central's app produces a new color every color_period_ms, 16.7 ms by
+* default, as a color picker dragged at 60 Hz does. Each output line is a JSON object for one write type and
+* connection interval, with the colors written over the air, the LED updates,
+* and the mean and largest lag of the LED: the age of the color it shows at
+* the end of each connection event.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <main.h>
+
+/* Write Command needs a change in the BLE component, so main.h leaves it 
+ * off; the bench turns it on for BLEApplications.c */
+#undef RGB_WRITE_COMMAND
+#define RGB_WRITE_COMMAND               (1)
+
+#include "../BLE Lab 3.cydsn/BLEApplications.c"
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define DEFAULT_COLOR_PERIOD_MS             (16.7)
+#define DEFAULT_PDUS_PER_EVENT              (4u)
+#define DEFAULT_SECONDS                     (10.0)
+
+#define WRITE_REQUEST                       (0u)
+#define WRITE_COMMAND                       (1u)
+
+/* Connection intervals a central may choose, in ms */
+static const double sweepIntervalMs[] = { 7.5, 15.0, 30.0, 50.0 };
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint32 writes;          /* Writes sent over the air */
+    uint32 ledUpdates;      /* Colors written to the RGB LED characteristic */
+    uint32 responses;       /* Write responses sent by the peripheral */
+    uint32 errors;          /* Error responses sent by the peripheral */
+    double lagSumMs;        /* Sum of the age of the color shown */
+    double lagMaxMs;        /* Largest age of the color shown */
+    uint32 lagCount;        /* Events in lagSumMs */
+} BENCH_RESULT_T;
+
+
+/*****************************************************************************
+* GATT DB and stubs of the BLE component and the PrISMs
+*****************************************************************************/
+const CYBLE_CUSTOMS_T cyBle_customs[CYBLE_CUSTOMS_SERVICE_COUNT] =
+{
+    { 0x000Cu, { { RGB_LED_CHAR_HANDLE, { 0x000Fu } } } },
+    { 0x002Cu, { { CAPSENSE_SLIDER_CHAR_HANDLE, { CAPSENSE_CCC_HANDLE } } } }
+};
+
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+static BENCH_RESULT_T result;
+
+/* Set by the write response of the peripheral, cleared when the central 
+ * receives it */
+static uint8 responseQueued = FALSE;
+
+CYBLE_STATE_T CyBle_GetState(void)
+{
+    return CYBLE_STATE_CONNECTED;
+}
+
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType)
+{
+    (void)advertisingIntervalType;
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair, uint16 offset,
+                                                  CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    (void)offset;
+    (void)connHandle;
+    (void)flags;
+    
+    if(handleValuePair->attrHandle == RGB_LED_CHAR_HANDLE)
+    {
+        result.ledUpdates++;
+    }
+    return CYBLE_ERROR_OK;
+}
+
+void CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle)
+{
+    (void)connHandle;
+    
+    result.responses++;
+    responseQueued = TRUE;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_GATTS_ERR_PARAM_T *errRspParam)
+{
+    (void)connHandle;
+    (void)errRspParam;
+    
+    result.errors++;
+    responseQueued = TRUE;
+    return CYBLE_ERROR_OK;
+}
+
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    (void)connHandle;
+    (void)ntfParam;
+    return CYBLE_ERROR_OK;
+}
+
+void PRS_1_WritePulse0(uint8 pulseDensity0)
+{
+    (void)pulseDensity0;
+}
+
+void PRS_1_WritePulse1(uint8 pulseDensity1)
+{
+    (void)pulseDensity1;
+}
+
+void PRS_2_WritePulse0(uint8 pulseDensity0)
+{
+    (void)pulseDensity0;
+}
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: SetColor()
+******************************************************************************
+* Summary:
+* Encodes the number of a color in its red, green and blue bytes, at full 
+* intensity, so the bench can tell which color the LED shows.
+*
+*****************************************************************************/
+static void SetColor(uint8 *rgbData, uint32 color)
+{
+    rgbData[RED_INDEX] = (uint8)color;
+    rgbData[GREEN_INDEX] = (uint8)(color >> 8);
+    rgbData[BLUE_INDEX] = (uint8)(color >> 16);
+    rgbData[INTENSITY_INDEX] = RGB_LED_MAX_VAL;
+}
+
+
+/*****************************************************************************
+* Function Name: ShownColor()
+******************************************************************************
+* Summary:
+* Returns the number of the color in RGBledData.
+*
+*****************************************************************************/
+static uint32 ShownColor(void)
+{
+    return (uint32)RGBledData[RED_INDEX] | ((uint32)RGBledData[GREEN_INDEX] << 8) | 
+           ((uint32)RGBledData[BLUE_INDEX] << 16);
+}
+
+
+/*****************************************************************************
+* Function Name: Run()
+******************************************************************************
+* Summary:
+* Simulates a connection of the given length in which the central writes 
+* the colors of its app with Write Request or Write Command.
+*
+* Theory:
+* A connection event is up to pdusPerEvent exchanges of a central and a 
+* peripheral packet; each write takes the central packet of one exchange. 
+* The peripheral handles the writes received in an event after it, in 
+* CyBle_ProcessEvents() followed by the main loop, and the LED shows the 
+* color at the end of the event.
+* 
+* A Write Request waits for its response. The response goes out in the 
+* peripheral packet of the first exchange of the next event, too late for 
+* the central to answer with a new request 150 us later, so the next 
+* request goes out in the event after: one request every two events. The
+* central always sends its newest color.
+*
+* Write Commands need no response, so the central sends the colors it has 
+* not sent yet in every exchange; when more are waiting than fit in an 
+* event, it sends the newest ones. The peripheral keeps the last command 
+* of an event and ApplyPendingRGBled() shows it once.
+*
+*****************************************************************************/
+static void Run(uint8 writeType, double intervalMs, double colorPeriodMs, uint32 pdusPerEvent, double seconds)
+{
+    CYBLE_GATTS_WRITE_REQ_PARAM_T writeParam;
+    uint8 value[sizeof(RGBledData)];
+    uint32 eventCount = (uint32)((seconds * 1000.0) / intervalMs);
+    uint32 nextColor = 1u;
+    uint32 newestColor;
+    uint32 event;
+    uint32 pdu;
+    uint32 sendCount;
+    uint8 requestOutstanding = FALSE;
+    double now;
+    double lagMs;
+    
+    CustomEventHandler(CYBLE_EVT_GATT_DISCONNECT_IND, NULL);
+    CustomEventHandler(CYBLE_EVT_GATT_CONNECT_IND, NULL);
+    memset(&result, 0, sizeof(result));
+    responseQueued = FALSE;
+    
+    writeParam.connHandle = cyBle_connHandle;
+    writeParam.handleValPair.attrHandle = RGB_LED_CHAR_HANDLE;
+    writeParam.handleValPair.value.val = value;
+    writeParam.handleValPair.value.len = sizeof(value);
+    writeParam.handleValPair.value.actualLen = sizeof(value);
+    
+    for(event = 0; event < eventCount; event++)
+    {
+        now = event * intervalMs;
+        
+        /* Colors 1..newestColor have been produced by the app */
+        newestColor = (uint32)(now / colorPeriodMs) + 1u;
+        
+        if(writeType == WRITE_REQUEST)
+        {
+            /* The first exchange carries the response to the last request; 
+             * the next request waits for the next event */
+            if(responseQueued)
+            {
+                responseQueued = FALSE;
+                requestOutstanding = FALSE;
+            }
+            else if((!requestOutstanding) && (newestColor >= nextColor))
+            {
+                SetColor(value, newestColor);
+                nextColor = newestColor + 1u;
+                requestOutstanding = TRUE;
+                result.writes++;
+                
+                CustomEventHandler(CYBLE_EVT_GATTS_WRITE_REQ, &writeParam);
+            }
+        }
+        else
+        {
+            sendCount = (newestColor >= nextColor) ? (newestColor - nextColor + 1u) : 0u;
+            
+            if(sendCount > pdusPerEvent)
+            {
+                nextColor = newestColor - pdusPerEvent + 1u;
+                sendCount = pdusPerEvent;
+            }
+            
+            for(pdu = 0; pdu < sendCount; pdu++)
+            {
+                SetColor(value, nextColor++);
+                result.writes++;
+                
+                CustomEventHandler(CYBLE_EVT_GATTS_WRITE_CMD_REQ, &writeParam);
+            }
+            
+            ApplyPendingRGBled();
+        }
+        
+        /* Age of the color the LED shows, from when the app produced it */
+        if(ShownColor() != 0u)
+        {
+            lagMs = now - ((ShownColor() - 1u) * colorPeriodMs);
+            result.lagSumMs += lagMs;
+            result.lagCount++;
+            
+            if(lagMs > result.lagMaxMs)
+            {
+                result.lagMaxMs = lagMs;
+            }
+        }
+    }
+    
+    printf("{\"write\":\"%s\",\"interval_ms\":%.1f,\"color_period_ms\":%.1f,\"pdus_per_event\":%u,"
+           "\"colors\":%u,\"writes_per_s\":%.1f,\"led_updates_per_s\":%.1f,\"responses\":%u,\"errors\":%u,"
+           "\"mean_lag_ms\":%.1f,\"max_lag_ms\":%.1f}\n",
+           (writeType == WRITE_REQUEST) ? "request" : "command", intervalMs, colorPeriodMs, 
+           (unsigned)pdusPerEvent, (unsigned)((eventCount * intervalMs) / colorPeriodMs),
+           result.writes / seconds, result.ledUpdates / seconds, (unsigned)result.responses, 
+           (unsigned)result.errors, (result.lagCount != 0u) ? (result.lagSumMs / result.lagCount) : 0.0, 
+           result.lagMaxMs);
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Parses the options and runs both write types for every connection 
+* interval.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    double colorPeriodMs = DEFAULT_COLOR_PERIOD_MS;
+    double seconds = DEFAULT_SECONDS;
+    uint32 pdusPerEvent = DEFAULT_PDUS_PER_EVENT;
+    uint32 index;
+    int arg;
+    
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((strcmp(argv[arg], "-p") == 0) && ((arg + 1) < argc))
+        {
+            colorPeriodMs = atof(argv[++arg]);
+        }
+        else if((strcmp(argv[arg], "-e") == 0) && ((arg + 1) < argc))
+        {
+            pdusPerEvent = (uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((strcmp(argv[arg], "-s") == 0) && ((arg + 1) < argc))
+        {
+            seconds = atof(argv[++arg]);
+        }
+        else
+        {
+            pdusPerEvent = 0;
+            break;
+        }
+    }
+    
+    if((colorPeriodMs <= 0.0) || (seconds <= 0.0) || (pdusPerEvent == 0u))
+    {
+        fprintf(stderr, "usage: %s [-p color_period_ms] [-e pdus_per_event] [-s seconds]\n", argv[0]);
+        return 1;
+    }
+    
+    RegisterWriteHandlers();
+    
+    for(index = 0; index < COUNT_OF(sweepIntervalMs); index++)
+    {
+        Run(WRITE_REQUEST, sweepIntervalMs[index], colorPeriodMs, pdusPerEvent, seconds);
+        Run(WRITE_COMMAND, sweepIntervalMs[index], colorPeriodMs, pdusPerEvent, seconds);
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,410 @@
+/*****************************************************************************
+* File Name: WriteDispatchBench.c
+*
+* Version: 1.0
+*
+* Description:
+* This file floods GATT writes through the write dispatch of the BLE Lab 3 on
+* a PC, and compares it with the if-chain that CustomEventHandler() used
+* before. Build with: gcc -O2 -I. -I"../BLE Lab 3.cydsn" -o
+* write_dispatch_bench WriteDispatchBench.c "../BLE Lab
+* 3.cydsn/WriteDispatcher.c" "../BLE Lab 3.cydsn/AttributeMirror.c". Run
+* ./write_dispatch_bench [writes] [seed]. The GATT DB is one custom service
+* with up to 16 characteristics, each with a 4 byte value and a CCCD. Each
+* output line is a JSON object for one characteristic count, with the time per
+* write of both paths and the number of writes on which they disagree; the
+* last line repeats the two characteristics of the lab.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <main.h>
+#include <BLEApplications.h>
+#include <WriteDispatcher.h>
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define DEFAULT_WRITES                      (1000000u)
+#define DEFAULT_SEED                        (1u)
+
+#define SERVICE_INDEX                       (0u)
+#define VALUE_LEN                           (4u)
+
+/* Share of the writes that go to an attribute without a handler, in % */
+#define UNKNOWN_WRITE_PERCENT               (10u)
+
+/* Handles of the simulated GATT DB: the service declaration at 0x000C, then
+ * per characteristic its declaration, value and CCCD */
+#define FIRST_CHAR_HANDLE                   (0x000Eu)
+#define HANDLES_PER_CHAR                    (3u)
+#define CHAR(index)                         {FIRST_CHAR_HANDLE + (HANDLES_PER_CHAR * (index)), \
+                                             {FIRST_CHAR_HANDLE + (HANDLES_PER_CHAR * (index)) + 1u}}
+
+static const uint8 sweepCharCounts[] = { 1u, 2u, 4u, 8u, 16u, 2u };
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+/* What a write did, to check that both paths agree */
+typedef struct
+{
+    uint32 valueWrites[CYBLE_CUSTOM_SERVICE_CHAR_COUNT];
+    uint8 values[CYBLE_CUSTOM_SERVICE_CHAR_COUNT][VALUE_LEN];
+    uint8 cccdFlags[CYBLE_CUSTOM_SERVICE_CHAR_COUNT];
+    uint32 dbWrites;
+} BENCH_STATE_T;
+
+
+/*****************************************************************************
+* GATT DB and stubs of the BLE component
+*****************************************************************************/
+const CYBLE_CUSTOMS_T cyBle_customs[CYBLE_CUSTOMS_SERVICE_COUNT] =
+{
+    {
+        0x000Cu,
+        {
+            CHAR(0), CHAR(1), CHAR(2), CHAR(3), CHAR(4), CHAR(5), CHAR(6), CHAR(7), 
+            CHAR(8), CHAR(9), CHAR(10), CHAR(11), CHAR(12), CHAR(13), CHAR(14), CHAR(15)
+        }
+    }
+};
+
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+static BENCH_STATE_T state;
+
+CYBLE_API_RESULT_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair, uint16 offset,
+                                                  CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    (void)handleValuePair;
+    (void)offset;
+    (void)connHandle;
+    (void)flags;
+    
+    state.dbWrites++;
+    return CYBLE_ERROR_OK;
+}
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: HandleValueWrite()
+******************************************************************************
+* Summary:
+* Write handler of every characteristic value, like HandleRGBledWrite(): 
+* copies the value.
+*
+*****************************************************************************/
+static void HandleValueWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair)
+{
+    uint32 charIndex = (handleValPair->attrHandle - FIRST_CHAR_HANDLE) / HANDLES_PER_CHAR;
+    
+    memcpy(state.values[charIndex], handleValPair->value.val, VALUE_LEN);
+    state.valueWrites[charIndex]++;
+}
+
+
+/*****************************************************************************
+* Function Name: OldWrite()
+******************************************************************************
+* Summary:
+* The write request branch of CustomEventHandler() before the dispatcher,
+* for charCount characteristics.
+*
+* Theory:
+* The old branch had one if per attribute, in the order of the 
+* characteristics, each comparing the handle with a nested cyBle_customs[] 
+* lookup. The ifs were not chained with else, so every write ran every 
+* comparison. The loop below runs the same comparisons and the same body 
+* for each match: the value is copied, or the notification flag set and 
+* the CCCD written back. Nothing checked the length or the handle.
+*
+*****************************************************************************/
+static void OldWrite(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValPair, uint8 charCount)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T cccdHandle;
+    uint8 cccdValue[CCC_DATA_LEN];
+    uint8 charIndex;
+    
+    for(charIndex = 0; charIndex < charCount; charIndex++)
+    {
+        if(handleValPair->attrHandle == cyBle_customs[SERVICE_INDEX].
+                                        customServiceInfo[charIndex].customServiceCharHandle)
+        {
+            memcpy(state.values[charIndex], handleValPair->value.val, VALUE_LEN);
+            state.valueWrites[charIndex]++;
+        }
+        
+        if(handleValPair->attrHandle == cyBle_customs[SERVICE_INDEX].
+                                        customServiceInfo[charIndex].customServiceCharDescriptors[0])
+        {
+            state.cccdFlags[charIndex] = handleValPair->value.val[CCC_DATA_INDEX];
+            
+            cccdValue[0] = state.cccdFlags[charIndex];
+            cccdValue[1] = 0x00;
+            
+            cccdHandle.attrHandle = handleValPair->attrHandle;
+            cccdHandle.value.val = cccdValue;
+            cccdHandle.value.len = sizeof(cccdValue);
+            
+            CyBle_GattsWriteAttributeValue(&cccdHandle, ZERO, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: RegisterEntries()
+******************************************************************************
+* Summary:
+* Registers a value and a CCCD entry for each of charCount characteristics
+* with the dispatcher, without CCCD mirrors as in the old path.
+*
+*****************************************************************************/
+static void RegisterEntries(WRITE_DISPATCH_ENTRY_T *entries, uint8 charCount)
+{
+    uint8 charIndex;
+    
+    memset(entries, 0, 2u * charCount * sizeof(*entries));
+    
+    for(charIndex = 0; charIndex < charCount; charIndex++)
+    {
+        entries[2u * charIndex].serviceIndex = SERVICE_INDEX;
+        entries[2u * charIndex].charIndex = charIndex;
+        entries[2u * charIndex].descriptorIndex = WRITE_DISPATCH_CHAR_VALUE;
+        entries[2u * charIndex].minLen = VALUE_LEN;
+        entries[2u * charIndex].maxLen = VALUE_LEN;
+        entries[2u * charIndex].handler = HandleValueWrite;
+        
+        entries[(2u * charIndex) + 1u].serviceIndex = SERVICE_INDEX;
+        entries[(2u * charIndex) + 1u].charIndex = charIndex;
+        entries[(2u * charIndex) + 1u].descriptorIndex = 0u;
+        entries[(2u * charIndex) + 1u].minLen = CCC_DATA_LEN;
+        entries[(2u * charIndex) + 1u].maxLen = CCC_DATA_LEN;
+        entries[(2u * charIndex) + 1u].cccdFlag = &state.cccdFlags[charIndex];
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: MakeWrites()
+******************************************************************************
+* Summary:
+* Fills the flood: random values to random values and CCCDs of the 
+* characteristics, and UNKNOWN_WRITE_PERCENT of writes to the service 
+* declaration, which has no handler.
+*
+*****************************************************************************/
+static void MakeWrites(CYBLE_GATT_HANDLE_VALUE_PAIR_T *writes, uint8 *data, uint32 writeCount, uint8 charCount)
+{
+    uint32 index;
+    uint32 charIndex;
+    
+    for(index = 0; index < writeCount; index++)
+    {
+        charIndex = (uint32)rand() % charCount;
+        writes[index].value.val = &data[index * VALUE_LEN];
+        
+        if(((uint32)rand() % 100u) < UNKNOWN_WRITE_PERCENT)
+        {
+            writes[index].attrHandle = cyBle_customs[SERVICE_INDEX].customServiceHandle;
+            writes[index].value.len = VALUE_LEN;
+        }
+        else if((rand() & 1) != 0)
+        {
+            writes[index].attrHandle = cyBle_customs[SERVICE_INDEX].customServiceInfo[charIndex].
+                                       customServiceCharHandle;
+            writes[index].value.len = VALUE_LEN;
+        }
+        else
+        {
+            writes[index].attrHandle = cyBle_customs[SERVICE_INDEX].customServiceInfo[charIndex].
+                                       customServiceCharDescriptors[0];
+            writes[index].value.len = CCC_DATA_LEN;
+        }
+        
+        data[index * VALUE_LEN] = (uint8)(((uint32)rand() % 100u) < 50u);
+        data[(index * VALUE_LEN) + 1u] = (uint8)rand();
+        data[(index * VALUE_LEN) + 2u] = (uint8)rand();
+        data[(index * VALUE_LEN) + 3u] = (uint8)rand();
+        writes[index].value.actualLen = writes[index].value.len;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: ElapsedNs()
+******************************************************************************
+* Summary:
+* Returns the time between two clock readings in nanoseconds.
+*
+*****************************************************************************/
+static double ElapsedNs(const struct timespec *start, const struct timespec *end)
+{
+    return ((double)(end->tv_sec - start->tv_sec) * 1e9) + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Floods both paths with the same writes for every characteristic count.
+*
+* Theory:
+* The dispatcher rejects the writes without a handler and the old path 
+* silently accepted them, so only the state the writes leave behind is 
+* compared: the values, the value write counts and the notification flags.
+* A write with a mismatch in that state counts as a disagreement.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    WRITE_DISPATCH_ENTRY_T entries[2u * CYBLE_CUSTOM_SERVICE_CHAR_COUNT];
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T *writes;
+    BENCH_STATE_T oldState;
+    struct timespec start;
+    struct timespec end;
+    uint8 *data;
+    uint32 writeCount = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : DEFAULT_WRITES;
+    uint32 seed = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : DEFAULT_SEED;
+    uint32 rejected;
+    uint32 mismatches;
+    uint32 index;
+    uint32 sweep;
+    uint8 charCount;
+    double oldNs;
+    double newNs;
+    
+    writes = malloc(writeCount * sizeof(*writes));
+    data = malloc(writeCount * VALUE_LEN);
+    
+    if((writeCount == 0u) || (writes == NULL) || (data == NULL))
+    {
+        fprintf(stderr, "usage: %s [writes, non-zero] [seed]\n", argv[0]);
+        return 1;
+    }
+    
+    srand(seed);
+    
+    for(sweep = 0; sweep < COUNT_OF(sweepCharCounts); sweep++)
+    {
+        charCount = sweepCharCounts[sweep];
+        MakeWrites(writes, data, writeCount, charCount);
+        
+        /* Old path, timed over the whole flood */
+        memset(&state, 0, sizeof(state));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        
+        for(index = 0; index < writeCount; index++)
+        {
+            OldWrite(&writes[index], charCount);
+        }
+        
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        oldNs = ElapsedNs(&start, &end);
+        
+        /* Dispatcher, timed over the whole flood */
+        memset(&state, 0, sizeof(state));
+        RegisterEntries(entries, charCount);
+        WriteDispatcher_Init(entries, (uint8)(2u * charCount));
+        rejected = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        
+        for(index = 0; index < writeCount; index++)
+        {
+            rejected += (WriteDispatcher_Dispatch(&writes[index]) != CYBLE_GATT_ERR_NONE) ? 1u : 0u;
+        }
+        
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        newNs = ElapsedNs(&start, &end);
+        
+        /* Both paths again, write by write, to compare the state */
+        mismatches = 0;
+        memset(&oldState, 0, sizeof(oldState));
+        memset(&state, 0, sizeof(state));
+        
+        for(index = 0; index < writeCount; index++)
+        {
+            BENCH_STATE_T newState;
+            
+            newState = state;
+            state = oldState;
+            OldWrite(&writes[index], charCount);
+            oldState = state;
+            
+            state = newState;
+            (void)WriteDispatcher_Dispatch(&writes[index]);
+            
+            if((memcmp(oldState.values, state.values, sizeof(state.values)) != 0) ||
+               (memcmp(oldState.valueWrites, state.valueWrites, sizeof(state.valueWrites)) != 0) ||
+               (memcmp(oldState.cccdFlags, state.cccdFlags, sizeof(state.cccdFlags)) != 0))
+            {
+                mismatches++;
+                state = oldState;
+            }
+        }
+        
+        printf("{\"characteristics\":%u,\"attributes\":%u,\"writes\":%u,\"rejected\":%u,"
+               "\"old_ns_per_write\":%.1f,\"dispatch_ns_per_write\":%.1f,\"speedup\":%.2f,\"mismatches\":%u}\n",
+               (unsigned)charCount, (unsigned)(2u * charCount), (unsigned)writeCount, (unsigned)rejected,
+               oldNs / writeCount, newNs / writeCount, (newNs > 0.0) ? (oldNs / newNs) : 0.0, 
+               (unsigned)mismatches);
+    }
+    
+    free(writes);
+    free(data);
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,214 @@
+/*****************************************************************************
+* File Name: project.h
+*
+* Version: 1.0
+*
+* Description:
+* This file stands in for the PSoC Creator generated project.h when code of
+* the BLE Lab 3 is built on a PC by the tools in this folder. It declares only
+* the cytypes.h types and the BLE component and PrISM types and APIs that 
+* the modules built by the tools use; the tools implement the APIs and the
+* GATT DB.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(_HOST_PROJECT_H)
+#define _HOST_PROJECT_H
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*****************************************************************************
+* cytypes.h
+*****************************************************************************/
+typedef uint8_t     uint8;
+typedef uint16_t    uint16;
+typedef uint32_t    uint32;
+typedef int8_t      int8;
+typedef int16_t     int16;
+typedef int32_t     int32;
+
+#define LO8(x)                  ((uint8)((x) & 0xFFu))
+#define HI8(x)                  ((uint8)((uint16)(x) >> 8))
+
+
+/*****************************************************************************
+* BLE component, with a GATT DB sized for the tools
+*****************************************************************************/
+#define CYBLE_GATT_DB_INDEX_COUNT                       (0x40u)
+#define CYBLE_CUSTOMS_SERVICE_COUNT                     (2u)
+#define CYBLE_CUSTOM_SERVICE_CHAR_COUNT                 (16u)
+#define CYBLE_CUSTOM_SERVICE_CHAR_DESCRIPTORS_COUNT     (1u)
+
+#define CYBLE_GATT_DB_LOCALLY_INITIATED                 (0x00u)
+#define CYBLE_GATT_DB_PEER_INITIATED                    (0x40u)
+
+#define CYBLE_GATT_DEFAULT_MTU                          (23u)
+#define CYBLE_GATT_MTU                                  (0x200u)
+#define CYBLE_GATT_WRITE_REQ                            (0x12u)
+
+/* The RGB LED service is the first custom service and the CapSense service
+ * the second, each with its characteristic first: handles 0x000C and 
+ * 0x002C for the services, then per characteristic its declaration, value
+ * and CCCD. */
+#define CYBLE_RGB_LED_SERVICE_SERVICE_INDEX                                                               (0u)
+#define CYBLE_RGB_LED_SERVICE_RGB_LED_CHARACTERISTIC_CHAR_INDEX                                           (0u)
+#define CYBLE_RGB_LED_SERVICE_RGB_LED_CHARACTERISTIC_CHAR_HANDLE                                          (0x000Eu)
+#define CYBLE_CAPSENSE_SERVICE_SERVICE_INDEX                                                              (1u)
+#define CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CHAR_INDEX                                  (0u)
+#define CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CHAR_HANDLE                                 (0x002Eu)
+#define CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX  (0u)
+#define CYBLE_CAPSENSE_SERVICE_CAPSENSE_SLIDER_CHARACTERISTIC_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE (0x002Fu)
+
+enum
+{
+    CYBLE_EVT_STACK_ON = 1,
+    CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP,
+    CYBLE_EVT_GAP_DEVICE_DISCONNECTED,
+    CYBLE_EVT_GATT_CONNECT_IND,
+    CYBLE_EVT_GATT_DISCONNECT_IND,
+    CYBLE_EVT_GATTS_XCNHG_MTU_REQ,
+    CYBLE_EVT_GATTS_WRITE_REQ,
+    CYBLE_EVT_GATTS_WRITE_CMD_REQ
+};
+
+typedef enum
+{
+    CYBLE_STATE_STOPPED,
+    CYBLE_STATE_INITIALIZING,
+    CYBLE_STATE_CONNECTED,
+    CYBLE_STATE_ADVERTISING,
+    CYBLE_STATE_DISCONNECTED
+} CYBLE_STATE_T;
+
+typedef enum
+{
+    CYBLE_ADVERTISING_FAST,
+    CYBLE_ADVERTISING_SLOW
+} CYBLE_ADV_MODE_T;
+
+typedef enum
+{
+    CYBLE_ERROR_OK = 0
+} CYBLE_API_RESULT_T;
+
+typedef enum
+{
+    CYBLE_GATT_ERR_NONE = 0x00,
+    CYBLE_GATT_ERR_INVALID_HANDLE = 0x01,
+    CYBLE_GATT_ERR_WRITE_NOT_PERMITTED = 0x03,
+    CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN = 0x0D
+} CYBLE_GATT_ERR_CODE_T;
+
+typedef uint16 CYBLE_GATT_DB_ATTR_HANDLE_T;
+
+typedef struct
+{
+    uint8 bdHandle;
+    uint8 attId;
+} CYBLE_CONN_HANDLE_T;
+
+typedef struct
+{
+    uint8 *val;
+    uint16 len;
+    uint16 actualLen;
+} CYBLE_GATT_VALUE_T;
+
+typedef struct
+{
+    CYBLE_GATT_VALUE_T value;
+    CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle;
+} CYBLE_GATT_HANDLE_VALUE_PAIR_T;
+
+typedef CYBLE_GATT_HANDLE_VALUE_PAIR_T CYBLE_GATTS_HANDLE_VALUE_NTF_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValPair;
+} CYBLE_GATTS_WRITE_REQ_PARAM_T;
+
+typedef CYBLE_GATTS_WRITE_REQ_PARAM_T CYBLE_GATTS_WRITE_CMD_REQ_PARAM_T;
+
+typedef struct
+{
+    CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle;
+    uint8 opcode;
+    CYBLE_GATT_ERR_CODE_T errorCode;
+} CYBLE_GATTS_ERR_PARAM_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    uint16 mtu;
+} CYBLE_GATT_XCHG_MTU_PARAM_T;
+
+typedef struct
+{
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServiceCharHandle;
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServiceCharDescriptors[CYBLE_CUSTOM_SERVICE_CHAR_DESCRIPTORS_COUNT];
+} CYBLE_CUSTOMS_INFO_T;
+
+typedef struct
+{
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServiceHandle;
+    CYBLE_CUSTOMS_INFO_T customServiceInfo[CYBLE_CUSTOM_SERVICE_CHAR_COUNT];
+} CYBLE_CUSTOMS_T;
+
+extern const CYBLE_CUSTOMS_T cyBle_customs[CYBLE_CUSTOMS_SERVICE_COUNT];
+extern CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+CYBLE_STATE_T CyBle_GetState(void);
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType);
+CYBLE_API_RESULT_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair, uint16 offset,
+                                                  CYBLE_CONN_HANDLE_T *connHandle, uint8 flags);
+void CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle);
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_GATTS_ERR_PARAM_T *errRspParam);
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam);
+
+
+/*****************************************************************************
+* PrISM components of the RGB LED
+*****************************************************************************/
+void PRS_1_WritePulse0(uint8 pulseDensity0);
+void PRS_1_WritePulse1(uint8 pulseDensity1);
+void PRS_2_WritePulse0(uint8 pulseDensity0);
+
+#endif
+
+/* [] END OF FILE */
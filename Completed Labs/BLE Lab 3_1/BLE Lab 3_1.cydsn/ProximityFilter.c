@@ -0,0 +1,204 @@
+/*****************************************************************************
+* File Name: ProximityFilter.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the fixed-point filter pipeline for the proximity sensor
+* implemented as part of the PSoC 4 BLE Lab 4 additional exercise 1. Every
+* scan goes through a median-of-3 spike filter and a first-order IIR low pass,
+* and the result is decimated so that the notification rate follows the filter
+* bandwidth rather than the scan rate.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <ProximityFilter.h>
+
+
+/*****************************************************************************
+* Static function prototypes
+*****************************************************************************/
+static uint16 MedianOfThree(uint16 a, uint16 b, uint16 c);
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: ProximityFilter_Init
+********************************************************************************
+* Summary:
+* Sets the filter configuration and clears its state. The next scan primes 
+* the filter, so the output starts at the first raw value instead of 
+* ramping up from zero.
+*
+* Parameters:
+*  filter:     Filter to initialize
+*  iirShift:   IIR time constant in scans is about 2^iirShift, 0 disables it
+*  decimation: Number of scans per output value, 0 and 1 output every scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ProximityFilter_Init(PROXIMITY_FILTER_T *filter, uint8 iirShift, uint8 decimation)
+{
+    uint8 i;
+    
+    filter->iirShift = iirShift;
+    filter->decimation = (decimation > 1u) ? decimation : 1u;
+    
+    for(i = 0; i < PROXIMITY_FILTER_MEDIAN_LEN; i++)
+    {
+        filter->history[i] = 0;
+    }
+    filter->historyIndex = 0;
+    filter->primed = FALSE;
+    filter->iirState = 0;
+    filter->decimationCount = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: ProximityFilter_Update
+********************************************************************************
+* Summary:
+* Runs one raw scan through the median and IIR stages and returns a new 
+* output every decimation scans. Takes the same time for every scan.
+*
+* Parameters:
+*  filter:        Filter state
+*  rawValue:      Difference count of the present scan
+*  filteredValue: Returns the filtered value when the function returns TRUE
+*
+* Return:
+*  uint8: TRUE if *filteredValue holds a new output
+*
+*******************************************************************************/
+uint8 ProximityFilter_Update(PROXIMITY_FILTER_T *filter, uint16 rawValue, uint16 *filteredValue)
+{
+    uint16 median;
+    uint32 target;
+    uint32 step;
+    uint8 i;
+    
+    if(FALSE == filter->primed)
+    {
+        for(i = 0; i < PROXIMITY_FILTER_MEDIAN_LEN; i++)
+        {
+            filter->history[i] = rawValue;
+        }
+        filter->iirState = (uint32)rawValue << PROXIMITY_FILTER_FRAC_BITS;
+        filter->primed = TRUE;
+    }
+    
+    /* Median of the last three scans removes single-scan spikes */
+    filter->history[filter->historyIndex] = rawValue;
+    filter->historyIndex++;
+    if(filter->historyIndex >= PROXIMITY_FILTER_MEDIAN_LEN)
+    {
+        filter->historyIndex = 0;
+    }
+    median = MedianOfThree(filter->history[0], filter->history[1], filter->history[2]);
+    
+    /* First-order low pass, y += (x - y) / 2^iirShift */
+    target = (uint32)median << PROXIMITY_FILTER_FRAC_BITS;
+    if(target >= filter->iirState)
+    {
+        step = (target - filter->iirState) >> filter->iirShift;
+        filter->iirState += step;
+    }
+    else
+    {
+        /* Round a falling step up so the output settles at zero, which the
+         * notification filter takes as the release */
+        step = ((filter->iirState - target) + ((1u << filter->iirShift) - 1u)) >> filter->iirShift;
+        filter->iirState -= step;
+    }
+    
+    filter->decimationCount++;
+    if(filter->decimationCount < filter->decimation)
+    {
+        return FALSE;
+    }
+    filter->decimationCount = 0;
+    
+    /* Round to the nearest count */
+    *filteredValue = (uint16)((filter->iirState + (1u << (PROXIMITY_FILTER_FRAC_BITS - 1u))) >> PROXIMITY_FILTER_FRAC_BITS);
+    
+    return TRUE;
+}
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: MedianOfThree
+********************************************************************************
+* Summary:
+* Returns the median of three values.
+*
+* Parameters:
+*  a, b, c: Values
+*
+* Return:
+*  uint16: The value that is neither the smallest nor the largest
+*
+*******************************************************************************/
+static uint16 MedianOfThree(uint16 a, uint16 b, uint16 c)
+{
+    if(a > b)
+    {
+        if(b > c)
+        {
+            return b;
+        }
+        return (a > c) ? c : a;
+    }
+    
+    if(a > c)
+    {
+        return a;
+    }
+    return (b > c) ? c : b;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*****************************************************************************
+* File Name: ProximityFilter.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the fixed-point filter pipeline for the proximity sensor
+* implemented as part of the PSoC 4 BLE Lab 4 additional exercise 1.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_PROXIMITY_FILTER_H)
+#define _PROXIMITY_FILTER_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Fraction bits kept by the IIR state */
+#define PROXIMITY_FILTER_FRAC_BITS      (8u)
+
+/* Number of scans the spike filter looks at */
+#define PROXIMITY_FILTER_MEDIAN_LEN     (3u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* Configuration, set by ProximityFilter_Init() */
+    uint8 iirShift;             /* IIR weight of a new sample is 1/2^iirShift */
+    uint8 decimation;           /* One output every this many scans */
+    
+    /* Median-of-3 spike filter, last three raw scans */
+    uint16 history[PROXIMITY_FILTER_MEDIAN_LEN];
+    uint8 historyIndex;
+    uint8 primed;
+    
+    /* IIR output with PROXIMITY_FILTER_FRAC_BITS fraction bits */
+    uint32 iirState;
+    
+    /* Scans since the last output */
+    uint8 decimationCount;
+} PROXIMITY_FILTER_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void ProximityFilter_Init(PROXIMITY_FILTER_T *filter, uint8 iirShift, uint8 decimation);
+uint8 ProximityFilter_Update(PROXIMITY_FILTER_T *filter, uint16 rawValue, uint16 *filteredValue);
+
+
+#endif  /* #if !defined(_PROXIMITY_FILTER_H) */
+
+/* [] END OF FILE */
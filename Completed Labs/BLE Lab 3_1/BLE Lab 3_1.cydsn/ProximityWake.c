@@ -0,0 +1,269 @@
+/*****************************************************************************
+* File Name: ProximityWake.c
+*
+* Version: 1.0
+*
+* Description:
+* This file contains the two-tier proximity scan policy implemented as part of
+* the PSoC 4 BLE Lab 4 additional exercise 1. With nothing near the sensor it
+* is scanned at a slow rate timed by the watchdog, and the device sleeps in
+* between. A difference count above the wake threshold switches to back-to-
+* back scanning until the sensor has been quiet for a timeout.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <ProximityWake.h>
+
+
+#if PROXIMITY_WAKE_MODE
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+#define MS_PER_SECOND                   (1000u)
+
+
+/*****************************************************************************
+* Static variables 
+*****************************************************************************/
+static uint8 scanTier = PROXIMITY_TIER_SLOW;
+
+/* Time of the last slow scan, the last activity in the fast tier and the 
+ * last tier time update */
+static uint32 lastSlowScan = 0;
+static uint32 lastActivity = 0;
+static uint32 lastTierUpdate = 0;
+
+/* Scans counted towards scansPerSecond */
+static uint32 secondStart = 0;
+static uint16 secondScans = 0;
+
+static PROXIMITY_WAKE_STATS_T wakeStats;
+
+
+/*****************************************************************************
+* Static function prototypes
+*****************************************************************************/
+static void UpdateTierTime(uint32 timestamp);
+
+
+/*****************************************************************************
+* Public function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: ProximityWake_Start
+********************************************************************************
+* Summary:
+* Starts in the slow tier with the first scan due at once, and clears the 
+* statistics.
+*
+* Parameters:
+*  timestamp: Present watchdog timestamp in ms
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ProximityWake_Start(uint32 timestamp)
+{
+    uint8 tier;
+    
+    scanTier = PROXIMITY_TIER_SLOW;
+    lastSlowScan = timestamp - PROXIMITY_SLOW_SCAN_MS;
+    lastActivity = timestamp;
+    lastTierUpdate = timestamp;
+    secondStart = timestamp;
+    secondScans = 0;
+    
+    for(tier = 0; tier < PROXIMITY_TIER_COUNT; tier++)
+    {
+        wakeStats.scanCount[tier] = 0;
+        wakeStats.tierTimeMs[tier] = 0;
+    }
+    wakeStats.scansPerSecond = 0;
+    wakeStats.wakeCount = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: ProximityWake_IsScanDue
+********************************************************************************
+* Summary:
+* Returns whether the proximity sensor should be scanned now: always in the
+* fast tier, every PROXIMITY_SLOW_SCAN_MS in the slow tier.
+*
+* Parameters:
+*  timestamp: Present watchdog timestamp in ms
+*
+* Return:
+*  uint8: TRUE if a scan is due
+*
+*******************************************************************************/
+uint8 ProximityWake_IsScanDue(uint32 timestamp)
+{
+    if(PROXIMITY_TIER_FAST == scanTier)
+    {
+        return TRUE;
+    }
+    
+    return ((timestamp - lastSlowScan) >= PROXIMITY_SLOW_SCAN_MS) ? TRUE : FALSE;
+}
+
+
+/*******************************************************************************
+* Function Name: ProximityWake_Update
+********************************************************************************
+* Summary:
+* Takes the result of a scan and moves between the tiers. A difference 
+* count of PROXIMITY_WAKE_THRESHOLD or more wakes the fast tier and keeps it
+* awake; after PROXIMITY_QUIET_TIMEOUT_MS below the threshold it steps back
+* to the slow tier.
+*
+* Parameters:
+*  timestamp: Watchdog timestamp of the scan in ms
+*  diffCount: Raw difference count of the scan
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ProximityWake_Update(uint32 timestamp, uint16 diffCount)
+{
+    UpdateTierTime(timestamp);
+    
+    wakeStats.scanCount[scanTier]++;
+    secondScans++;
+    
+    if(PROXIMITY_TIER_SLOW == scanTier)
+    {
+        lastSlowScan = timestamp;
+    }
+    
+    if(diffCount >= PROXIMITY_WAKE_THRESHOLD)
+    {
+        lastActivity = timestamp;
+        
+        if(PROXIMITY_TIER_SLOW == scanTier)
+        {
+            scanTier = PROXIMITY_TIER_FAST;
+            wakeStats.wakeCount++;
+        }
+    }
+    else if((PROXIMITY_TIER_FAST == scanTier) && 
+            ((timestamp - lastActivity) >= PROXIMITY_QUIET_TIMEOUT_MS))
+    {
+        scanTier = PROXIMITY_TIER_SLOW;
+        lastSlowScan = timestamp;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ProximityWake_GetTier
+********************************************************************************
+* Summary:
+* Returns the present scan tier. The device may sleep between scans only in
+* the slow tier.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8: PROXIMITY_TIER_SLOW or PROXIMITY_TIER_FAST
+*
+*******************************************************************************/
+uint8 ProximityWake_GetTier(void)
+{
+    return scanTier;
+}
+
+
+/*******************************************************************************
+* Function Name: ProximityWake_GetStats
+********************************************************************************
+* Summary:
+* Copies the scan statistics, for a debugger watch or a diagnostic readout.
+*
+* Parameters:
+*  stats: Returns the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ProximityWake_GetStats(PROXIMITY_WAKE_STATS_T *stats)
+{
+    *stats = wakeStats;
+}
+
+
+/*****************************************************************************
+* Static function definitions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: UpdateTierTime
+********************************************************************************
+* Summary:
+* Adds the time since the last update to the present tier and closes the 
+* scans per second window once a second has passed.
+*
+* Parameters:
+*  timestamp: Present watchdog timestamp in ms
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void UpdateTierTime(uint32 timestamp)
+{
+    wakeStats.tierTimeMs[scanTier] += timestamp - lastTierUpdate;
+    lastTierUpdate = timestamp;
+    
+    if((timestamp - secondStart) >= MS_PER_SECOND)
+    {
+        wakeStats.scansPerSecond = secondScans;
+        secondScans = 0;
+        secondStart = timestamp;
+    }
+}
+
+#endif  /* #if PROXIMITY_WAKE_MODE */
+
+
+/* [] END OF FILE */
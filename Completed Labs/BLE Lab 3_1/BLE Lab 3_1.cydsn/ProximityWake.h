@@ -0,0 +1,88 @@
+/*****************************************************************************
+* File Name: ProximityWake.h
+*
+* Version: 1.0
+*
+* Description:
+* This file declares the two-tier proximity scan policy implemented as part of
+* the PSoC 4 BLE Lab 4 additional exercise 1.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+#if !defined(_PROXIMITY_WAKE_H)
+#define _PROXIMITY_WAKE_H
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <project.h>
+
+
+/*****************************************************************************
+* Macros 
+*****************************************************************************/
+#define PROXIMITY_TIER_SLOW             (0u)
+#define PROXIMITY_TIER_FAST             (1u)
+#define PROXIMITY_TIER_COUNT            (2u)
+
+
+/*****************************************************************************
+* Data Types
+*****************************************************************************/
+typedef struct
+{
+    /* Scans and milliseconds spent in each tier since start */
+    uint32 scanCount[PROXIMITY_TIER_COUNT];
+    uint32 tierTimeMs[PROXIMITY_TIER_COUNT];
+    
+    /* Scans in the last complete second */
+    uint16 scansPerSecond;
+    
+    /* Switches from the slow to the fast tier */
+    uint32 wakeCount;
+} PROXIMITY_WAKE_STATS_T;
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+void ProximityWake_Start(uint32 timestamp);
+uint8 ProximityWake_IsScanDue(uint32 timestamp);
+void ProximityWake_Update(uint32 timestamp, uint16 diffCount);
+uint8 ProximityWake_GetTier(void);
+void ProximityWake_GetStats(PROXIMITY_WAKE_STATS_T *stats);
+
+
+#endif  /* #if !defined(_PROXIMITY_WAKE_H) */
+
+/* [] END OF FILE */
@@ -1,177 +1,319 @@
-/*****************************************************************************
-* File Name: main.c
-*
-* Version: 1.0
-*
-* Description:
-* This is the top level application for the PSoC 4 BLE Lab 4 additional 
-* exercise 1.
-*
-* Hardware Dependency:
-* CY8CKIT-042 BLE Pioneer Kit
-*
-******************************************************************************
-* Copyright (2014), Cypress Semiconductor Corporation.
-******************************************************************************
-* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
-* protected by and subject to worldwide patent protection (United States and
-* foreign), United States copyright laws and international treaty provisions.
-* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
-* license to copy, use, modify, create derivative works of, and compile the
-* Cypress Source Code and derivative works for the sole purpose of creating
-* custom software in support of licensee product to be used only in conjunction
-* with a Cypress integrated circuit as specified in the applicable agreement.
-* Any reproduction, modification, translation, compilation, or representation of
-* this software except as specified above is prohibited without the express
-* written permission of Cypress.
-*
-* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
-* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
-* Cypress reserves the right to make changes without further notice to the
-* materials described herein. Cypress does not assume any liability arising out
-* of the application or use of any product or circuit described herein. Cypress
-* does not authorize its products for use as critical components in life-support
-* systems where a malfunction or failure may reasonably be expected to result in
-* significant injury to the user. The inclusion of Cypress' product in a life-
-* support systems application implies that the manufacturer assumes all risk of
-* such use and in doing so indemnifies Cypress against all charges. Use may be
-* limited by and subject to the applicable Cypress software license agreement.
-*****************************************************************************/
-
-
-/*****************************************************************************
-* Included headers
-*****************************************************************************/
-#include <main.h>
-#include <BLEApplications.h>
-
-
-/*****************************************************************************
-* Function Prototypes
-*****************************************************************************/
-static void InitializeSystem(void);
-static void HandleCapSenseProximity(void);
-
-
-/*****************************************************************************
-* Public functions
-*****************************************************************************/
-
-/*******************************************************************************
-* Function Name: main
-********************************************************************************
-* Summary:
-* System entrance point. This calls the initializing function and continuously
-* process BLE and CapSense events.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  int
-*
-*******************************************************************************/
-int main()
-{
-	/* This function will initialize the system resources such as BLE and CapSense */
-    InitializeSystem();
-	
-    for(;;)
-    {
-        /*Process event callback to handle BLE events. The events generated and 
-		* used for this application are inside the 'CustomEventHandler' routine*/
-        CyBle_ProcessEvents();
-		
-		if(TRUE == deviceConnected)
-		{
-            /* Send CapSense Proximity data when respective notification is enabled */
-			if(TRUE == sendCapSenseProximityNotifications)
-			{
-				/* Check for CapSense proximity sensor and send data accordingly */
-				HandleCapSenseProximity();
-			}
-		}
-    }	
-}
-
-
-/*******************************************************************************
-* Function Name: InitializeSystem
-********************************************************************************
-* Summary:
-* Start the components and initialize system.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void InitializeSystem(void)
-{
-	/* Enable global interrupt mask */
-	CyGlobalIntEnable; 
-		
-	/* Start BLE component and register the CustomEventHandler function. This 
-	 * function exposes the events from BLE component for application use */
-    CyBle_Start(CustomEventHandler);	
-    
-	/* Start both the PrISM components for LED control*/
-    PRS_1_Start();
-    PRS_2_Start();
-	
-	/* The RGB LED on BLE Pioneer kit are active low. Drive HIGH on 
-	 * pin for OFF and drive LOW on pin for ON */
-	PRS_1_WritePulse0(RGB_LED_OFF);
-	PRS_1_WritePulse1(RGB_LED_OFF);
-	PRS_2_WritePulse0(RGB_LED_OFF);
-	
-	/* Set Drive mode of output pins from HiZ to Strong */
-	RED_SetDriveMode(RED_DM_STRONG);
-	GREEN_SetDriveMode(GREEN_DM_STRONG);
-	BLUE_SetDriveMode(BLUE_DM_STRONG);
-	
-	/* Enable Proximity sensor, initialize CapSense component and 
-     * sensor baselines */
-	CapSense_EnableWidget(CapSense_PROXIMITYSENSOR0__PROX);
-	CapSense_Start();
-	CapSense_InitializeAllBaselines();
-}
-
-
-/*******************************************************************************
-* Function Name: HandleCapSenseProximity
-********************************************************************************
-* Summary:
-* This function scans for CapSense Proximity Sensor and send as notification.
-*
-* Parameters:
-*  void
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-void HandleCapSenseProximity(void)
-{
-	/* Proximity sensor value read by CapSense */
-	uint16 proxValue;
-		
-	/* Update CapSense baseline for next reading */
-	CapSense_UpdateEnabledBaselines();	
-		
-	/* Scan the enabled widget */
-	CapSense_ScanEnabledWidgets();			
-	
-	/* Wait for CapSense scanning to be complete. This could take about 5 ms */
-	while(CapSense_IsBusy());
-	
-	/* Read the proximity sensor value */
-	proxValue = CapSense_GetDiffCountData(CapSense_PROXIMITYSENSOR0__PROX);
-
-    SendCapSenseNotification((uint8)proxValue);	
-}
-
-/* [] END OF FILE */
+/*****************************************************************************
+* File Name: main.c
+*
+* Version: 1.0
+*
+* Description:
+* This is the top level application for the PSoC 4 BLE Lab 4 additional 
+* exercise 1.
+*
+* Hardware Dependency:
+* CY8CKIT-042 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <main.h>
+#include <BLEApplications.h>
+#include <NotifyFilter.h>
+#include <ProximityFilter.h>
+#if PROXIMITY_WAKE_MODE
+#include <WatchdogTimer.h>
+#include <ProximityWake.h>
+#endif
+
+
+/*****************************************************************************
+* Static variables
+*****************************************************************************/
+/* Noise filter applied to the proximity scans */
+static PROXIMITY_FILTER_T proximityNoiseFilter;
+
+/* Rate limiter between the filtered proximity values and the notifications */
+static NOTIFY_FILTER_T proximityFilter;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void InitializeSystem(void);
+static void HandleCapSenseProximity(void);
+#if PROXIMITY_WAKE_MODE
+static void EnterLowPower(void);
+#endif
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* System entrance point. This calls the initializing function and continuously
+* process BLE and CapSense events.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main()
+{
+	/* This function will initialize the system resources such as BLE and CapSense */
+    InitializeSystem();
+	
+    for(;;)
+    {
+        /*Process event callback to handle BLE events. The events generated and 
+		* used for this application are inside the 'CustomEventHandler' routine*/
+        CyBle_ProcessEvents();
+		
+		if(TRUE == deviceConnected)
+		{
+            /* Send CapSense Proximity data when respective notification is enabled */
+			if(TRUE == sendCapSenseProximityNotifications)
+			{
+			#if PROXIMITY_WAKE_MODE
+				/* In the slow tier only every PROXIMITY_SLOW_SCAN_MS */
+				if(ProximityWake_IsScanDue(WatchdogTimer_GetTimestamp()))
+			#endif
+				{
+					/* Check for CapSense proximity sensor and send data accordingly */
+					HandleCapSenseProximity();
+				}
+			}
+		}
+		
+	#if PROXIMITY_WAKE_MODE
+		/* Sleep until the next BLE event or watchdog tick unless a hand is
+		 * near the sensor. While asleep the watchdog only has to wake the 
+		 * device for the slow scans, so it ticks at the slow scan period; 
+		 * the fast tier gets the 10 ms resolution back. */
+		if((TRUE != sendCapSenseProximityNotifications) || 
+		   (PROXIMITY_TIER_SLOW == ProximityWake_GetTier()))
+		{
+			WatchdogTimer_SetPeriod(PROXIMITY_SLOW_SCAN_MS);
+			EnterLowPower();
+		}
+		else
+		{
+			WatchdogTimer_SetPeriod(WATCHDOG_TIMER_PERIOD_MS);
+		}
+	#endif
+    }	
+}
+
+
+/*******************************************************************************
+* Function Name: InitializeSystem
+********************************************************************************
+* Summary:
+* Start the components and initialize system.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void InitializeSystem(void)
+{
+	/* Enable global interrupt mask */
+	CyGlobalIntEnable; 
+		
+	/* Start BLE component and register the CustomEventHandler function. This 
+	 * function exposes the events from BLE component for application use */
+    CyBle_Start(CustomEventHandler);	
+    
+	/* Start both the PrISM components for LED control*/
+    PRS_1_Start();
+    PRS_2_Start();
+	
+	/* The RGB LED on BLE Pioneer kit are active low. Drive HIGH on 
+	 * pin for OFF and drive LOW on pin for ON */
+	PRS_1_WritePulse0(RGB_LED_OFF);
+	PRS_1_WritePulse1(RGB_LED_OFF);
+	PRS_2_WritePulse0(RGB_LED_OFF);
+	
+	/* Set Drive mode of output pins from HiZ to Strong */
+	RED_SetDriveMode(RED_DM_STRONG);
+	GREEN_SetDriveMode(GREEN_DM_STRONG);
+	BLUE_SetDriveMode(BLUE_DM_STRONG);
+	
+	/* Enable Proximity sensor, initialize CapSense component and 
+     * sensor baselines */
+	CapSense_EnableWidget(CapSense_PROXIMITYSENSOR0__PROX);
+	CapSense_Start();
+	CapSense_InitializeAllBaselines();
+	
+#if PROXIMITY_WAKE_MODE
+	/* Start the watchdog timer that schedules the slow proximity scans */
+	WatchdogTimer_Start();
+	ProximityWake_Start(WatchdogTimer_GetTimestamp());
+#endif
+	
+	ProximityFilter_Init(&proximityNoiseFilter, PROXIMITY_IIR_SHIFT, PROXIMITY_DECIMATION);
+	NotifyFilter_Init(&proximityFilter, PROXIMITY_DEADBAND, PROXIMITY_HYSTERESIS, PROXIMITY_MIN_INTERVAL_SCANS);
+}
+
+
+/*******************************************************************************
+* Function Name: HandleCapSenseProximity
+********************************************************************************
+* Summary:
+* This function scans for CapSense Proximity Sensor, passes the raw 
+* difference count to the scan tier policy, filters the difference
+* count through proximityNoiseFilter and sends it as notification when 
+* proximityFilter passes the new value. A filtered value of zero means 
+* nothing is near the sensor and is treated as a release.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void HandleCapSenseProximity(void)
+{
+	/* Raw and filtered proximity sensor value */
+	uint16 rawValue;
+	uint16 proxValue;
+	
+	/* Proximity value to notify, from the filter */
+	uint16 notifyValue;
+		
+	/* Update CapSense baseline for next reading */
+	CapSense_UpdateEnabledBaselines();	
+		
+	/* Scan the enabled widget */
+	CapSense_ScanEnabledWidgets();			
+	
+	/* Wait for CapSense scanning to be complete. This could take about 5 ms */
+	while(CapSense_IsBusy());
+	
+	/* Read the proximity sensor value */
+	rawValue = CapSense_GetDiffCountData(CapSense_PROXIMITYSENSOR0__PROX);
+	
+	#if PROXIMITY_WAKE_MODE
+	ProximityWake_Update(WatchdogTimer_GetTimestamp(), rawValue);
+	#endif
+	
+	/* Nothing to do until the filter has a new output */
+	if(!ProximityFilter_Update(&proximityNoiseFilter, rawValue, &proxValue))
+	{
+		return;
+	}
+
+	if(NotifyFilter_Update(&proximityFilter, proxValue, (proxValue == ZERO), &notifyValue))
+	{
+		SendCapSenseNotification((uint8)notifyValue);
+	}
+}
+
+
+#if PROXIMITY_WAKE_MODE
+/*******************************************************************************
+* Function Name: EnterLowPower
+********************************************************************************
+* Summary:
+* Puts the device to sleep until the next interrupt, which is at the latest
+* the next watchdog tick. The system enters Deep Sleep when the BLE block is
+* in Deep Sleep and the RGB LED is off, since the PrISM components stop in 
+* Deep Sleep; otherwise the CPU sleeps.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void EnterLowPower(void)
+{
+	/* Low power mode the BLE block entered */
+	CYBLE_LP_MODE_T bleMode;
+	
+	/* Interrupt status saved by the critical section */
+	uint8 interruptStatus;
+	
+	/* The RGB LED is lit, so the PrISM components have to keep running */
+	uint8 ledOn = ((RGBledData[INTENSITY_INDEX] != ZERO) && 
+				   ((RGBledData[RED_INDEX] | RGBledData[GREEN_INDEX] | RGBledData[BLUE_INDEX]) != ZERO));
+	
+	/* Request the BLE block to enter Deep Sleep */
+	bleMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
+	
+	/* Decide and sleep with interrupts disabled, so that an interrupt 
+	 * between the check and the sleep cannot be missed */
+	interruptStatus = CyEnterCriticalSection();
+	
+	if(CYBLE_BLESS_DEEPSLEEP == bleMode)
+	{
+		if((CyBle_GetBleSsState() == CYBLE_BLESS_STATE_ECO_ON) ||
+		   (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_DEEPSLEEP))
+		{
+			if(!ledOn)
+			{
+				/* The watchdog keeps running on the ILO and wakes the 
+				 * device for the next slow scan */
+				CapSense_Sleep();
+				CySysPmDeepSleep();
+				CapSense_Wakeup();
+			}
+			else
+			{
+				CySysPmSleep();
+			}
+		}
+	}
+	else
+	{
+		/* The CPU must stay awake while the BLE block post-processes a 
+		 * connection event */
+		if(CyBle_GetBleSsState() != CYBLE_BLESS_STATE_EVENT_CLOSE)
+		{
+			CySysPmSleep();
+		}
+	}
+	
+	CyExitCriticalSection(interruptStatus);
+}
+#endif
+
+/* [] END OF FILE */
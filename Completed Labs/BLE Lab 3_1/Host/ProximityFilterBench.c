@@ -0,0 +1,318 @@
+/*****************************************************************************
+* File Name: ProximityFilterBench.c
+*
+* Version: 1.0
+*
+* Description:
+* This file checks and times the proximity filter pipeline of the BLE Lab 3_1
+* on a PC. Build with: gcc -O2 -I. -I"../BLE Lab 3_1.cydsn" -o
+* proximity_filter_bench ProximityFilterBench.c "../BLE Lab
+* 3_1.cydsn/ProximityFilter.c". Run ./proximity_filter_bench [-c
+* iir_shift,decimation]... [-n noise]. Each output line is a JSON object for
+* one setting, the main.h setting first: how far a single-scan spike of
+* SPIKE_COUNTS moves the output, how many outputs a step up takes to cover
+* 63% (one time constant) and to settle, and a step down to reach zero, and
+* the time per scan for a noisy and a constant input.
+*
+* Hardware Dependency:
+* None, builds on a PC
+*
+******************************************************************************
+* Copyright (2014), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+/*****************************************************************************
+* Included headers
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <main.h>
+#include <ProximityFilter.h>
+
+
+/*****************************************************************************
+* Macros and constants
+*****************************************************************************/
+#define MAX_SETTINGS                        (16u)
+
+/* Default noise of the synthetic proximity trace, +/- counts */
+#define DEFAULT_NOISE                       (3u)
+
+/* Level of the trace with a hand near the sensor and the size of the spike
+ * added to a single scan */
+#define HAND_COUNTS                         (100u)
+#define SPIKE_COUNTS                        (900u)
+
+/* Scans of each test; the spike and the steps are in the middle */
+#define TEST_SCANS                          (200u)
+#define EVENT_SCAN                          (TEST_SCANS / 2u)
+
+/* An output within this many counts of the step level counts as settled, 
+ * and one within 37% of the step as one time constant */
+#define SETTLED_COUNTS                      (1u)
+#define TIME_CONSTANT_COUNTS                ((HAND_COUNTS * 37u) / 100u)
+
+#define TIMED_SCANS                         (10000000u)
+
+/* Settings compared with the main.h one when -c is not given */
+static const uint8 defaultSettings[][2] = { {0u, 1u}, {1u, 1u}, {3u, 2u}, {4u, 4u} };
+
+#define COUNT_OF(array)                     (sizeof(array) / sizeof((array)[0]))
+
+
+/*****************************************************************************
+* Data types
+*****************************************************************************/
+typedef struct
+{
+    uint8 iirShift;
+    uint8 decimation;
+} SETTING_T;
+
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: Noise()
+******************************************************************************
+* Summary:
+* Returns uniform noise of +/- noise counts.
+*
+*****************************************************************************/
+static int32 Noise(uint32 noise)
+{
+    return (int32)((uint32)rand() % ((2u * noise) + 1u)) - (int32)noise;
+}
+
+
+/*****************************************************************************
+* Function Name: SpikeDeviation()
+******************************************************************************
+* Summary:
+* Runs the same noisy trace at HAND_COUNTS with and without a spike at 
+* EVENT_SCAN and returns the largest difference between the two outputs.
+*
+*****************************************************************************/
+static uint32 SpikeDeviation(const SETTING_T *setting, uint32 noise)
+{
+    PROXIMITY_FILTER_T clean;
+    PROXIMITY_FILTER_T spiked;
+    uint16 cleanValue;
+    uint16 spikedValue;
+    uint32 deviation = 0;
+    uint32 scan;
+    int32 raw;
+    
+    ProximityFilter_Init(&clean, setting->iirShift, setting->decimation);
+    ProximityFilter_Init(&spiked, setting->iirShift, setting->decimation);
+    srand(1u);
+    
+    for(scan = 0; scan < TEST_SCANS; scan++)
+    {
+        raw = (int32)HAND_COUNTS + Noise(noise);
+        
+        if(ProximityFilter_Update(&clean, (uint16)raw, &cleanValue) & 
+           ProximityFilter_Update(&spiked, (uint16)(raw + ((scan == EVENT_SCAN) ? SPIKE_COUNTS : 0u)), &spikedValue))
+        {
+            if((uint32)abs((int32)spikedValue - (int32)cleanValue) > deviation)
+            {
+                deviation = (uint32)abs((int32)spikedValue - (int32)cleanValue);
+            }
+        }
+    }
+    
+    return deviation;
+}
+
+
+/*****************************************************************************
+* Function Name: StepOutputs()
+******************************************************************************
+* Summary:
+* Steps a noise-free trace from one level to another at EVENT_SCAN and 
+* returns the number of outputs from the step until the output stays 
+* within settledCounts of the new level, or TEST_SCANS if it never does.
+*
+*****************************************************************************/
+static uint32 StepOutputs(const SETTING_T *setting, uint16 from, uint16 to, uint16 settledCounts)
+{
+    PROXIMITY_FILTER_T filter;
+    uint16 value;
+    uint32 outputs = 0;
+    uint32 settledOutputs = TEST_SCANS;
+    uint32 scan;
+    
+    ProximityFilter_Init(&filter, setting->iirShift, setting->decimation);
+    
+    for(scan = 0; scan < TEST_SCANS; scan++)
+    {
+        if(ProximityFilter_Update(&filter, (scan < EVENT_SCAN) ? from : to, &value) && (scan >= EVENT_SCAN))
+        {
+            outputs++;
+            
+            if((uint32)abs((int32)value - (int32)to) > settledCounts)
+            {
+                settledOutputs = TEST_SCANS;
+            }
+            else if(settledOutputs == TEST_SCANS)
+            {
+                settledOutputs = outputs;
+            }
+        }
+    }
+    
+    return settledOutputs;
+}
+
+
+/*****************************************************************************
+* Function Name: TimeScans()
+******************************************************************************
+* Summary:
+* Returns the time per scan in ns for a noisy or a constant input.
+*
+*****************************************************************************/
+static double TimeScans(const SETTING_T *setting, const uint16 *raw, uint32 rawMask)
+{
+    PROXIMITY_FILTER_T filter;
+    struct timespec start;
+    struct timespec end;
+    volatile uint32 sum = 0;
+    uint16 value;
+    uint32 scan;
+    
+    ProximityFilter_Init(&filter, setting->iirShift, setting->decimation);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    for(scan = 0; scan < TIMED_SCANS; scan++)
+    {
+        if(ProximityFilter_Update(&filter, raw[scan & rawMask], &value))
+        {
+            sum += value;
+        }
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    
+    return (((double)(end.tv_sec - start.tv_sec) * 1e9) + (double)(end.tv_nsec - start.tv_nsec)) / TIMED_SCANS;
+}
+
+
+/*****************************************************************************
+* Public functions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Name: main()
+******************************************************************************
+* Summary:
+* Parses the settings and runs the tests for each of them.
+*
+* Theory:
+* The noisy timing input cycles through 4096 random raw values, so the 
+* median and the IIR branches go both ways; a scan taking the same time on 
+* it as on a constant input shows that no stage depends on the data.
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    SETTING_T settings[MAX_SETTINGS];
+    static uint16 noisyRaw[4096];
+    uint16 constantRaw[1] = { HAND_COUNTS };
+    uint32 settingCount = 0;
+    uint32 noise = DEFAULT_NOISE;
+    uint32 index;
+    unsigned iirShift;
+    unsigned decimation;
+    int arg;
+    
+    settings[settingCount].iirShift = PROXIMITY_IIR_SHIFT;
+    settings[settingCount].decimation = PROXIMITY_DECIMATION;
+    settingCount++;
+    
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((strcmp(argv[arg], "-c") == 0) && ((arg + 1) < argc) && (settingCount < MAX_SETTINGS) &&
+           (sscanf(argv[arg + 1], "%u,%u", &iirShift, &decimation) == 2) && (iirShift < 16u) && (decimation < 256u))
+        {
+            settings[settingCount].iirShift = (uint8)iirShift;
+            settings[settingCount].decimation = (uint8)decimation;
+            settingCount++;
+            arg++;
+        }
+        else if((strcmp(argv[arg], "-n") == 0) && ((arg + 1) < argc))
+        {
+            noise = (uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-c iir_shift,decimation]... [-n noise]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    if(settingCount == 1u)
+    {
+        for(index = 0; index < COUNT_OF(defaultSettings); index++)
+        {
+            settings[settingCount].iirShift = defaultSettings[index][0];
+            settings[settingCount].decimation = defaultSettings[index][1];
+            settingCount++;
+        }
+    }
+    
+    srand(2u);
+    
+    for(index = 0; index < COUNT_OF(noisyRaw); index++)
+    {
+        noisyRaw[index] = (uint16)((uint32)rand() % 1024u);
+    }
+    
+    for(index = 0; index < settingCount; index++)
+    {
+        printf("{\"iir_shift\":%u,\"decimation\":%u,\"noise\":%u,\"spike\":%u,\"spike_deviation\":%u,"
+               "\"step_up_outputs_63pct\":%u,\"step_up_outputs\":%u,\"step_down_outputs_to_zero\":%u,"
+               "\"ns_per_scan_noisy\":%.2f,\"ns_per_scan_constant\":%.2f}\n",
+               (unsigned)settings[index].iirShift, (unsigned)settings[index].decimation, (unsigned)noise,
+               (unsigned)SPIKE_COUNTS, (unsigned)SpikeDeviation(&settings[index], noise),
+               (unsigned)StepOutputs(&settings[index], 0u, HAND_COUNTS, TIME_CONSTANT_COUNTS),
+               (unsigned)StepOutputs(&settings[index], 0u, HAND_COUNTS, SETTLED_COUNTS),
+               (unsigned)StepOutputs(&settings[index], HAND_COUNTS, 0u, 0u),
+               TimeScans(&settings[index], noisyRaw, COUNT_OF(noisyRaw) - 1u),
+               TimeScans(&settings[index], constantRaw, 0u));
+    }
+    
+    return 0;
+}
+
+
+/* [] END OF FILE */